@@ -0,0 +1,19 @@
+#
+# Module providing convenience methods for compiling binaries with OpenMP support.
+#
+# Provides the following functions:
+#
+# add_dune_openmp_flags(target1 target2 ...)
+#
+# adds OpenMP flags to the targets for compilation and linking
+#
+function(add_dune_openmp_flags)
+  if(OPENMP_FOUND)
+    foreach(_target ${ARGN})
+      set_property(TARGET ${_target} APPEND_STRING
+        PROPERTY COMPILE_FLAGS " ${OpenMP_CXX_FLAGS}")
+      set_property(TARGET ${_target} APPEND_STRING
+        PROPERTY LINK_FLAGS " ${OpenMP_CXX_FLAGS}")
+    endforeach(_target ${ARGN})
+  endif(OPENMP_FOUND)
+endfunction(add_dune_openmp_flags)
@@ -15,6 +15,8 @@ find_package(Psurface)
 include(AddPsurfaceFlags)
 find_package(AmiraMesh)
 include(AddAmiraMeshFlags)
+find_package(OpenMP)
+include(AddOpenMPFlags)
 include(CheckExperimentalGridExtensions)
 
 set(DEFAULT_DGF_GRIDDIM 1)
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <limits>
 #include <map>
+#include <vector>
 
 #include <dune/common/array.hh>
 
@@ -20,6 +21,7 @@
 #include <dune/grid/common/gridfactory.hh>
 
 #include <dune/grid/utility/grapedataioformattypes.hh>
+#include <dune/grid/utility/spacefillingcurve.hh>
 
 #include <dune/grid/albertagrid/agrid.hh>
 
@@ -103,7 +105,8 @@ namespace Dune
 
     /** default constructor */
     GridFactory ()
-      : globalProjection_( (const DuneProjection *) 0 )
+      : globalProjection_( (const DuneProjection *) 0 ),
+        curveOrdering_( false )
     {
       macroData_.create();
     }
@@ -274,6 +277,26 @@ namespace Dune
       macroData_.markLongestEdge();
     }
 
+    /** \brief sort the macro elements along a Hilbert curve
+     *
+     *  If enabled, the macro elements are reordered along a Hilbert curve
+     *  through their barycenters when the macro triangulation is finalized
+     *  (i.e., by createGrid or write). As the leaf elements are traversed
+     *  (and indexed) in the order of their macro elements, neighboring
+     *  elements get close indices, which improves the cache efficiency of
+     *  loops over the grid. insertionIndex still returns the position of an
+     *  element in the insertion sequence.
+     *
+     *  \param[in]  enable  \b true to enable the reordering
+     *
+     *  \note This method has to be called before the macro triangulation is
+     *        finalized.
+     */
+    void orderElementsAlongCurve ( const bool enable = true )
+    {
+      curveOrdering_ = enable;
+    }
+
     /** \brief finalize grid creation and hand over the grid
      *
      *  This version of createGrid is original to the AlbertaGrid grid factroy,
@@ -288,6 +311,7 @@ namespace Dune
      */
     Grid *createGrid ()
     {
+      sortElementsAlongCurve();
       macroData_.finalize();
       if( macroData_.elementCount() == 0 )
         DUNE_THROW( GridError, "Cannot create empty AlbertaGrid." );
@@ -320,6 +344,7 @@ namespace Dune
     bool write ( const std::string &filename )
     {
       dune_static_assert( type != pgm, "AlbertaGridFactory: writing pgm format is not supported." );
+      sortElementsAlongCurve();
       macroData_.finalize();
       if( dimension < 3 )
         macroData_.setOrientation( Alberta::Real( 1 ) );
@@ -349,7 +374,7 @@ namespace Dune
     virtual unsigned int
     insertionIndex ( const typename Codim< dimension >::Entity &entity ) const
     {
-      const int elIndex = insertionIndex( Grid::getRealImplementation( entity ).elementInfo() );
+      const int elIndex = macroIndex( Grid::getRealImplementation( entity ).elementInfo() );
       const typename MacroData::ElementId &elementId = macroData_.element( elIndex );
       return elementId[ Grid::getRealImplementation( entity ).subEntity() ];
     }
@@ -370,16 +395,21 @@ namespace Dune
     }
 
   private:
+    unsigned int macroIndex ( const ElementInfo &elementInfo ) const;
     unsigned int insertionIndex ( const ElementInfo &elementInfo ) const;
     unsigned int insertionIndex ( const ElementInfo &elementInfo, const int face ) const;
 
     FaceId faceId ( const ElementInfo &elementInfo, const int face ) const;
 
+    void sortElementsAlongCurve ();
+
     MacroData macroData_;
     NumberingMap numberingMap_;
     DuneProjectionPtr globalProjection_;
     BoundaryMap boundaryMap_;
     std::vector< DuneProjectionPtr > boundaryProjections_;
+    bool curveOrdering_;
+    std::vector< int > ordering_;
   };
 
 
@@ -428,7 +458,7 @@ namespace Dune
   template< int dim, int dimworld >
   inline unsigned int
   GridFactory< AlbertaGrid< dim, dimworld > >
-  ::insertionIndex ( const ElementInfo &elementInfo ) const
+  ::macroIndex ( const ElementInfo &elementInfo ) const
   {
     const MacroElement &macroElement = elementInfo.macroElement();
     const unsigned int index = macroElement.index;
@@ -451,6 +481,17 @@ namespace Dune
   }
 
 
+  template< int dim, int dimworld >
+  inline unsigned int
+  GridFactory< AlbertaGrid< dim, dimworld > >
+  ::insertionIndex ( const ElementInfo &elementInfo ) const
+  {
+    const unsigned int index = macroIndex( elementInfo );
+    assert( ordering_.empty() || (index < ordering_.size()) );
+    return (ordering_.empty() ? index : ordering_[ index ]);
+  }
+
+
   template< int dim, int dimworld >
   inline unsigned int
   GridFactory< AlbertaGrid< dim, dimworld > >
@@ -470,7 +511,7 @@ namespace Dune
   GridFactory< AlbertaGrid< dim, dimworld > >
   ::faceId ( const ElementInfo &elementInfo, const int face ) const
   {
-    const unsigned int index = insertionIndex( elementInfo );
+    const unsigned int index = macroIndex( elementInfo );
     const typename MacroData::ElementId &elementId = macroData_.element( index );
 
     FaceId faceId;
@@ -484,6 +525,33 @@ namespace Dune
   }
 
 
+  template< int dim, int dimworld >
+  inline void
+  GridFactory< AlbertaGrid< dim, dimworld > >::sortElementsAlongCurve ()
+  {
+    // only sort once, before the macro data is finalized
+    if( !curveOrdering_ || !ordering_.empty() )
+      return;
+
+    const int numElements = macroData_.elementCount();
+    std::vector< WorldVector > centers( numElements, WorldVector( 0 ) );
+    for( int k = 0; k < numElements; ++k )
+    {
+      const typename MacroData::ElementId &elementId = macroData_.element( k );
+      for( int i = 0; i < numVertices; ++i )
+      {
+        const Alberta::GlobalVector &x = macroData_.vertex( elementId[ i ] );
+        for( int j = 0; j < dimensionworld; ++j )
+          centers[ k ][ j ] += x[ j ];
+      }
+      centers[ k ] /= ctype( numVertices );
+    }
+
+    sortSpaceFillingCurve( SpaceFillingCurve< ctype, dimensionworld >::hilbert, centers, ordering_ );
+    macroData_.permuteElements( ordering_ );
+  }
+
+
 
   // GridFactory::ProjectionFactory
   // ------------------------------
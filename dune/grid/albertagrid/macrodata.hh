@@ -8,6 +8,8 @@
  *  \brief  provides a wrapper for ALBERTA's macro_data structure
  */
 
+#include <vector>
+
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
@@ -139,6 +141,14 @@ namespace Dune
        */
       int insertElement ( const ElementId &id );
 
+      /** \brief permute the elements
+       *
+       *  Reorder the elements (together with their boundary ids) such that
+       *  the new i-th element is the old element ordering[ i ]. This may only
+       *  be done in insert mode.
+       */
+      void permuteElements ( const std::vector< int > &ordering );
+
       /** \brief insert vertex
        *
        *  Insert a vertex into the macro data structure. This may only be
@@ -375,6 +385,40 @@ namespace Dune
     }
 
 
+    template< int dim >
+    inline void MacroData< dim >::permuteElements ( const std::vector< int > &ordering )
+    {
+      assert( elementCount_ >= 0 );
+      assert( int( ordering.size() ) == elementCount_ );
+
+      std::vector< int > vertices( elementCount_*numVertices );
+      std::vector< BoundaryId > boundaryIds( elementCount_*numVertices );
+      std::vector< ElementType > elTypes( dim == 3 ? elementCount_ : 0 );
+      for( int element = 0; element < elementCount_; ++element )
+      {
+        const int k = ordering[ element ];
+        for( int i = 0; i < numVertices; ++i )
+        {
+          vertices[ element*numVertices + i ] = this->element( k )[ i ];
+          boundaryIds[ element*numVertices + i ] = boundaryId( k, i );
+        }
+        if( dim == 3 )
+          elTypes[ element ] = data_->el_type[ k ];
+      }
+
+      for( int element = 0; element < elementCount_; ++element )
+      {
+        for( int i = 0; i < numVertices; ++i )
+        {
+          this->element( element )[ i ] = vertices[ element*numVertices + i ];
+          boundaryId( element, i ) = boundaryIds[ element*numVertices + i ];
+        }
+        if( dim == 3 )
+          data_->el_type[ element ] = elTypes[ element ];
+      }
+    }
+
+
 #if DUNE_ALBERTA_VERSION >= 0x300
     template< int dim >
     inline void MacroData< dim >
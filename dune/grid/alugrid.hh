@@ -10,6 +10,7 @@
 
 #include <dune/grid/alugrid/3d/alugrid.hh>
 #include <dune/grid/alugrid/3d/alu3dgridfactory.hh>
+#include <dune/grid/alugrid/3d/repartition.hh>
 
 // 2d version
 #include <dune/grid/alugrid/2d/alugrid.hh>
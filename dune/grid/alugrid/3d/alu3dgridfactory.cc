@@ -14,6 +14,8 @@
 #include <iostream>
 #include <fstream>
 
+#include <dune/grid/utility/spacefillingcurve.hh>
+
 #include <dune/grid/alugrid/3d/alu3dgridfactory.hh>
 
 #if HAVE_ALUGRID
@@ -182,6 +184,8 @@ namespace Dune
     BoundaryProjectionVector* bndProjections = 0;
 
     correctElementOrientation();
+    if( curveOrdering_ )
+      sortElementsAlongCurve();
     numFacesInserted_ = boundaryIds_.size();
     if( addMissingBoundaries || ! faceTransformations_.empty() )
       recreateBoundaryIds();
@@ -529,6 +533,39 @@ namespace Dune
   }
 
 
+  template< class ALUGrid >
+  alu_inline
+  void ALU3dGridFactory< ALUGrid >::sortElementsAlongCurve ()
+  {
+    // boundaries and process borders are stored by their vertices,
+    // so only the elements have to be permuted
+    const size_t numElements = elements_.size();
+    std::vector< VertexType > centers( numElements, VertexType( 0 ) );
+    for( size_t k = 0; k < numElements; ++k )
+    {
+      for( unsigned int i = 0; i < numCorners; ++i )
+        centers[ k ] += position( elements_[ k ][ i ] );
+      centers[ k ] /= ctype( numCorners );
+    }
+
+    std::vector< unsigned int > ordering;
+    sortSpaceFillingCurve( SpaceFillingCurve< ctype, dimensionworld >::hilbert, centers, ordering );
+
+    ElementVector elements( numElements );
+    for( size_t k = 0; k < numElements; ++k )
+      elements[ k ].swap( elements_[ ordering[ k ] ] );
+    elements_.swap( elements );
+
+    // compose with a previous ordering (if createGrid is called again)
+    if( !ordering_.empty() )
+    {
+      for( size_t k = 0; k < numElements; ++k )
+        ordering[ k ] = ordering_[ ordering[ k ] ];
+    }
+    ordering_.swap( ordering );
+  }
+
+
   template< class ALUGrid >
   alu_inline
   bool ALU3dGridFactory< ALUGrid >
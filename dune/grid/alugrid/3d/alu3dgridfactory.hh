@@ -134,7 +134,17 @@ namespace Dune
      */
     virtual void insertVertex ( const VertexType &pos );
 
-    // for testing parallel GridFactory
+    /** \brief insert a vertex of a distributed coarse grid
+     *
+     *  In contrast to insertVertex( pos ), this method may be called on all
+     *  processes. Each process inserts the vertices of its own elements.
+     *
+     *  \param[in]  pos       position of the vertex
+     *  \param[in]  globalId  global index of the vertex, the same on all
+     *                        processes sharing the vertex
+     *
+     *  \returns the (local) index of the vertex to be used in insertElement
+     */
     VertexId insertVertex ( const VertexType &pos, const size_t globalId );
 
     /** \brief insert an element into the coarse grid
@@ -172,7 +182,11 @@ namespace Dune
      */
     virtual void insertBoundary ( const int element, const int face, const int id );
 
-    // for testing parallel GridFactory
+    /** \brief mark a face of a distributed coarse grid as shared with another process
+     *
+     *  \param[in]  element  index of the element, the face belongs to
+     *  \param[in]  face     local number of the face within the element
+     */
     void insertProcessBorder ( const int element, const int face )
     {
       insertBoundary( element, face, ALU3DSPACE ProcessorBoundary_t );
@@ -224,6 +238,19 @@ namespace Dune
      */
     void insertFaceTransformation ( const WorldMatrix &matrix, const WorldVector &shift );
 
+    /** \brief sort the macro elements along a Hilbert curve on grid creation
+     *
+     *  If enabled, createGrid reorders the macro elements along a Hilbert
+     *  curve through their barycenters. As the leaf elements are traversed
+     *  (and indexed) in the order of their macro elements, neighboring
+     *  elements get close indices, which improves the cache efficiency of
+     *  loops over the grid. insertionIndex still returns the position of an
+     *  element in the insertion sequence.
+     *
+     *  \param[in]  enable  \b true to enable the reordering
+     */
+    void orderElementsAlongCurve ( const bool enable = true ) { curveOrdering_ = enable; }
+
     /** \brief finalize the grid creation and hand over the grid
      *
      *  The caller takes responsibility for deleing the grid.
@@ -237,7 +264,9 @@ namespace Dune
     virtual unsigned int
     insertionIndex ( const typename Codim< 0 >::Entity &entity ) const
     {
-      return Grid::getRealImplementation( entity ).getIndex();
+      const unsigned int index = Grid::getRealImplementation( entity ).getIndex();
+      assert( ordering_.empty() || (index < ordering_.size()) );
+      return (ordering_.empty() ? index : ordering_[ index ]);
     }
     virtual unsigned int
     insertionIndex ( const typename Codim< dimension >::Entity &entity ) const
@@ -273,6 +302,7 @@ namespace Dune
     static void generateFace ( const ElementType &element, const int f, FaceType &face );
     void generateFace ( const SubEntity &subEntity, FaceType &face ) const;
     void correctElementOrientation ();
+    void sortElementsAlongCurve ();
     bool identifyFaces ( const Transformation &transformation, const FaceType &key1, const FaceType &key2, const int defaultId );
     void searchPeriodicNeighbor ( FaceMap &faceMap, const typename FaceMap::iterator &pos, const int defaultId  );
     void reinsertBoundary ( const FaceMap &faceMap, const typename FaceMap::const_iterator &pos, const int id );
@@ -288,6 +318,8 @@ namespace Dune
     BoundaryProjectionMap boundaryProjections_;
     FaceTransformationVector faceTransformations_;
     unsigned int numFacesInserted_;
+    bool curveOrdering_;
+    std::vector< unsigned int > ordering_;
     bool realGrid_;
     const bool allowGridGeneration_;
 
@@ -456,6 +488,7 @@ namespace Dune
     : rank_( ALU3dGridCommunications< elementType, MPICommunicatorType >::getRank( communicator ) ),
       globalProjection_ ( 0 ),
       numFacesInserted_ ( 0 ),
+      curveOrdering_( false ),
       realGrid_( true ),
       allowGridGeneration_( rank_ == 0 ),
       communicator_( communicator )
@@ -469,6 +502,7 @@ namespace Dune
     : rank_( ALU3dGridCommunications< elementType, MPICommunicatorType >::getRank( communicator ) ),
       globalProjection_ ( 0 ),
       numFacesInserted_ ( 0 ),
+      curveOrdering_( false ),
       realGrid_( true ),
       allowGridGeneration_( rank_ == 0 ),
       communicator_( communicator )
@@ -482,6 +516,7 @@ namespace Dune
     : rank_( ALU3dGridCommunications< elementType, MPICommunicatorType >::getRank( communicator ) ),
       globalProjection_ ( 0 ),
       numFacesInserted_ ( 0 ),
+      curveOrdering_( false ),
       realGrid_( realGrid ),
       allowGridGeneration_( true ),
       communicator_( communicator )
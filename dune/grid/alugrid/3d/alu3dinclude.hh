@@ -25,6 +25,9 @@
 // all methods and classes of the ALUGrid are defined in the namespace
 #define ALU3DSPACE ALUGridSpace ::
 
+#include <algorithm>
+#include <vector>
+
 #include <dune/common/parallel/mpicollectivecommunication.hh>
 
 #include <dune/grid/alugrid/common/checkparallel.hh>
@@ -398,6 +401,44 @@ namespace Dune
 
   typedef ALU3dGridItemList ALU3dGridItemListType;
 
+
+
+  // marks hierarchic indices visited while building an item list,
+  // reset() invalidates all marks in constant time
+  class ALU3dGridItemMarker
+  {
+  public:
+    ALU3dGridItemMarker () : epoch_( 0 ) {}
+
+    // start a new traversal for indices in [0,size)
+    void reset ( size_t size )
+    {
+      if( marker_.size() < size )
+        marker_.resize( size, 0 );
+      if( ++epoch_ == 0 )
+      {
+        std::fill( marker_.begin(), marker_.end(), 0u );
+        epoch_ = 1;
+      }
+    }
+
+    // mark index, return true if it was not marked since the last reset
+    bool mark ( int idx )
+    {
+      assert( idx >= 0 );
+      if( size_t( idx ) >= marker_.size() )
+        marker_.resize( idx+1, 0 );
+      if( marker_[ idx ] == epoch_ )
+        return false;
+      marker_[ idx ] = epoch_;
+      return true;
+    }
+
+  private:
+    std::vector< unsigned int > marker_;
+    unsigned int epoch_;
+  };
+
   /////////////////////////////////////////////////////////////////////////
   //  some helper functions
   /////////////////////////////////////////////////////////////////////////
@@ -86,6 +86,96 @@ namespace ALUGridSpace
     typedef pair< ElType *, HBndSegType * > val_t;
   };
 
+  // walks the elements of one level or the leaf elements directly in the
+  // element hierarchy below the macro elements; in contrast to ALUGrid's
+  // LevelIterator and LeafIterator, only the macro element iterator is
+  // created on the heap and no virtual iterator is involved in each step
+  template< class Comm >
+  class ALU3dGridElementWalker
+  {
+    typedef typename IteratorElType< 0, Comm >::ElType ElType;
+    typedef typename IteratorElType< 0, Comm >::HBndSegType HBndSegType;
+    typedef typename AccessIterator< ElType >::Handle MacroIteratorType;
+
+  public:
+    typedef typename IteratorElType< 0, Comm >::val_t val_t;
+
+    // walk the elements of the given level, or the leaf elements if level < 0
+    template< class GridImp >
+    ALU3dGridElementWalker ( const GridImp &grid, int level )
+      : macroIt_( grid.myGrid().container() ),
+        level_( level ),
+        current_( 0 ),
+        elem_( (ElType *) 0, (HBndSegType *) 0 )
+    {}
+
+    int size () { return macroIt_.size(); }
+
+    void first ()
+    {
+      macroIt_.first();
+      current_ = (macroIt_.done() ? 0 : &macroIt_.item());
+      if( current_ && !accept( *current_ ) )
+        next();
+    }
+
+    void next ()
+    {
+      assert( current_ );
+      do
+      {
+        current_ = advance( current_ );
+        if( !current_ )
+        {
+          macroIt_.next();
+          if( macroIt_.done() )
+            return;
+          current_ = &macroIt_.item();
+        }
+      }
+      while( !accept( *current_ ) );
+    }
+
+    int done () const { return (current_ == 0); }
+
+    val_t &item () const
+    {
+      assert( current_ );
+      elem_.first = current_;
+      return elem_;
+    }
+
+  private:
+    bool accept ( ElType &elem ) const
+    {
+      return (level_ < 0 ? (elem.down() == 0) : (elem.level() == level_));
+    }
+
+    // next element in depth first order below the same macro element, the
+    // children of elements on the walked level are skipped
+    ElType *advance ( ElType *elem ) const
+    {
+      if( (level_ < 0) || (elem->level() < level_) )
+      {
+        ElType *child = elem->down();
+        if( child )
+          return child;
+      }
+      for( ; elem->level() > 0; elem = elem->up() )
+      {
+        ElType *sibling = elem->next();
+        if( sibling )
+          return sibling;
+      }
+      return 0;
+    }
+
+    MacroIteratorType macroIt_;
+    int level_;
+    ElType *current_;
+    mutable val_t elem_;
+  };
+
   template< int codim, PartitionIteratorType pitype, class Comm >
   class ALU3dGridLevelIteratorWrapper;
 
@@ -94,38 +184,28 @@ namespace ALUGridSpace
   class ALU3dGridLevelIteratorWrapper< 0, pitype, Comm >
     : public IteratorWrapperInterface< typename IteratorElType< 0, Comm >::val_t >
   {
-    typedef typename IteratorElType< 0, Comm >::ElType ElType;
-    typedef typename IteratorElType< 0, Comm >::HBndSegType HBndSegType;
-    typedef ALU3DSPACE LevelIterator< ElType > IteratorType;
+    typedef ALU3dGridElementWalker< Comm > IteratorType;
 
     // the iterator
     IteratorType it_;
 
   public:
     typedef typename IteratorElType< 0, Comm >::val_t val_t;
-    mutable val_t elem_;
 
     // constructor creating iterator
     template< class GridImp >
     ALU3dGridLevelIteratorWrapper ( const GridImp &grid, int level, const int nlinks )
-      : it_( grid.myGrid(), level ),
-        elem_( (ElType *) 0, (HBndSegType *) 0 )
+      : it_( grid, level )
     {}
 
-    // copy constructor
-    ALU3dGridLevelIteratorWrapper (const ALU3dGridLevelIteratorWrapper & org )
-      : it_( org.it_ ), elem_(org.elem_)
-    {}
-
-    int size  ()    { return it_->size(); }
-    void next ()    { it_->next();  }
-    void first()    { it_->first(); }
-    int done () const { return it_->done(); }
+    int size  ()    { return it_.size(); }
+    void next ()    { it_.next();  }
+    void first()    { it_.first(); }
+    int done () const { return it_.done(); }
     val_t & item () const
     {
       assert( ! done () );
-      elem_.first  = & it_->item();
-      return elem_;
+      return it_.item();
     }
   };
 
@@ -251,41 +331,28 @@ namespace ALUGridSpace
   class ALU3dGridLeafIteratorWrapper< 0, pitype, Comm >
     : public IteratorWrapperInterface< typename IteratorElType< 0, Comm >::val_t >
   {
-    typedef typename IteratorElType< 0, Comm >::ElType ElType;
-    typedef typename IteratorElType< 0, Comm >::HBndSegType HBndSegType;
-    typedef LeafIterator< ElType > IteratorType;
+    typedef ALU3dGridElementWalker< Comm > IteratorType;
 
-    // the ALU3dGrid Iterator
+    // the iterator walking the leaf elements
     IteratorType it_;
 
   public:
     typedef typename IteratorElType< 0, Comm >::val_t val_t;
 
-  private:
-    mutable val_t elem_;
-
-  public:
     // constructor creating Iterator
     template< class GridImp >
     ALU3dGridLeafIteratorWrapper ( const GridImp &grid, int level, const int links )
-      : it_( grid.myGrid() ),
-        elem_( (ElType *) 0, (HBndSegType *) 0 )
-    {}
-
-    // constructor copying iterator
-    ALU3dGridLeafIteratorWrapper (const ALU3dGridLeafIteratorWrapper  & org )
-      : it_( org.it_ ), elem_(org.elem_)
+      : it_( grid, -1 )
     {}
 
-    int size  ()    { return it_->size(); }
-    void next ()    { it_->next(); }
-    void first()    { it_->first(); }
-    int done () const { return it_->done(); }
+    int size  ()    { return it_.size(); }
+    void next ()    { it_.next(); }
+    void first()    { it_.first(); }
+    int done () const { return it_.done(); }
     val_t & item () const
     {
       assert( ! done () );
-      elem_.first  = & it_->item();
-      return elem_;
+      return it_.item();
     }
   };
 
@@ -1062,9 +1129,8 @@ namespace ALUGridSpace
 
       ghList.getItemList().reserve(maxSize);
       ghList.getItemList().resize(0);
-      map< int , int > visited;
+      Dune::ALU3dGridItemMarker &visited = grid.getItemMarker( codim );
 
-      const map<int,int>::iterator visitedEnd = visited.end();
       for( ghostIter.first(); !ghostIter.done(); ghostIter.next() )
       {
         GhostPairType ghPair = ghostIter.item().second->getGhost();
@@ -1073,12 +1139,8 @@ namespace ALUGridSpace
         for(int i=0; i<numItems; ++i)
         {
           ElType * item = GetItem<GridImp,codim>::getItem( *(ghPair.first) , notOnFace[i] );
-          int idx = item->getIndex();
-          if( visited.find(idx) == visitedEnd )
-          {
+          if( visited.mark( item->getIndex() ) )
             ghList.getItemList().push_back( (void *) item );
-            visited[idx] = 1;
-          }
         }
       }
       ghList.markAsUp2Date();
@@ -1427,7 +1489,7 @@ namespace ALUGridSpace
       ElementLevelIterator iter(grid,level,nlinks);
 
       edgeList_.getItemList().resize(0);
-      map < int , int > visited;
+      Dune::ALU3dGridItemMarker &visited = grid.getItemMarker( 2 );
 
       for( iter.first(); ! iter.done(); iter.next() )
       {
@@ -1448,12 +1510,8 @@ namespace ALUGridSpace
           ElType * edge = elem->myhedge1(e);
           if( edge->isGhost() ) continue;
 
-          int idx = edge->getIndex();
-          if( visited.find(idx) == visited.end() )
-          {
+          if( visited.mark( edge->getIndex() ) )
             edgeList_.getItemList().push_back( (void *) edge );
-            visited[idx] = 1;
-          }
         }
       }
       edgeList_.markAsUp2Date();
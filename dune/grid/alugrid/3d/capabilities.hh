@@ -101,6 +101,17 @@ namespace Dune
       static const bool v = true;
     };
 
+    /** \brief ALUCubeGrid has a GridFactory accepting a distributed coarse grid
+       \ingroup ALUCubeGrid
+     */
+#if ALU3DGRID_PARALLEL
+    template<>
+    struct hasDistributedGridFactory< ALUCubeGrid< 3, 3 > >
+    {
+      static const bool v = true;
+    };
+#endif
+
 
 
     // Capabilities for ALUSimplexGrid
@@ -173,6 +184,17 @@ namespace Dune
       static const bool v = true;
     };
 
+    /** \brief ALUSimplexGrid has a GridFactory accepting a distributed coarse grid
+       \ingroup ALUSimplexGrid
+     */
+#if ALU3DGRID_PARALLEL
+    template<>
+    struct hasDistributedGridFactory< ALUSimplexGrid< 3, 3 > >
+    {
+      static const bool v = true;
+    };
+#endif
+
   } // end namespace Capabilities
 
 } //end  namespace Dune
@@ -35,6 +35,7 @@
 #include "datahandle.hh"
 
 #include <dune/grid/alugrid/3d/lbdatahandle.hh>
+#include <dune/grid/alugrid/3d/partitioner.hh>
 
 #include <dune/common/parallel/mpihelper.hh>
 
@@ -753,6 +754,51 @@ namespace Dune
       return loadBalance( lbHandle );
     }
 
+    /** \brief Check whether the weighted load of the processes is imbalanced.
+
+        The weight of each macro element is obtained from a weight handle
+        implementing
+          \code
+          // return the (nonnegative) computational cost of the macro element
+          // e, including all of its children
+          double weight ( const Dune::Entity<0> & e ) const;
+          \endcode
+        The partitioner is evaluated on the weights and centers of all macro
+        elements. The load is considered imbalanced if the ratio between the
+        largest and the mean weighted load of a process exceeds the
+        partitioner's tolerance and the partitioner achieves a better
+        balance. The result is the same on all processes.
+
+        \note This method only reports the imbalance; it does not migrate
+              any elements. ALUGrid neither accepts weights nor prescribed
+              destinations for its macro elements, and loadBalance() balances
+              the number of leaf elements. To distribute the macro grid
+              according to the weights, use repartitionMacroGrid, which
+              creates it anew through the distributed grid factory.
+
+       \param[in]  partitioner  the partitioner, e.g., ALU3dGridSFCPartitioner
+       \param[in]  weights      the weight handle
+       \param[out] destination  process proposed by the partitioner for each
+                                interior macro element of this process, in the
+                                order of the level 0 interior iterator
+
+       \returns true, if the weighted load is imbalanced
+     */
+    template< class WeightHandle >
+    bool weightedLoadImbalanced ( const ALU3dGridPartitioner &partitioner, const WeightHandle &weights,
+                                  std::vector< int > &destination ) const;
+
+    /** \brief Check whether the weighted load of the processes is imbalanced.
+
+       \copydetails weightedLoadImbalanced(const ALU3dGridPartitioner &,const WeightHandle &,std::vector< int > &) const
+     */
+    template< class WeightHandle >
+    bool weightedLoadImbalanced ( const ALU3dGridPartitioner &partitioner, const WeightHandle &weights ) const
+    {
+      std::vector< int > destination;
+      return weightedLoadImbalanced( partitioner, weights, destination );
+    }
+
     /** \brief ghostSize is one for codim 0 and zero otherwise for this grid  */
     int ghostSize (int level, int codim) const;
 
@@ -800,7 +846,12 @@ namespace Dune
     template< class GridImp, class DataHandle >
     bool adapt ( AdaptDataHandleInterface< GridImp, DataHandle > &handle );
 
-    //! uses the interface, mark on entity and refineLocal
+    /** \brief refine all leaf elements refCount times
+     *
+     *  The leaf elements are marked directly inside ALUGrid and all levels
+     *  are refined before the index sets, id sets and sizes are updated
+     *  (only once).
+     */
     void globalRefine ( int refCount );
 
     template< class GridImp, class DataHandle >
@@ -960,6 +1011,15 @@ namespace Dune
       return levelEdgeList_[level];
     }
 
+    // marker for the hierarchic indices of codimension codim, reset for a new traversal
+    ALU3dGridItemMarker & getItemMarker(int codim) const
+    {
+      assert( codim >= 1 );
+      assert( codim <= 3 );
+      itemMarker_.reset( hierSetSize( codim ) );
+      return itemMarker_;
+    }
+
   protected:
     //! Copy constructor should not be used
     ALU3dGrid( const ThisType & );
@@ -973,6 +1033,12 @@ namespace Dune
     //! calculate maxlevel
     void calcMaxLevel();
 
+    //! mark all interior leaf elements for refinement (without DUNE entities)
+    void markAllForRefinement();
+
+    //! refine (and coarsen) the marked elements inside ALUGrid, without updating DUNE structures
+    bool adaptHierarchy();
+
     //! make grid walkthrough and calc global size
     void recalcGlobalSize();
 
@@ -1075,6 +1141,8 @@ namespace Dune
 
     mutable ALU3dGridItemListType levelEdgeList_[MAXL];
 
+    mutable ALU3dGridItemMarker itemMarker_;
+
     mutable LeafVertexListType leafVertexList_;
 
     // the type of our size cache
@@ -441,43 +441,63 @@ namespace Dune
   {
     assert( (refCount + maxLevel()) < MAXL );
 
+    if( lockPostAdapt_ == true )
+    {
+      DUNE_THROW(InvalidStateException,"Make sure that postAdapt is called after adapt was called and returned true!");
+    }
+
+    // refine all levels first, the DUNE structures are updated only once
+    bool refined = false;
     for( int count = refCount; count > 0; --count )
     {
-      const LeafIteratorType end = leafend();
-      for( LeafIteratorType it = leafbegin(); it != end; ++it )
-        mark( 1, *it );
-      const bool refined = adapt();
-      if( refined )
-        postAdapt();
+      markAllForRefinement();
+      refined |= adaptHierarchy();
+    }
+
+    if( refined )
+    {
+      // calcs maxlevel and other extras
+      updateStatus();
+      postAdapt();
     }
   }
 
-  // preprocess grid
+  // mark all leaf elements for refinement
   template< ALU3dGridElementType elType, class Comm >
   alu_inline
-  bool ALU3dGrid< elType, Comm >::preAdapt()
+  void ALU3dGrid< elType, Comm >::markAllForRefinement ()
   {
-    return (coarsenMarked_ > 0);
-  }
+    typedef ALU3dImplTraits< elType, Comm > ImplTraits;
+    typedef typename ImplTraits::HElementType HElementType;
+    typedef typename ImplTraits::IMPLElementType IMPLElementType;
 
+    // for tetrahedral elements check whether to use bisection
+    const bool bisection = (elType == tetra) && conformingRefinement();
 
-  // adapt grid
+    // the ALU leaf iterator only visits interior elements (no ghosts)
+    ALU3DSPACE LeafIterator< HElementType > leafElements( myGrid() );
+    for( leafElements->first(); !leafElements->done(); leafElements->next() )
+    {
+      IMPLElementType &item = static_cast< IMPLElementType & >( leafElements->item() );
+      if( bisection )
+        item.request( ImplTraits::bisect_element_t );
+      else
+        item.request( ImplTraits::refine_element_t );
+    }
+    // all leaf elements are marked now (the counter is reset by calcExtras)
+    refineMarked_ = leafElements->size();
+  }
+
+  // refine the marked elements
   template< ALU3dGridElementType elType, class Comm >
   alu_inline
-  bool ALU3dGrid< elType, Comm >::adapt ()
+  bool ALU3dGrid< elType, Comm >::adaptHierarchy ()
   {
     bool ref = false;
 
-    if( lockPostAdapt_ == true )
-    {
-      DUNE_THROW(InvalidStateException,"Make sure that postAdapt is called after adapt was called and returned true!");
-    }
-
-    bool mightCoarse = preAdapt();
     // if prallel run, then adapt also global id set
     if(globalIdSet_)
     {
-      //std::cout << "Start adapt with globalIdSet prolong \n";
       int defaultChunk = newElementsChunk_;
       int actChunk     = refineEstimate_ * refineMarked_;
 
@@ -497,6 +517,32 @@ namespace Dune
     {
       ref = ref && refineMarked_ > 0;
     }
+    return ref;
+  }
+
+  // preprocess grid
+  template< ALU3dGridElementType elType, class Comm >
+  alu_inline
+  bool ALU3dGrid< elType, Comm >::preAdapt()
+  {
+    return (coarsenMarked_ > 0);
+  }
+
+
+  // adapt grid
+  template< ALU3dGridElementType elType, class Comm >
+  alu_inline
+  bool ALU3dGrid< elType, Comm >::adapt ()
+  {
+    bool ref = false;
+
+    if( lockPostAdapt_ == true )
+    {
+      DUNE_THROW(InvalidStateException,"Make sure that postAdapt is called after adapt was called and returned true!");
+    }
+
+    bool mightCoarse = preAdapt();
+    ref = adaptHierarchy();
 
     if(ref || mightCoarse)
     {
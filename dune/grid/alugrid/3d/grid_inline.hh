@@ -326,11 +326,10 @@ namespace Dune
   {
     assert( (refCount + maxLevel()) < MAXL );
 
+    // the data has to be prolongated level by level, so only the marking is batched
     for( int count = refCount; count > 0; --count )
     {
-      const LeafIteratorType end = leafend();
-      for( LeafIteratorType it = leafbegin(); it != end; ++it )
-        mark( 1 , *it );
+      markAllForRefinement();
       adapt( handle );
     }
   }
@@ -423,6 +422,18 @@ namespace Dune
     template< class DataHandle >
     static bool loadBalance ( Grid &grid, DataHandle &data ) { return false; }
 
+    template< class WeightHandle >
+    static bool weightedLoadImbalanced ( const Grid &grid, const ALU3dGridPartitioner &partitioner,
+                                         const WeightHandle &weights, std::vector< int > &destination )
+    {
+      typedef typename Grid::template Codim< 0 >::template Partition< Interior_Partition >::LevelIterator Iterator;
+      destination.clear();
+      const Iterator end = grid.template lend< 0, Interior_Partition >( 0 );
+      for( Iterator it = grid.template lbegin< 0, Interior_Partition >( 0 ); it != end; ++it )
+        destination.push_back( 0 );
+      return false;
+    }
+
     template< class DataHandle, class DataType >
     static void communicate ( const Grid &grid,
                               const CommDataHandleIF< DataHandle, DataType > &data,
@@ -524,6 +535,64 @@ namespace Dune
     }
 
 
+    // check whether the partitioner improves the weighted load balance
+    // beyond its tolerance (yields the same result on all processes)
+    template< class WeightHandle >
+    static bool weightedLoadImbalanced ( const Grid &grid, const ALU3dGridPartitioner &partitioner,
+                                         const WeightHandle &weights, std::vector< int > &destination )
+    {
+      typedef typename Grid::template Codim< 0 >::template Partition< Interior_Partition >::LevelIterator Iterator;
+      typedef ALU3dGridPartitioner::CoordinateType CoordinateType;
+
+      // each macro element is sent as its center followed by its weight
+      const int dimension = CoordinateType::dimension;
+      const int recordSize = dimension + 1;
+
+      // center and weight of the local macro elements
+      std::vector< double > localData;
+      const Iterator end = grid.template lend< 0, Interior_Partition >( 0 );
+      for( Iterator it = grid.template lbegin< 0, Interior_Partition >( 0 ); it != end; ++it )
+      {
+        const CoordinateType center = it->geometry().center();
+        localData.insert( localData.end(), center.begin(), center.end() );
+        localData.push_back( weights.weight( *it ) );
+      }
+
+      // gather the data of all macro elements on all processes
+      const int numProcs = grid.comm().size();
+      std::vector< double > globalData;
+      std::vector< int > offsets;
+      ALU3dGridPartitioner::allgather( grid.comm(), localData, globalData, offsets );
+
+      const std::size_t numElements = globalData.size() / recordSize;
+      std::vector< CoordinateType > centers( numElements );
+      std::vector< double > weightVector( numElements );
+      std::vector< int > owner( numElements );
+      for( int p = 0; p < numProcs; ++p )
+      {
+        for( int k = offsets[ p ] / recordSize; k < offsets[ p+1 ] / recordSize; ++k )
+        {
+          for( int i = 0; i < dimension; ++i )
+            centers[ k ][ i ] = globalData[ recordSize*k+i ];
+          weightVector[ k ] = globalData[ recordSize*k+dimension ];
+          owner[ k ] = p;
+        }
+      }
+
+      std::vector< int > globalDestination;
+      partitioner.partition( centers, weightVector, numProcs, globalDestination );
+
+      // return the destinations of the local macro elements
+      const int rank = grid.comm().rank();
+      destination.assign( globalDestination.begin() + offsets[ rank ] / recordSize,
+                          globalDestination.begin() + offsets[ rank+1 ] / recordSize );
+
+      const double current = ALU3dGridPartitioner::imbalance( weightVector, numProcs, owner );
+      const double target = ALU3dGridPartitioner::imbalance( weightVector, numProcs, globalDestination );
+      return (current > partitioner.tolerance()) && (current > target);
+    }
+
+
     template< class DataHandle, class DataType >
     static void communicate ( const Grid &grid,
                               CommDataHandleIF< DataHandle, DataType > &data,
@@ -666,6 +735,17 @@ namespace Dune
   }
 
 
+  // check the load balance with respect to user defined weights
+  template< ALU3dGridElementType elType, class Comm >
+  template< class WeightHandle >
+  inline bool ALU3dGrid< elType, Comm >
+  ::weightedLoadImbalanced ( const ALU3dGridPartitioner &partitioner, const WeightHandle &weights,
+                             std::vector< int > &destination ) const
+  {
+    return ALU3dGridCommHelper< elType, Comm >::weightedLoadImbalanced( *this, partitioner, weights, destination );
+  }
+
+
   // communicate level data
   template< ALU3dGridElementType elType, class Comm >
   template <class DataHandleImp,class DataType>
@@ -5,6 +5,7 @@
 #define DUNE_ALU3DGRIDITERATOR_HH
 
 // System includes
+#include <new>
 
 // Dune includes
 #include <dune/grid/common/grid.hh>
@@ -400,6 +401,23 @@ namespace Dune {
   //  --IterationImpl
   //
   //////////////////////////////////////////////////////////////////////////////
+  // storage for the wrapper of the internal iterator within the Dune
+  // iterator, so that the wrapper itself is not allocated on the heap; the
+  // ALUGrid iterators inside the wrappers still allocate, except for the
+  // codim 0 wrappers, which only allocate the macro element iterator
+  template< class InternalIteratorType >
+  union ALU3dGridIteratorStorage
+  {
+    char buffer_[ sizeof( InternalIteratorType ) ];
+    double alignDouble_;
+    long alignLong_;
+    void *alignPointer_;
+  };
+
+  // the methods of InternalIteratorType are called qualified, because the
+  // dynamic type of the internal iterator is always known here and this
+  // avoids the virtual calls of IteratorWrapperInterface (the calls into
+  // ALUGrid's iterators inside the wrappers of codim > 0 stay virtual)
   template <class InternalIteratorType >
   class ALU3dGridTreeIterator
   {
@@ -448,10 +466,10 @@ namespace Dune {
     void firstItem(const GridImp & grid, IteratorImp & it, int level )
     {
       InternalIteratorType & iter = it.internalIterator();
-      iter.first();
-      if( ! iter.done() )
+      iter.InternalIteratorType::first();
+      if( ! iter.InternalIteratorType::done() )
       {
-        assert( iter.size() > 0 );
+        assert( iter.InternalIteratorType::size() > 0 );
         setItem(grid,it,iter,level);
       }
       else
@@ -465,7 +483,7 @@ namespace Dune {
     void setItem (const GridImp & grid, IteratorImp & it, InternalIteratorType & iter, int level)
     {
       enum { codim = IteratorImp :: codimension };
-      val_t & item = iter.item();
+      val_t & item = iter.InternalIteratorType::item();
       assert( item.first || item.second );
       if( item.first )
       {
@@ -483,9 +501,9 @@ namespace Dune {
       // if iter_ is zero, then end iterator
       InternalIteratorType & iter = it.internalIterator();
 
-      iter.next();
+      iter.InternalIteratorType::next();
 
-      if(iter.done())
+      if( iter.InternalIteratorType::done() )
       {
         it.removeIter();
         return ;
@@ -564,8 +582,9 @@ namespace Dune {
     // actual level
     int level_;
 
-    // the internal iterator
+    // the internal iterator, points to iterStorage_ or is zero
     IteratorType * iter_ ;
+    ALU3dGridIteratorStorage< IteratorType > iterStorage_;
 
     // deletes iter_
     void removeIter ();
@@ -634,8 +653,9 @@ namespace Dune {
     ThisType & operator = (const ThisType & org);
 
   private:
-    // the internal iterator
+    // the internal iterator, points to iterStorage_ or is zero
     IteratorType * iter_;
+    ALU3dGridIteratorStorage< IteratorType > iterStorage_;
 
     // max level for iteration
     int walkLevel_ ;
@@ -0,0 +1,179 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_ALU3DGRID_PARTITIONER_HH
+#define DUNE_ALU3DGRID_PARTITIONER_HH
+
+#include <algorithm>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/grid/utility/spacefillingcurve.hh>
+
+namespace Dune
+{
+
+  // ALU3dGridPartitioner
+  // --------------------
+
+  /** \brief interface for partitioners of the ALU3dGrid macro grid
+   *
+   *  A partitioner assigns each macro element to a process, given the
+   *  centers and weights of all macro elements. It is called with the same
+   *  (global) data on all processes and must return the same result on all
+   *  processes.
+   *
+   *  \note The partitioner does not depend on the ALUGrid library; it can
+   *        also be used to distribute a macro grid before it is inserted
+   *        into a grid factory.
+   */
+  class ALU3dGridPartitioner
+  {
+  public:
+    typedef FieldVector< double, 3 > CoordinateType;
+
+    /** \brief constructor
+     *
+     *  \param[in]  tolerance  maximal accepted ratio between the largest and
+     *                         the mean load of a process
+     */
+    explicit ALU3dGridPartitioner ( double tolerance = 1.2 )
+      : tolerance_( tolerance )
+    {}
+
+    virtual ~ALU3dGridPartitioner () {}
+
+    //! maximal accepted ratio between the largest and the mean load of a process
+    double tolerance () const { return tolerance_; }
+
+    /** \brief assign the macro elements to the processes
+     *
+     *  \param[in]   centers      centers of the macro elements
+     *  \param[in]   weights      (nonnegative) weights of the macro elements
+     *  \param[in]   numProcs     number of processes
+     *  \param[out]  destination  process of each macro element
+     */
+    virtual void partition ( const std::vector< CoordinateType > &centers,
+                             const std::vector< double > &weights,
+                             int numProcs, std::vector< int > &destination ) const = 0;
+
+    /** \brief compute the ratio between the largest and the mean load of a process
+     *
+     *  \param[in]  weights      weights of the macro elements
+     *  \param[in]  numProcs     number of processes
+     *  \param[in]  destination  process of each macro element
+     */
+    static double imbalance ( const std::vector< double > &weights,
+                              int numProcs, const std::vector< int > &destination )
+    {
+      std::vector< double > load( numProcs, 0.0 );
+      double total = 0.0;
+      for( std::size_t k = 0; k < weights.size(); ++k )
+      {
+        load[ destination[ k ] ] += weights[ k ];
+        total += weights[ k ];
+      }
+      if( total <= 0.0 )
+        return 1.0;
+      return *std::max_element( load.begin(), load.end() ) * numProcs / total;
+    }
+
+    /** \brief gather blocks of varying size from all processes on all processes
+     *
+     *  The collective communication only gathers blocks of equal size, so the
+     *  blocks are padded to the largest one.
+     *
+     *  \param[in]   comm        collective communication
+     *  \param[in]   localData   block of this process
+     *  \param[out]  globalData  blocks of all processes, ordered by rank
+     *  \param[out]  offsets     offset of the block of each process in
+     *                           globalData, followed by the size of globalData
+     */
+    template< class Communication >
+    static void allgather ( const Communication &comm, std::vector< double > localData,
+                            std::vector< double > &globalData, std::vector< int > &offsets )
+    {
+      const int numProcs = comm.size();
+      int localSize = localData.size();
+      std::vector< int > sizes( numProcs );
+      comm.allgather( &localSize, 1, &sizes[ 0 ] );
+
+      offsets.assign( numProcs+1, 0 );
+      for( int p = 0; p < numProcs; ++p )
+        offsets[ p+1 ] = offsets[ p ] + sizes[ p ];
+
+      const int blockSize = *std::max_element( sizes.begin(), sizes.end() );
+      globalData.clear();
+      if( blockSize == 0 )
+        return;
+
+      localData.resize( blockSize, 0.0 );
+      std::vector< double > blocks( numProcs * blockSize );
+      comm.allgather( &localData[ 0 ], blockSize, &blocks[ 0 ] );
+      for( int p = 0; p < numProcs; ++p )
+        globalData.insert( globalData.end(), blocks.begin() + p*blockSize, blocks.begin() + p*blockSize + sizes[ p ] );
+    }
+
+  private:
+    double tolerance_;
+  };
+
+
+
+  // ALU3dGridSFCPartitioner
+  // -----------------------
+
+  /** \brief partition the ALU3dGrid macro grid along a space-filling curve
+   *
+   *  The macro elements are sorted along a Hilbert or Morton curve through
+   *  their centers and the curve is cut into segments of equal weight.
+   *  This yields connected partitions for most meshes and requires no
+   *  external library.
+   */
+  class ALU3dGridSFCPartitioner
+    : public ALU3dGridPartitioner
+  {
+    typedef ALU3dGridPartitioner BaseType;
+
+  public:
+    typedef BaseType::CoordinateType CoordinateType;
+    typedef SpaceFillingCurve< double, 3 > CurveType;
+
+    /** \brief constructor
+     *
+     *  \param[in]  type       type of the space-filling curve
+     *  \param[in]  tolerance  maximal accepted ratio between the largest and
+     *                         the mean load of a process
+     */
+    explicit ALU3dGridSFCPartitioner ( CurveType::Type type = CurveType::hilbert, double tolerance = 1.2 )
+      : BaseType( tolerance ), type_( type )
+    {}
+
+    virtual void partition ( const std::vector< CoordinateType > &centers,
+                             const std::vector< double > &weights,
+                             int numProcs, std::vector< int > &destination ) const
+    {
+      // bounding box of the centers
+      CoordinateType lower( 0 ), upper( 0 );
+      if( !centers.empty() )
+        lower = upper = centers[ 0 ];
+      for( std::size_t k = 1; k < centers.size(); ++k )
+      {
+        for( int i = 0; i < 3; ++i )
+        {
+          lower[ i ] = std::min( lower[ i ], centers[ k ][ i ] );
+          upper[ i ] = std::max( upper[ i ], centers[ k ][ i ] );
+        }
+      }
+
+      const CurveType curve( type_, lower, upper );
+      partitionSpaceFillingCurve( curve, centers, weights, numProcs, destination );
+    }
+
+  private:
+    CurveType::Type type_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_ALU3DGRID_PARTITIONER_HH
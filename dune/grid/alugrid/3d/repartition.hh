@@ -0,0 +1,220 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_ALU3DGRID_REPARTITION_HH
+#define DUNE_ALU3DGRID_REPARTITION_HH
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/grid/alugrid/3d/alu3dgridfactory.hh>
+#include <dune/grid/alugrid/3d/partitioner.hh>
+
+#if HAVE_ALUGRID
+
+namespace Dune
+{
+
+  // communicator to hand to the grid factory of an ALU3dGrid
+#if ALU3DGRID_PARALLEL
+  inline MPI_Comm alu3dGridFactoryCommunicator ( const CollectiveCommunication< MPI_Comm > &comm )
+  {
+    return comm;
+  }
+#endif // #if ALU3DGRID_PARALLEL
+
+  inline No_Comm alu3dGridFactoryCommunicator ( const CollectiveCommunication< No_Comm > &comm )
+  {
+    return No_Comm();
+  }
+
+
+
+  // lexicographic order of coordinates
+  struct ALU3dGridCoordinateLess
+  {
+    bool operator() ( const ALU3dGridPartitioner::CoordinateType &a, const ALU3dGridPartitioner::CoordinateType &b ) const
+    {
+      return std::lexicographical_compare( a.begin(), a.end(), b.begin(), b.end() );
+    }
+  };
+
+
+
+  // repartitionMacroGrid
+  // --------------------
+
+  /** \brief create the macro grid of an ALU3dGrid anew, distributed
+   *         according to user defined weights
+   *
+   *  ALU3dGrid::loadBalance balances the number of leaf elements, because
+   *  ALUGrid neither accepts weights nor prescribed destinations for its
+   *  macro elements. This function gathers the macro elements of all
+   *  processes, assigns them to the processes by the partitioner using the
+   *  weights and inserts the share of each process into a distributed grid
+   *  factory (see Capabilities::hasDistributedGridFactory).
+   *
+   *  The weight of each macro element is obtained from a weight handle
+   *  implementing
+   *    \code
+   *    // return the (nonnegative) computational cost of the macro element e
+   *    double weight ( const Dune::Entity<0> & e ) const;
+   *    \endcode
+   *
+   *  \note Only the macro grid is migrated: the refinement and all user data
+   *        are lost, so repartition the grid before refining it. Boundary ids
+   *        are preserved; boundary projections and periodic boundaries are
+   *        not supported.
+   *
+   *  \param[in]  grid         the grid to repartition
+   *  \param[in]  partitioner  the partitioner, e.g., ALU3dGridSFCPartitioner
+   *  \param[in]  weights      the weight handle
+   *
+   *  \returns the new grid; the caller takes responsibility for deleting it
+   */
+  template< class Grid, class WeightHandle >
+  inline Grid *repartitionMacroGrid ( const Grid &grid, const ALU3dGridPartitioner &partitioner,
+                                      const WeightHandle &weights )
+  {
+    typedef typename Grid::LevelGridView MacroView;
+    typedef typename MacroView::template Codim< 0 >::template Partition< Interior_Partition >::Iterator Iterator;
+    typedef typename MacroView::IntersectionIterator IntersectionIterator;
+    typedef typename Grid::template Codim< 0 >::Geometry Geometry;
+    typedef ALU3dGridPartitioner::CoordinateType CoordinateType;
+
+    const int dimension = Grid::dimension;
+    const GeometryType type( (Grid::elementType == tetra) ? GeometryType::simplex : GeometryType::cube, dimension );
+    const ReferenceElement< double, dimension > &refElement = ReferenceElements< double, dimension >::general( type );
+    const int numCorners = refElement.size( dimension );
+    const int numFaces = refElement.size( 1 );
+
+    // each macro element is sent as its corners, the boundary ids of its faces
+    // (-1 for faces not on the domain boundary) and its weight
+    const int recordSize = numCorners*dimension + numFaces + 1;
+
+    std::vector< double > localData;
+    const MacroView macroView = grid.levelGridView( 0 );
+    const Iterator end = macroView.template end< 0, Interior_Partition >();
+    for( Iterator it = macroView.template begin< 0, Interior_Partition >(); it != end; ++it )
+    {
+      const Geometry geometry = it->geometry();
+      for( int i = 0; i < numCorners; ++i )
+      {
+        const CoordinateType corner = geometry.corner( i );
+        localData.insert( localData.end(), corner.begin(), corner.end() );
+      }
+
+      std::vector< double > boundaryIds( numFaces, -1.0 );
+      const IntersectionIterator iend = macroView.iend( *it );
+      for( IntersectionIterator iit = macroView.ibegin( *it ); iit != iend; ++iit )
+      {
+        if( iit->boundary() )
+          boundaryIds[ iit->indexInInside() ] = iit->boundaryId();
+      }
+      localData.insert( localData.end(), boundaryIds.begin(), boundaryIds.end() );
+
+      localData.push_back( weights.weight( *it ) );
+    }
+
+    std::vector< double > globalData;
+    std::vector< int > offsets;
+    ALU3dGridPartitioner::allgather( grid.comm(), localData, globalData, offsets );
+    const std::size_t numElements = globalData.size() / recordSize;
+
+    // partition the macro grid
+    std::vector< CoordinateType > corners( numElements*numCorners ), centers( numElements, CoordinateType( 0 ) );
+    std::vector< double > weightVector( numElements );
+    for( std::size_t k = 0; k < numElements; ++k )
+    {
+      const double *record = &globalData[ recordSize*k ];
+      for( int i = 0; i < numCorners; ++i )
+      {
+        std::copy( record + dimension*i, record + dimension*(i+1), corners[ numCorners*k+i ].begin() );
+        centers[ k ].axpy( 1.0 / numCorners, corners[ numCorners*k+i ] );
+      }
+      weightVector[ k ] = record[ recordSize-1 ];
+    }
+
+    const int numProcs = grid.comm().size();
+    const int rank = grid.comm().rank();
+    std::vector< int > destination;
+    partitioner.partition( centers, weightVector, numProcs, destination );
+
+    // the same vertex has the same coordinates on all processes, so the
+    // position of its coordinates in the sorted list is a global index
+    typedef ALU3dGridCoordinateLess CoordinateLess;
+    std::vector< CoordinateType > vertices( corners );
+    std::sort( vertices.begin(), vertices.end(), CoordinateLess() );
+    vertices.erase( std::unique( vertices.begin(), vertices.end() ), vertices.end() );
+
+    std::vector< unsigned int > globalVertex( corners.size() );
+    for( std::size_t i = 0; i < corners.size(); ++i )
+      globalVertex[ i ] = std::lower_bound( vertices.begin(), vertices.end(), corners[ i ], CoordinateLess() ) - vertices.begin();
+
+    // the elements sharing each face, the face is given by its sorted global vertex indices
+    typedef std::map< std::vector< unsigned int >, std::vector< std::size_t > > FaceMap;
+    FaceMap faces;
+    std::vector< std::vector< unsigned int > > faceKeys( numElements*numFaces );
+    for( std::size_t k = 0; k < numElements; ++k )
+    {
+      for( int f = 0; f < numFaces; ++f )
+      {
+        std::vector< unsigned int > &key = faceKeys[ numFaces*k+f ];
+        for( int i = 0; i < refElement.size( f, 1, dimension ); ++i )
+          key.push_back( globalVertex[ numCorners*k + refElement.subEntity( f, 1, i, dimension ) ] );
+        std::sort( key.begin(), key.end() );
+        faces[ key ].push_back( k );
+      }
+    }
+
+    // insert the macro elements assigned to this process
+    GridFactory< Grid > factory( alu3dGridFactoryCommunicator( grid.comm() ) );
+    std::map< unsigned int, unsigned int > localVertex;
+    int element = 0;
+    for( std::size_t k = 0; k < numElements; ++k )
+    {
+      if( destination[ k ] != rank )
+        continue;
+
+      std::vector< unsigned int > elementVertices( numCorners );
+      for( int i = 0; i < numCorners; ++i )
+      {
+        const unsigned int v = globalVertex[ numCorners*k+i ];
+        if( localVertex.find( v ) == localVertex.end() )
+          localVertex[ v ] = factory.insertVertex( vertices[ v ], v );
+        elementVertices[ i ] = localVertex[ v ];
+      }
+      factory.insertElement( type, elementVertices );
+
+      const double *boundaryIds = &globalData[ recordSize*k + dimension*numCorners ];
+      for( int f = 0; f < numFaces; ++f )
+      {
+        const std::vector< std::size_t > &neighbors = faces[ faceKeys[ numFaces*k+f ] ];
+        if( neighbors.size() == 2 )
+        {
+          const std::size_t neighbor = (neighbors[ 0 ] == k ? neighbors[ 1 ] : neighbors[ 0 ]);
+          if( destination[ neighbor ] != rank )
+            factory.insertProcessBorder( element, f );
+        }
+        else if( boundaryIds[ f ] >= 0 )
+          factory.insertBoundary( element, f, int( boundaryIds[ f ] ) );
+        else
+          DUNE_THROW( NotImplemented, "repartitionMacroGrid does not support periodic boundaries" );
+      }
+      ++element;
+    }
+
+    return factory.createGrid();
+  }
+
+} // namespace Dune
+
+#endif // #if HAVE_ALUGRID
+
+#endif // #ifndef DUNE_ALU3DGRID_REPARTITION_HH
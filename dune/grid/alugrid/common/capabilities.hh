@@ -113,6 +113,17 @@ namespace Dune
       static const bool v = true;
     };
 
+    /** \brief The GridFactory of ALUGrid accepts a distributed coarse grid when Comm == MPI_Comm
+       \ingroup ALUGrid
+     */
+#if ALU3DGRID_PARALLEL
+    template< ALUGridElementType eltype, ALUGridRefinementType refinementtype >
+    struct hasDistributedGridFactory< ALUGrid< 3, 3, eltype, refinementtype, MPI_Comm > >
+    {
+      static const bool v = true;
+    };
+#endif
+
   } // end namespace Capabilities
 
 } //end  namespace Dune
@@ -106,6 +106,26 @@ namespace Dune
       static const bool v = false;
     };
 
+    /** \brief Specialize with 'true' if the GridFactory of the grid accepts a coarse grid
+               distributed over the processes. (default=false)
+
+        Each process inserts only its own part of the coarse grid. The vertices are
+        inserted together with a global index, which has to be the same on all
+        processes sharing the vertex, and the faces shared with another process are
+        marked as process borders:
+        \code
+        VertexId insertVertex ( const FieldVector<ctype,dimworld> &pos, size_t globalId );
+        void insertProcessBorder ( int element, int face );
+        \endcode
+
+        \ingroup GICapabilities
+     */
+    template<class Grid>
+    struct hasDistributedGridFactory
+    {
+      static const bool v = false;
+    };
+
     /** \brief Specialize with 'true' if the grid implementation is thread safe. (default=false)
 
         This capability is 'true' if the grid is <b>always</b> thread safe.
@@ -208,6 +228,12 @@ namespace Dune
       static const bool v = Dune::Capabilities::hasBackupRestoreFacilities<Grid>::v;
     };
 
+    template<class Grid>
+    struct hasDistributedGridFactory<const Grid>
+    {
+      static const bool v = Dune::Capabilities::hasDistributedGridFactory<Grid>::v;
+    };
+
     template <class Grid>
     struct threadSafe<const Grid> {
       static const bool v = Dune::Capabilities::threadSafe<Grid>::v;
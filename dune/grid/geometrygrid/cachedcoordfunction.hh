@@ -5,6 +5,7 @@
 
 #include <cassert>
 #include <memory>
+#include <vector>
 
 #include <dune/common/typetraits.hh>
 
@@ -144,6 +145,11 @@ namespace Dune
     }
 
   private:
+    typedef integral_constant< bool, GeoGrid::isDiscreteCoordFunctionInterface< typename CoordFunction::Interface >::value > IsDiscrete;
+
+    void buildCache ( integral_constant< bool, true > );
+    void buildCache ( integral_constant< bool, false > );
+
     const HostGrid &hostGrid_;
     const CoordFunction &coordFunction_;
     Cache cache_;
@@ -156,6 +162,14 @@ namespace Dune
 
   template< class HostGrid, class CoordFunction >
   inline void CachedCoordFunction< HostGrid, CoordFunction >::buildCache ()
+  {
+    buildCache( IsDiscrete() );
+  }
+
+
+  template< class HostGrid, class CoordFunction >
+  inline void CachedCoordFunction< HostGrid, CoordFunction >
+    ::buildCache ( integral_constant< bool, true > )
   {
     typedef typename HostGrid::template Codim< 0 >::Entity Element;
     typedef typename HostGrid::LevelGridView MacroView;
@@ -179,6 +193,44 @@ namespace Dune
   }
 
 
+  template< class HostGrid, class CoordFunction >
+  inline void CachedCoordFunction< HostGrid, CoordFunction >
+    ::buildCache ( integral_constant< bool, false > )
+  {
+    // analytical coordinate functions are evaluated once per vertex and
+    // level, passing all vertex coordinates of a level as one batch
+    static const int dimension = HostGrid::dimension;
+
+    typedef typename HostGrid::LevelGridView LevelView;
+    typedef typename LevelView::template Codim< dimension >::template Partition< All_Partition >::Iterator VertexIterator;
+
+    typedef typename CoordFunction::DomainVector DomainVector;
+
+    std::vector< DomainVector > x;
+    std::vector< RangeVector > y;
+
+    const int maxLevel = hostGrid_.maxLevel();
+    for( int level = 0; level <= maxLevel; ++level )
+    {
+      const LevelView levelView = hostGrid_.levelGridView( level );
+
+      x.clear();
+      x.reserve( levelView.size( dimension ) );
+      const VertexIterator end = levelView.template end< dimension, All_Partition >();
+      for( VertexIterator it = levelView.template begin< dimension, All_Partition >(); it != end; ++it )
+        x.push_back( it->geometry().corner( 0 ) );
+
+      y.resize( x.size() );
+      if( !x.empty() )
+        coordFunction_.evaluateBatch( &x[ 0 ], &y[ 0 ], x.size() );
+
+      std::size_t i = 0;
+      for( VertexIterator it = levelView.template begin< dimension, All_Partition >(); it != end; ++it, ++i )
+        cache_( *it, 0 ) = y[ i ];
+    }
+  }
+
+
   template< class HostGrid, class CoordFunction >
   template< class HostEntity >
   inline void CachedCoordFunction< HostGrid, CoordFunction >
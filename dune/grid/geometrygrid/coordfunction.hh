@@ -3,6 +3,8 @@
 #ifndef DUNE_GEOGRID_COORDFUNCTION_HH
 #define DUNE_GEOGRID_COORDFUNCTION_HH
 
+#include <cstddef>
+
 #include <dune/common/fvector.hh>
 
 namespace Dune
@@ -72,6 +74,21 @@ namespace Dune
       return asImp().evaluate( x, y );
     }
 
+    /** \brief evaluate the global mapping for a batch of points
+     *
+     *  Implementations may override this method to evaluate many points at
+     *  once, e.g., using SIMD instructions or multiple threads. By default,
+     *  the pointwise evaluate method is called for each point.
+     *
+     *  \param[in]   x  contiguous array of \em n domain vectors
+     *  \param[out]  y  contiguous array of \em n range vectors
+     *  \param[in]   n  number of points
+     */
+    void evaluateBatch ( const DomainVector *x, RangeVector *y, std::size_t n ) const
+    {
+      asImp().evaluateBatch( x, y, n );
+    }
+
   protected:
     const Implementation &asImp () const
     {
@@ -102,6 +119,16 @@ namespace Dune
     typedef typename Base :: DomainVector DomainVector;
     typedef typename Base :: RangeVector RangeVector;
 
+    /** \brief default implementation of the batched evaluation
+     *
+     *  Calls the pointwise evaluate method for each point.
+     */
+    void evaluateBatch ( const DomainVector *x, RangeVector *y, std::size_t n ) const
+    {
+      for( std::size_t i = 0; i < n; ++i )
+        Base::asImp().evaluate( x[ i ], y[ i ] );
+    }
+
   protected:
     AnalyticalCoordFunction ()
     {}
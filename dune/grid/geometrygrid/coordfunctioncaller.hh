@@ -3,6 +3,10 @@
 #ifndef DUNE_GEOGRID_COORDFUNCTIONCALLER_HH
 #define DUNE_GEOGRID_COORDFUNCTIONCALLER_HH
 
+#include <cassert>
+
+#include <dune/common/array.hh>
+
 #include <dune/grid/geometrygrid/hostcorners.hh>
 #include <dune/grid/geometrygrid/coordfunction.hh>
 
@@ -26,6 +30,8 @@ namespace Dune
 
       static const int codimension = HostEntity::codimension;
 
+      typedef typename CoordFunctionInterface::DomainVector DomainVector;
+
     public:
       typedef typename CoordFunctionInterface::RangeVector RangeVector;
 
@@ -40,6 +46,17 @@ namespace Dune
         coordFunction_.evaluate( hostCorners_[ i ], y );
       }
 
+      template< std::size_t numCorners >
+      void evaluate ( array< RangeVector, numCorners > &y ) const
+      {
+        const std::size_t n = size();
+        assert( n <= numCorners );
+        array< DomainVector, numCorners > x;
+        for( std::size_t i = 0; i < n; ++i )
+          x[ i ] = hostCorners_[ i ];
+        coordFunction_.evaluateBatch( &x[ 0 ], &y[ 0 ], n );
+      }
+
       GeometryType type () const
       {
         return hostCorners_.type();
@@ -75,6 +92,15 @@ namespace Dune
         coordFunction_.evaluate( hostEntity_, i, y );
       }
 
+      template< std::size_t numCorners >
+      void evaluate ( array< RangeVector, numCorners > &y ) const
+      {
+        const std::size_t n = size();
+        assert( n <= numCorners );
+        for( std::size_t i = 0; i < n; ++i )
+          coordFunction_.evaluate( hostEntity_, i, y[ i ] );
+      }
+
       GeometryType type () const
       {
         return hostEntity_.type();
@@ -215,10 +215,7 @@ namespace Dune
       Geometry geometry () const
       {
         if( !geo_ )
-        {
-          CoordVector coords( hostEntity(), grid().coordFunction() );
-          geo_ = GeometryImpl( grid(), type(), coords );
-        }
+          initializeGeometry( integral_constant< bool, (codimension == 0) >() );
         return Geometry( geo_ );
       }
 
@@ -305,6 +302,20 @@ namespace Dune
       /** \} */
 
     private:
+      void initializeGeometry ( integral_constant< bool, false > ) const
+      {
+        CoordVector coords( hostEntity(), grid().coordFunction() );
+        geo_ = GeometryImpl( grid(), type(), coords );
+      }
+
+      void initializeGeometry ( integral_constant< bool, true > ) const
+      {
+        if( grid().geometryCacheEnabled() )
+          geo_ = grid().geometryCache()( hostEntity() );
+        else
+          initializeGeometry( integral_constant< bool, false >() );
+      }
+
       mutable GeometryImpl geo_;
       const HostEntity *hostEntity_;
     };
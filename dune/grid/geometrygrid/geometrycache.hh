@@ -0,0 +1,182 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GEOGRID_GEOMETRYCACHE_HH
+#define DUNE_GEOGRID_GEOMETRYCACHE_HH
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/typetraits.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/grid/geometrygrid/coordfunctioncaller.hh>
+#include <dune/grid/geometrygrid/cornerstorage.hh>
+
+namespace Dune
+{
+
+  namespace GeoGrid
+  {
+
+    // GeometryCache
+    // -------------
+
+    /** \brief cache for the geometries of the elements of a GeometryGrid
+     *  \ingroup GeoGrid
+     *
+     *  The geometry of a GeometryGrid element is obtained by evaluating the
+     *  coordinate function in all corners of the host element and setting up
+     *  a CachedMultiLinearGeometry. If the cache is enabled, the geometry is
+     *  only set up once and then shared (by reference counting) among all
+     *  entities referring to the same host element. Hence, corners, the
+     *  Jacobian for affine elements and the affinity flag are computed only
+     *  once per element.
+     *
+     *  The geometries are stored per grid level in a vector indexed by the
+     *  host level index set. Consequently, the cache has to be cleared
+     *  whenever the host grid changes, which is done in
+     *  GeometryGrid::update() and GeometryGrid::postAdapt().
+     *
+     *  The cached corners are the values of the coordinate function at the
+     *  time the geometry was first requested. If the coordinate function
+     *  changes, e.g., if the vertices of a discrete coordinate function are
+     *  moved, GeometryGrid::update() has to be called. In debug builds, the
+     *  first corner of each cached geometry is compared with the coordinate
+     *  function, so a missing update() fails an assertion.
+     *
+     *  \note The cache is disabled by default.
+     */
+    template< class Grid >
+    class GeometryCache
+    {
+      typedef GeometryCache< Grid > This;
+
+      typedef typename remove_const< Grid >::type::Traits Traits;
+
+      static const int dimension = Traits::dimension;
+
+      typedef typename Traits::HostGrid HostGrid;
+      typedef typename HostGrid::Traits::LevelIndexSet HostLevelIndexSet;
+
+    public:
+      typedef typename Traits::template Codim< 0 >::GeometryImpl GeometryImpl;
+
+      typedef typename HostGrid::template Codim< 0 >::Entity HostElement;
+
+    private:
+      typedef GeoGrid::CoordVector< dimension, Grid, false > CoordVector;
+      typedef GeoGrid::CoordFunctionCaller< HostElement, typename Traits::CoordFunction::Interface > CoordFunctionCaller;
+
+      struct LevelCache
+      {
+        std::vector< std::pair< GeometryType, std::size_t > > offsets;
+        std::vector< GeometryImpl > geometries;
+      };
+
+    public:
+      explicit GeometryCache ( const Grid &grid )
+        : grid_( grid ),
+          enabled_( false )
+      {}
+
+      ~GeometryCache () { clear(); }
+
+      /** \brief is the cache enabled? */
+      bool enabled () const { return enabled_; }
+
+      /** \brief enable or disable the cache
+       *
+       *  \note Disabling the cache releases all cached geometries.
+       */
+      void enable ( bool enabled )
+      {
+        enabled_ = enabled;
+        if( !enabled_ )
+          clear();
+      }
+
+      /** \brief release all cached geometries */
+      void clear () { levels_.clear(); }
+
+      /** \brief obtain the (cached) geometry of a host element */
+      const GeometryImpl &operator() ( const HostElement &hostElement )
+      {
+        assert( enabled() );
+
+        const int level = hostElement.level();
+        if( std::size_t( level ) >= levels_.size() )
+          levels_.resize( level+1 );
+
+        LevelCache &levelCache = levels_[ level ];
+        const HostLevelIndexSet &indexSet = grid_.hostGrid().levelIndexSet( level );
+        if( levelCache.geometries.empty() )
+          initialize( indexSet, levelCache );
+
+        const GeometryType type = hostElement.type();
+        const std::size_t index = offset( levelCache, type ) + indexSet.index( hostElement );
+        assert( index < levelCache.geometries.size() );
+
+        GeometryImpl &geo = levelCache.geometries[ index ];
+        if( !geo )
+        {
+          CoordVector coords( hostElement, grid_.coordFunction() );
+          geo = GeometryImpl( grid_, type, coords );
+        }
+        assert( upToDate( hostElement, geo ) );
+        return geo;
+      }
+
+    private:
+      GeometryCache ( const This & );
+      This &operator= ( const This & );
+
+      void initialize ( const HostLevelIndexSet &indexSet, LevelCache &levelCache ) const
+      {
+        typedef typename std::vector< GeometryType >::const_iterator TypeIterator;
+
+        levelCache.offsets.clear();
+        std::size_t size = 0;
+        const std::vector< GeometryType > &types = indexSet.geomTypes( 0 );
+        const TypeIterator end = types.end();
+        for( TypeIterator it = types.begin(); it != end; ++it )
+        {
+          levelCache.offsets.push_back( std::make_pair( *it, size ) );
+          size += indexSet.size( *it );
+        }
+        levelCache.geometries.resize( size, GeometryImpl( grid_ ) );
+      }
+
+      // does the first corner of the geometry still match the coordinate function?
+      bool upToDate ( const HostElement &hostElement, const GeometryImpl &geo ) const
+      {
+        typename GeometryImpl::GlobalCoordinate y;
+        CoordFunctionCaller( hostElement, grid_.coordFunction() ).evaluate( 0, y );
+        y -= geo.corner( 0 );
+        return (y.two_norm() <= 1e-8 * (1.0 + geo.corner( 0 ).two_norm()));
+      }
+
+      static std::size_t offset ( const LevelCache &levelCache, const GeometryType &type )
+      {
+        const std::size_t numTypes = levelCache.offsets.size();
+        for( std::size_t i = 0; i < numTypes; ++i )
+        {
+          if( levelCache.offsets[ i ].first == type )
+            return levelCache.offsets[ i ].second;
+        }
+        assert( false );
+        return 0;
+      }
+
+      const Grid &grid_;
+      bool enabled_;
+      std::vector< LevelCache > levels_;
+    };
+
+  } // namespace GeoGrid
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GEOGRID_GEOMETRYCACHE_HH
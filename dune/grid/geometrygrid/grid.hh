@@ -11,6 +11,7 @@
 #include <dune/grid/geometrygrid/backuprestore.hh>
 #include <dune/grid/geometrygrid/capabilities.hh>
 #include <dune/grid/geometrygrid/datahandle.hh>
+#include <dune/grid/geometrygrid/geometrycache.hh>
 #include <dune/grid/geometrygrid/gridfamily.hh>
 #include <dune/grid/geometrygrid/identity.hh>
 #include <dune/grid/geometrygrid/persistentcontainer.hh>
@@ -94,6 +95,7 @@ namespace Dune
     template< class, bool > friend class GeoGrid::EntityPointer;
     template< int, class > friend class GeoGrid::EntityProxy;
     template< int, int, class > friend class GeoGrid::Geometry;
+    template< class > friend class GeoGrid::GeometryCache;
     template< class, class, class, PartitionIteratorType > friend class GeoGrid::GridView;
     template< class, class > friend class GeoGrid::Intersection;
     template< class, class > friend class GeoGrid::IntersectionIterator;
@@ -239,7 +241,8 @@ namespace Dune
         coordFunction_( coordFunction ),
         removeHostGrid_( false ),
         levelIndexSets_( hostGrid_->maxLevel()+1, nullptr, allocator ),
-        storageAllocator_( allocator )
+        storageAllocator_( allocator ),
+        geometryCache_( *this )
     {}
 
     /** \brief constructor
@@ -256,13 +259,16 @@ namespace Dune
         coordFunction_( *coordFunction ),
         removeHostGrid_( true ),
         levelIndexSets_( hostGrid_->maxLevel()+1, nullptr, allocator ),
-        storageAllocator_( allocator )
+        storageAllocator_( allocator ),
+        geometryCache_( *this )
     {}
 
     /** \brief destructor
      */
     ~GeometryGrid ()
     {
+      geometryCache_.clear();
+
       for( unsigned int i = 0; i < levelIndexSets_.size(); ++i )
       {
         if( levelIndexSets_[ i ] )
@@ -420,6 +426,7 @@ namespace Dune
     void postAdapt ()
     {
       hostGrid().postAdapt();
+      geometryCache_.clear();
     }
 
     /** \name Parallel Data Distribution and Communication Methods
@@ -628,9 +635,35 @@ namespace Dune
       return *hostGrid_;
     }
 
+    /** \brief enable or disable caching of element geometries
+     *
+     *  If enabled, the geometry of each element is computed only once and
+     *  shared by all entities referring to the same host element (see
+     *  GeoGrid::GeometryCache). This pays off if geometry() is called
+     *  repeatedly for the same element, e.g., for curvilinear coordinate
+     *  functions.
+     *
+     *  \note The cache is disabled by default.
+     *  \note The cached geometries are not recomputed if the coordinate
+     *        function changes. In this case, update() has to be called.
+     *
+     *  \param[in]  enabled  \b true, if element geometries shall be cached
+     */
+    void enableGeometryCache ( bool enabled = true )
+    {
+      geometryCache_.enable( enabled );
+    }
+
+    /** \brief are element geometries cached? */
+    bool geometryCacheEnabled () const
+    {
+      return geometryCache_.enabled();
+    }
+
     /** \brief update grid caches
      *
-     *  This method has to be called whenever the underlying host grid changes.
+     *  This method has to be called whenever the underlying host grid or the
+     *  coordinate function changes.
      *
      *  \note If you adapt the host grid through this geometry grid's
      *        adaptation or load balancing methods, update is automatically
@@ -641,6 +674,9 @@ namespace Dune
       // adapt the coordinate function
       GeoGrid::AdaptCoordFunction< typename CoordFunction::Interface >::adapt( coordFunction_ );
 
+      // drop all cached element geometries
+      geometryCache_.clear();
+
       const int newNumLevels = maxLevel()+1;
       const int oldNumLevels = levelIndexSets_.size();
 
@@ -679,6 +715,11 @@ namespace Dune
       storageAllocator_.deallocate( (char *)p, size );
     }
 
+    GeoGrid::GeometryCache< const Grid > &geometryCache () const
+    {
+      return geometryCache_;
+    }
+
   private:
     HostGrid *const hostGrid_;
     CoordFunction &coordFunction_;
@@ -688,6 +729,7 @@ namespace Dune
     mutable GlobalIdSet globalIdSet_;
     mutable LocalIdSet localIdSet_;
     mutable typename Allocator::template rebind< char >::other storageAllocator_;
+    mutable GeoGrid::GeometryCache< const Grid > geometryCache_;
   };
 
 
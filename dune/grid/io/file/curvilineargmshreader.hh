@@ -4,23 +4,32 @@
 #ifndef DUNE_CURVILINEARGMSHREADER_HH
 #define DUNE_CURVILINEARGMSHREADER_HH
 
+#include <algorithm>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 #include <stdio.h>
 
+#include <dune/common/array.hh>
 #include <dune/common/exceptions.hh>
 #include <dune/common/fvector.hh>
+#include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/shared_ptr.hh>
+#include <dune/common/static_assert.hh>
+#include <dune/common/typetraits.hh>
 
+#include <dune/geometry/referenceelements.hh>
 #include <dune/geometry/type.hh>
 
 #include <dune/grid/common/boundarysegment.hh>
+#include <dune/grid/common/capabilities.hh>
 #include <dune/grid/common/gridfactory.hh>
 
 namespace Dune
@@ -210,6 +219,13 @@ namespace Dune
     Dune::GridFactory<GridType>& factory;
     bool verbose;
     bool insert_boundary_segments;
+    // partition to read; a negative rank reads all elements
+    int partition_rank;
+    int partition_count;
+    // faces (sorted gmsh node numbers) of the elements of this rank and
+    // the subset of them shared with elements of other ranks
+    std::set< std::vector<int> > local_faces;
+    std::set< std::vector<int> > border_faces;
     unsigned int number_of_real_vertices;
     int boundary_element_count;
     int element_count;
@@ -254,6 +270,9 @@ namespace Dune
     // typedefs
     typedef FieldVector< double, dimWorld > GlobalVector;
 
+    // does the factory accept a distributed coarse grid?
+    typedef integral_constant< bool, Capabilities::hasDistributedGridFactory< GridType >::v > DistributedFactory;
+
     // don't use something like
     //   readfile(file, 1, "%s\n", buf);
     // to skip the rest of of the line -- that will only skip the next
@@ -282,10 +301,28 @@ namespace Dune
 
   public:
 
-    CurvilinearGmshReaderParser(Dune::GridFactory<GridType>& _factory, bool v, bool i) :
-      factory(_factory), verbose(v), insert_boundary_segments(i)
+    /** \brief create a parser
+     *
+     *  If rank is nonnegative, only the elements whose Gmsh partition
+     *  tag belongs to this rank (and the vertices they need) are inserted
+     *  into the factory.  Gmsh partitions are numbered from 1; partition p
+     *  is assigned to rank (p-1) % size.  Elements without partition tag
+     *  belong to rank 0.  Boundary elements are inserted by the rank owning
+     *  the adjacent element, whatever their partition tag.  The vertices
+     *  are inserted with their Gmsh node number as global index and the faces shared with elements of other
+     *  ranks are inserted as process borders, so this requires a factory
+     *  accepting a distributed coarse grid (see
+     *  Capabilities::hasDistributedGridFactory).
+     */
+    CurvilinearGmshReaderParser(Dune::GridFactory<GridType>& _factory, bool v, bool i,
+                                int rank = -1, int size = 1) :
+      factory(_factory), verbose(v), insert_boundary_segments(i),
+      partition_rank(rank), partition_count(size)
 
   	{
+      if ((partition_rank >= 0) && !DistributedFactory::value)
+        DUNE_THROW(Dune::NotImplemented, "The grid factory does not accept a distributed coarse grid.");
+
     	/** \brief build a map that stores the number of vertex indices for a specific element type **/
 		nodeofelement.clear();
 
@@ -404,83 +441,128 @@ namespace Dune
 
       //=========================================
       // Pass 1: Renumber needed vertices
+      //         Keep the elements to be inserted
       //=========================================
 
-      long section_element_offset = ftell(file);
+      // The element section is read only once; the elements this process
+      // inserts are kept as flat records (type, physical entity, dofs).
       std::map<int,unsigned int> renumber;
-      for (int i=1; i<=number_of_elements; i++)
-      {
-    /** \brief handle one line in the gmsh file, i.e. handle an element **/
-    int id, elm_type, number_of_tags;
-    readfile(file,3,"%d %d %d ",&id,&elm_type,&number_of_tags);
-
-    for (int k=1; k<=number_of_tags; k++)
-    {
-    		  int blub;
-    		  readfile(file,1,"%d ",&blub);
-			  // k == 1: physical entity (not used here)
-			  // k == 2: elementary entity (not used here either)
-			  // if version_number < 2.2:
-			  //   k == 3: mesh partition 0
-			  // else
-			  //   k == 3: number of mesh partitions
-			  //   k => 4: mesh partition k-4
-    }
-    /** \brief pass no. 1 - handle the element **/
-    pass1HandleElement(file, elm_type, renumber, nodes);
-      }
-
-      if (verbose) std::cout << "number of real vertices = " << number_of_real_vertices << std::endl;
-      if (verbose) std::cout << "number of boundary elements = " << boundary_element_count << std::endl;
-      if (verbose) std::cout << "number of elements = " << element_count << std::endl;
-      readfile(file,1,"%s\n",buf);
-      if (strcmp(buf,"$EndElements")!=0)
-        DUNE_THROW(Dune::IOError, "expected $EndElements");
-      boundary_id_to_physical_entity.resize(boundary_element_count);
-      element_index_to_physical_entity.resize(element_count);
-
-      //==============================================
-      // Pass 2: Insert boundary segments and elements
-      //==============================================
-
-      fseek(file, section_element_offset, SEEK_SET);
-      boundary_element_count = 0;
-      element_count = 0;
+      std::vector<int> records, foreignRecords;
       for (int i=1; i<=number_of_elements; i++)
       {
         int id, elm_type, number_of_tags;
         readfile(file,3,"%d %d %d ",&id,&elm_type,&number_of_tags);
         int physical_entity = -1;
-        std::vector<int> mesh_partitions;
-        if ( version_number < 2.2 )
-        {
-          mesh_partitions.resize(1);
-        }
+        int partition = 0;
         for (int k=1; k<=number_of_tags; k++)
         {
           int blub;
           readfile(file,1,"%d ",&blub);
           if (k==1) physical_entity = blub;
           // k == 2: elementary entity (not used here)
+          // if version_number < 2.2:
+          //   k == 3: mesh partition
+          // else
+          //   k == 3: number of mesh partitions
+          //   k == 4: owning mesh partition
+          //   k > 4: ghost partitions (negative, not used here)
           if ( version_number < 2.2 )
           {
-            if (k==3) mesh_partitions[0] = blub;
+            if (k==3) partition = blub;
           }
           else
           {
-            if (k > 3)
-              mesh_partitions[k-4] = blub;
-            else
-              mesh_partitions.resize(blub);
+            if (k==4) partition = blub;
           }
         }
-        pass2HandleElement(file, elm_type, renumber, nodes, physical_entity);
+        pass1HandleElement(file, elm_type, physical_entity, partition, renumber, nodes, records, foreignRecords);
       }
+
+      if (verbose) std::cout << "number of real vertices = " << number_of_real_vertices << std::endl;
+      if (verbose) std::cout << "number of boundary elements = " << boundary_element_count << std::endl;
+      if (verbose) std::cout << "number of elements = " << element_count << std::endl;
       readfile(file,1,"%s\n",buf);
       if (strcmp(buf,"$EndElements")!=0)
         DUNE_THROW(Dune::IOError, "expected $EndElements");
 
       fclose(file);
+
+      // in parallel, find the faces shared with elements of other ranks
+      local_faces.clear();
+      border_faces.clear();
+      if (partition_rank >= 0)
+      {
+        std::vector<int> elementDofs(10);
+        for (std::size_t r = 0; r < records.size(); )
+        {
+          const int elm_type = records[r++];
+          r++;        // physical entity
+          for (int i = 0; i < nDofs(elm_type); ++i)
+            elementDofs[i] = records[r++];
+          if (elementDim(elm_type) == dim)
+            insertFaces(elm_type, elementDofs, local_faces);
+        }
+        for (std::size_t r = 0; r < foreignRecords.size(); )
+        {
+          const int elm_type = foreignRecords[r++];
+          for (int i = 0; i < nDofs(elm_type); ++i)
+            elementDofs[i] = foreignRecords[r++];
+          insertFaces(elm_type, elementDofs, border_faces, &local_faces);
+        }
+        std::vector<int>().swap(foreignRecords);
+      }
+
+      //==============================================
+      // Pass 2: Insert boundary segments and elements
+      //==============================================
+
+      boundary_id_to_physical_entity.clear();
+      boundary_id_to_physical_entity.reserve(boundary_element_count);
+      element_index_to_physical_entity.clear();
+      element_index_to_physical_entity.reserve(element_count);
+      boundary_element_count = 0;
+      element_count = 0;
+
+      // '10' is the largest number of dofs we may encounter in a .msh file
+      std::vector<int> elementDofs(10);
+      for (std::size_t r = 0; r < records.size(); )
+      {
+        const int elm_type = records[r++];
+        const int physical_entity = records[r++];
+        for (int i = 0; i < nDofs(elm_type); ++i)
+          elementDofs[i] = records[r++];
+        pass2HandleElement(elm_type, elementDofs, renumber, nodes, physical_entity);
+      }
+
+      if (verbose && (partition_rank >= 0))
+        std::cout << "rank " << partition_rank << " inserted " << element_count << " elements and "
+                  << boundary_element_count << " boundary segments" << std::endl;
+    }
+
+    /** \brief insert the faces of an element into a set of faces
+     *
+     *  Each face is given by the sorted Gmsh node numbers of its corners.
+     *  If filter is given, only faces contained in it are inserted.
+     *  elementDofs holds the Gmsh node numbers of the element and may be
+     *  modified.
+     */
+    static void insertFaces (const int elm_type, std::vector<int>& elementDofs,
+                             std::set< std::vector<int> >& faces,
+                             const std::set< std::vector<int> >* filter = 0)
+    {
+      renumberToDune(elm_type, elementDofs);
+
+      const ReferenceElement< double, dim > &refElement
+        = ReferenceElements< double, dim >::general(elementType(elm_type));
+      for (int f = 0; f < refElement.size(1); ++f)
+      {
+        std::vector<int> face(refElement.size(f, 1, dim));
+        for (std::size_t k = 0; k < face.size(); ++k)
+          face[k] = elementDofs[refElement.subEntity(f, 1, k, dim)];
+        std::sort(face.begin(), face.end());
+        if (!filter || (filter->find(face) != filter->end()))
+          faces.insert(face);
+      }
     }
 
     /*****************************************************************************************************/
@@ -491,8 +573,12 @@ namespace Dune
     /*****************************************************************************************************/
     void pass1HandleElement(FILE* file,
     						const int elm_type,
+    						const int physical_entity,
+    						const int partition,
     						std::map<int,unsigned int>& renumber,
-    						const std::vector<GlobalVector>& nodes)
+    						const std::vector<GlobalVector>& nodes,
+    						std::vector<int>& records,
+    						std::vector<int>& foreignRecords)
     {
     	/** \brief we ONLY read higher order triangles and tetrahedra **/
 
@@ -635,13 +721,38 @@ namespace Dune
                &(elementDofs[6]),&(elementDofs[7]),&(elementDofs[8]),
                &(elementDofs[9]));
 
-      // insert each vertex if it hasn't been inserted already
-      for (int i=0; i<nVertices[elm_type]; i++)
-        if (renumber.find(elementDofs[i])==renumber.end())
+      // in parallel, skip elements owned by other ranks, but remember their
+      // corners to find the process borders; boundary elements are kept
+      // regardless of their partition tag, because gmsh may assign them to
+      // the partition of either adjacent element, and are checked against
+      // the local faces in pass 2
+      if (partition_rank >= 0 && elementDim[elm_type] == dim)
+      {
+        if (partition > 0 ? ((partition-1) % partition_count != partition_rank)
+                          : (partition_rank != 0))
         {
-          renumber[elementDofs[i]] = number_of_real_vertices++;
-          factory.insertVertex(nodes[elementDofs[i]]);
+          foreignRecords.push_back(elm_type);
+          foreignRecords.insert(foreignRecords.end(), elementDofs.begin(), elementDofs.begin() + nDofs[elm_type]);
+          return;
         }
+      }
+
+      // insert each vertex if it hasn't been inserted already; boundary
+      // elements of a partition never introduce vertices of their own
+      if (partition_rank < 0 || elementDim[elm_type] == dim)
+      {
+        for (int i=0; i<nVertices[elm_type]; i++)
+          if (renumber.find(elementDofs[i])==renumber.end())
+          {
+            renumber[elementDofs[i]] = number_of_real_vertices++;
+            insertVertex(nodes[elementDofs[i]], elementDofs[i], DistributedFactory());
+          }
+      }
+
+      // keep the element for pass 2
+      records.push_back(elm_type);
+      records.push_back(physical_entity);
+      records.insert(records.end(), elementDofs.begin(), elementDofs.begin() + nDofs[elm_type]);
 
       // count elements and boundary elements
       if (elementDim[elm_type] == dim)
@@ -651,6 +762,81 @@ namespace Dune
 
     }
 
+    // number of dofs of a (supported) gmsh element type
+    static int nDofs (const int elm_type)
+    {
+      const int nDofs[12] = {-1, 2, 3, 4, 4, 8, 6, 5, 3, 6, -1, 10};
+      return nDofs[elm_type];
+    }
+
+    // dimension of a (supported) gmsh element type
+    static int elementDim (const int elm_type)
+    {
+      const int elementDim[12] = {-1, 1, 2, 2, 3, 3, 3, 3, 1, 2, -1, 3};
+      return elementDim[elm_type];
+    }
+
+    // Dune geometry type of a (supported) gmsh element type of dimension dim
+    static GeometryType elementType (const int elm_type)
+    {
+      switch (elm_type)
+      {
+      case 3 :          // 4-node quadrilateral
+      case 5 :          // 8-node hexahedron
+        return GeometryType(GeometryType::cube, dim);
+      case 6 :          // 6-node prism
+        return GeometryType(GeometryType::prism, dim);
+      case 7 :          // 5-node pyramid
+        return GeometryType(GeometryType::pyramid, dim);
+      default :
+        return GeometryType(GeometryType::simplex, dim);
+      }
+    }
+
+    // correct differences between gmsh and Dune in the local vertex numbering
+    static void renumberToDune (const int elm_type, std::vector<int>& elementDofs)
+    {
+      switch (elm_type)
+      {
+      case 3 :          // 4-node quadrilateral
+        std::swap(elementDofs[2],elementDofs[3]);
+        break;
+      case 5 :          // 8-node hexahedron
+        std::swap(elementDofs[2],elementDofs[3]);
+        std::swap(elementDofs[6],elementDofs[7]);
+        break;
+      case 7 :          // 5-node pyramid
+        std::swap(elementDofs[2],elementDofs[3]);
+        break;
+      }
+    }
+
+    // insert a vertex, with its gmsh node number as global index if the
+    // factory accepts a distributed coarse grid
+    void insertVertex (const GlobalVector& pos, const int id, const true_type&)
+    {
+      if (partition_rank >= 0)
+        factory.insertVertex(pos, id);
+      else
+        factory.insertVertex(pos);
+    }
+
+    void insertVertex (const GlobalVector& pos, const int id, const false_type&)
+    {
+      factory.insertVertex(pos);
+    }
+
+    // mark a face as shared with another process
+    void insertProcessBorder (const int element, const int face, const true_type&)
+    {
+      factory.insertProcessBorder(element, face);
+    }
+
+    void insertProcessBorder (const int element, const int face, const false_type&)
+    {
+      DUNE_THROW(Dune::NotImplemented, "The grid factory does not accept a distributed coarse grid.");
+    }
+
 
 
     // generic-case: This is not supposed to be used at runtime.
@@ -678,7 +864,7 @@ namespace Dune
           v[i][j] = nodes[elementDofs[i]][j];
 
       BoundarySegment<dim,dimWorld>* newBoundarySegment
-        = (BoundarySegment<dim,dimWorld>*) new GmshReaderQuadraticBoundarySegment< 3, 3 >( v[0], v[1], v[2],
+        = (BoundarySegment<dim,dimWorld>*) new CurvilinearGmshReaderQuadraticBoundarySegment< 3, 3 >( v[0], v[1], v[2],
                                                                                            v[3], v[4], v[5] );
 
       factory.insertBoundarySegment( vertices,
@@ -689,53 +875,33 @@ namespace Dune
 
 
 
-    virtual void pass2HandleElement(FILE* file, const int elm_type,
+    /** \brief insert an element kept in pass 1
+     *
+     *  The element type has been checked in pass 1; elementDofs holds the
+     *  gmsh node numbers of the element and may be modified.
+     */
+    virtual void pass2HandleElement(const int elm_type,
+                                    std::vector<int> & elementDofs,
                                     std::map<int,unsigned int> & renumber,
                                     const std::vector< GlobalVector > & nodes,
                                     const int physical_entity)
     {
       // some data about gmsh elements
-      const int nDofs[12]      = {-1, 2, 3, 4, 4, 8, 6, 5, 3, 6, -1, 10};
       const int nVertices[12]  = {-1, 2, 3, 4, 4, 8, 6, 5, 2, 3, -1, 4};
       const int elementDim[12] = {-1, 1, 2, 2, 3, 3, 3, 3, 1, 2, -1, 3};
 
-      // test whether we support the element type
-      if ( not (elm_type >= 0 && elm_type < 12         // index in suitable range?
-                && (elementDim[elm_type] == dim || elementDim[elm_type] == (dim-1) ) ) )         // real element or boundary element?
+      // in parallel, a boundary segment is only inserted if it is a face
+      // of an element of this rank
+      if (elementDim[elm_type] != dim && partition_rank >= 0)
       {
-        skipline(file);         // skip rest of line if element is unknown
-        return;
+        std::vector<int> face(elementDofs.begin(), elementDofs.begin() + nVertices[elm_type]);
+        std::sort(face.begin(), face.end());
+        if (local_faces.find(face) == local_faces.end())
+          return;
       }
 
-      // The format string for parsing is n times '%d' in a row
-      std::string formatString = "%d";
-      for (int i=1; i<nDofs[elm_type]; i++)
-        formatString += " %d";
-      formatString += "\n";
-
-      // '10' is the largest number of dofs we may encounter in a .msh file
-      std::vector<int> elementDofs(10);
-
-      readfile(file,nDofs[elm_type], formatString.c_str(),
-               &(elementDofs[0]),&(elementDofs[1]),&(elementDofs[2]),
-               &(elementDofs[3]),&(elementDofs[4]),&(elementDofs[5]),
-               &(elementDofs[6]),&(elementDofs[7]),&(elementDofs[8]),
-               &(elementDofs[9]));
-
       // correct differences between gmsh and Dune in the local vertex numbering
-      switch (elm_type)
-      {
-      case 3 :          // 4-node quadrilateral
-        std::swap(elementDofs[2],elementDofs[3]);
-        break;
-      case 5 :          // 8-node hexahedron
-        std::swap(elementDofs[2],elementDofs[3]);
-        std::swap(elementDofs[6],elementDofs[7]);
-        break;
-      case 7 :          // 5-node pyramid
-        std::swap(elementDofs[2],elementDofs[3]);
-        break;
-      }
+      renumberToDune(elm_type, elementDofs);
 
       // renumber corners to account for the explicitly given vertex
       // numbering in the file
@@ -778,6 +944,22 @@ namespace Dune
           break;
         }
 
+        // mark the faces shared with elements of other ranks
+        if (!border_faces.empty())
+        {
+          const ReferenceElement< double, dim > &refElement
+            = ReferenceElements< double, dim >::general(elementType(elm_type));
+          for (int f = 0; f < refElement.size(1); ++f)
+          {
+            std::vector<int> face(refElement.size(f, 1, dim));
+            for (std::size_t k = 0; k < face.size(); ++k)
+              face[k] = elementDofs[refElement.subEntity(f, 1, k, dim)];
+            std::sort(face.begin(), face.end());
+            if (border_faces.find(face) != border_faces.end())
+              insertProcessBorder(element_count, f, DistributedFactory());
+          }
+        }
+
       } else {
         // it must be a boundary segment then
         if (insert_boundary_segments) {
@@ -800,7 +982,7 @@ namespace Dune
               v[2][i] = nodes[elementDofs[1]][i];
             }
             BoundarySegment<dim,dimWorld>* newBoundarySegment
-              = (BoundarySegment<dim,dimWorld>*) new GmshReaderQuadraticBoundarySegment< 2, dimWorld >(v[0], v[1], v[2]);
+              = (BoundarySegment<dim,dimWorld>*) new CurvilinearGmshReaderQuadraticBoundarySegment< 2, dimWorld >(v[0], v[1], v[2]);
             factory.insertBoundarySegment(vertices,
                                           shared_ptr<BoundarySegment<dim,dimWorld> >(newBoundarySegment));
             break;
@@ -817,10 +999,10 @@ namespace Dune
 
       // count elements and boundary elements
       if (elementDim[elm_type] == dim) {
-        element_index_to_physical_entity[element_count] = physical_entity;
+        element_index_to_physical_entity.push_back(physical_entity);
         element_count++;
       } else {
-        boundary_id_to_physical_entity[boundary_element_count] = physical_entity;
+        boundary_id_to_physical_entity.push_back(physical_entity);
         boundary_element_count++;
       }
 
@@ -910,6 +1092,68 @@ namespace Dune
 	element_index_to_physical_entity.swap(parser.elementIndexMap());
 }
 
+    /** \brief read the part of a partitioned mesh that belongs to this process
+     *
+     *  If the grid factory accepts a distributed coarse grid (see
+     *  Capabilities::hasDistributedGridFactory), every process reads the
+     *  file, but only inserts the elements whose Gmsh partition tag belongs
+     *  to its rank in comm, together with the vertices and boundary segments
+     *  they need.  Partition p is assigned to rank (p-1) % comm.size();
+     *  untagged elements go to rank 0.  Boundary segments are inserted with
+     *  the adjacent element, whatever their partition tag.  The vertices are
+     *  inserted with their Gmsh node number as global index and the faces
+     *  shared with other ranks as process borders, so that the factory
+     *  creates one grid distributed over all processes.
+     *
+     *  For other grids, the whole mesh is read on rank 0 and the partition
+     *  tags are ignored; call loadBalance() on the created grid to
+     *  distribute it.
+     *
+     *  The physical entity maps refer to the locally inserted entities.
+     */
+    template< class C >
+    static void read (Dune::GridFactory<Grid>& factory,
+                      const std::string& fileName,
+                      const CollectiveCommunication<C>& comm,
+                      std::vector<int>& boundary_id_to_physical_entity,
+                      std::vector<int>& element_index_to_physical_entity,
+                      bool verbose = true, bool insert_boundary_segments=true)
+    {
+      if (Capabilities::hasDistributedGridFactory<Grid>::v)
+      {
+        // create parse object
+        CurvilinearGmshReaderParser<Grid> parser(factory,verbose && (comm.rank() == 0),insert_boundary_segments,
+                                                 comm.rank(),comm.size());
+        parser.read(fileName);
+
+        boundary_id_to_physical_entity.swap(parser.boundaryIdMap());
+        element_index_to_physical_entity.swap(parser.elementIndexMap());
+      }
+      else
+      {
+        boundary_id_to_physical_entity.clear();
+        element_index_to_physical_entity.clear();
+        if (comm.rank() == 0)
+          read(factory,fileName,boundary_id_to_physical_entity,element_index_to_physical_entity,
+               verbose,insert_boundary_segments);
+      }
+    }
+
+    /** \brief read the part of a partitioned mesh that belongs to this process
+     *
+     *  \sa read(Dune::GridFactory<Grid>&, const std::string&, const CollectiveCommunication<C>&, std::vector<int>&, std::vector<int>&, bool, bool)
+     */
+    template< class C >
+    static void read (Dune::GridFactory<Grid>& factory,
+                      const std::string& fileName,
+                      const CollectiveCommunication<C>& comm,
+                      bool verbose = true, bool insert_boundary_segments=true)
+    {
+      std::vector<int> boundary_id_to_physical_entity, element_index_to_physical_entity;
+      read(factory,fileName,comm,boundary_id_to_physical_entity,element_index_to_physical_entity,
+           verbose,insert_boundary_segments);
+    }
+
   };
 
   /** \} */
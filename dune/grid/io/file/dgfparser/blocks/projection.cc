@@ -2,6 +2,9 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include <config.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <dune/common/math.hh>
 
 #include <dune/grid/io/file/dgfparser/blocks/projection.hh>
@@ -27,6 +30,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         Vector value_;
@@ -37,6 +41,7 @@ namespace Dune
         : public ProjectionBlock::Expression
       {
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
       };
 
 
@@ -50,6 +55,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *function_;
@@ -67,6 +73,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         std::vector< const ProjectionBlock::Expression * > expressions_;
@@ -82,6 +89,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -97,6 +105,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -111,6 +120,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -125,6 +135,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -139,6 +150,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -153,6 +165,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *expression_;
@@ -169,6 +182,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -188,6 +202,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -207,6 +222,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -226,6 +242,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -245,6 +262,7 @@ namespace Dune
         {}
 
         virtual void evaluate ( const Vector &argument, Vector &result ) const;
+        virtual Slot compile ( ProjectionBlock::Program &program, const Slot &argument ) const;
 
       private:
         const ProjectionBlock::Expression *exprA_;
@@ -434,10 +452,346 @@ namespace Dune
           result[ i ] *= factor;
       }
 
+
+      ProjectionBlock::Expression::Slot
+      ConstantExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot target = program.allocate( value_.size() );
+        const Slot value( program.addConstant( value_ ), value_.size() );
+        program.append( ProjectionBlock::Program::constant, target, value, Slot(), value_.size() );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      VariableExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        return argument;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      FunctionCallExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        // functions cannot be recursive, so the function body is simply inlined
+        return function_->compile( program, expression_->compile( program, argument ) );
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      VectorExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        std::vector< Slot > components;
+        unsigned int size = 0;
+        typedef std::vector< const Expression * >::const_iterator Iterator;
+        const Iterator end = expressions_.end();
+        for( Iterator it = expressions_.begin(); it != end; ++it )
+        {
+          components.push_back( (*it)->compile( program, argument ) );
+          size += components.back().size;
+        }
+
+        const Slot target = program.allocate( size );
+        unsigned int offset = target.offset;
+        for( size_t i = 0; i < components.size(); ++i )
+        {
+          const Slot part( offset, components[ i ].size );
+          program.append( ProjectionBlock::Program::copy, part, components[ i ], Slot(), part.size );
+          offset += part.size;
+        }
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      BracketExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot value = expression_->compile( program, argument );
+        if( field_ >= value.size )
+          DUNE_THROW( MathError, "Index out of bounds (" <<  field_ << " not in [ 0, " << value.size << " [)." );
+        return Slot( value.offset + field_, 1 );
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      MinusExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot value = expression_->compile( program, argument );
+        const Slot target = program.allocate( value.size );
+        program.append( ProjectionBlock::Program::negate, target, value, Slot(), value.size );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      NormExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot value = expression_->compile( program, argument );
+        const Slot target = program.allocate( 1 );
+        program.append( ProjectionBlock::Program::norm, target, value, Slot(), value.size );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      SqrtExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot value = expression_->compile( program, argument );
+        if( value.size != 1 )
+          DUNE_THROW( MathError, "Cannot calculate square root of a vector." );
+        const Slot target = program.allocate( 1 );
+        program.append( ProjectionBlock::Program::squareRoot, target, value, Slot(), 1 );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      SinExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot value = expression_->compile( program, argument );
+        if( value.size != 1 )
+          DUNE_THROW( MathError, "Cannot calculate the sine of a vector." );
+        const Slot target = program.allocate( 1 );
+        program.append( ProjectionBlock::Program::sine, target, value, Slot(), 1 );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      CosExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot value = expression_->compile( program, argument );
+        if( value.size != 1 )
+          DUNE_THROW( MathError, "Cannot calculate the cosine of a vector." );
+        const Slot target = program.allocate( 1 );
+        program.append( ProjectionBlock::Program::cosine, target, value, Slot(), 1 );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      PowerExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot valueA = exprA_->compile( program, argument );
+        const Slot valueB = exprB_->compile( program, argument );
+        if( (valueA.size != 1) || (valueB.size != 1) )
+          DUNE_THROW( MathError, "Cannot calculate powers of vectors." );
+        const Slot target = program.allocate( 1 );
+        program.append( ProjectionBlock::Program::power, target, valueA, valueB, 1 );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      SumExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot valueA = exprA_->compile( program, argument );
+        const Slot valueB = exprB_->compile( program, argument );
+        if( valueA.size != valueB.size )
+          DUNE_THROW( MathError, "Cannot sum vectors of different size." );
+        const Slot target = program.allocate( valueA.size );
+        program.append( ProjectionBlock::Program::sum, target, valueA, valueB, valueA.size );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      DifferenceExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot valueA = exprA_->compile( program, argument );
+        const Slot valueB = exprB_->compile( program, argument );
+        if( valueA.size != valueB.size )
+          DUNE_THROW( MathError, "Cannot sum vectors of different size." );
+        const Slot target = program.allocate( valueA.size );
+        program.append( ProjectionBlock::Program::difference, target, valueA, valueB, valueA.size );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      ProductExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot valueA = exprA_->compile( program, argument );
+        const Slot valueB = exprB_->compile( program, argument );
+
+        Slot target;
+        if( valueA.size == valueB.size )
+        {
+          target = program.allocate( 1 );
+          program.append( ProjectionBlock::Program::dotProduct, target, valueA, valueB, valueA.size );
+        }
+        else if( valueB.size == 1 )
+        {
+          target = program.allocate( valueA.size );
+          program.append( ProjectionBlock::Program::scale, target, valueA, valueB, valueA.size );
+        }
+        else if( valueA.size == 1 )
+        {
+          target = program.allocate( valueB.size );
+          program.append( ProjectionBlock::Program::scale, target, valueB, valueA, valueB.size );
+        }
+        else
+          DUNE_THROW( MathError, "Cannot multiply non-scalar vectors of different size." );
+        return target;
+      }
+
+
+      ProjectionBlock::Expression::Slot
+      QuotientExpression::compile ( ProjectionBlock::Program &program, const Slot &argument ) const
+      {
+        const Slot valueB = exprB_->compile( program, argument );
+        if( valueB.size != 1 )
+          DUNE_THROW( MathError, "Cannot divide by a vector." );
+        const Slot valueA = exprA_->compile( program, argument );
+        const Slot target = program.allocate( valueA.size );
+        program.append( ProjectionBlock::Program::divide, target, valueA, valueB, valueA.size );
+        return target;
+      }
+
     } // namespace Expr
 
 
 
+    // ProjectionBlock::Program
+    // ------------------------
+
+    ProjectionBlock::Program::Program ( const Expression &expression, unsigned int argumentSize )
+      : workspaceSize_( 0 )
+    {
+      argument_ = allocate( argumentSize );
+      result_ = expression.compile( *this, argument_ );
+    }
+
+
+    ProjectionBlock::Program::Slot ProjectionBlock::Program::allocate ( unsigned int size )
+    {
+      const Slot slot( workspaceSize_, size );
+      workspaceSize_ += size;
+      return slot;
+    }
+
+
+    void ProjectionBlock::Program::append ( OpCode opCode, const Slot &target, const Slot &argA, const Slot &argB, unsigned int size )
+    {
+      Instruction instruction;
+      instruction.opCode = opCode;
+      instruction.target = target.offset;
+      instruction.argA = argA.offset;
+      instruction.argB = argB.offset;
+      instruction.size = size;
+      instructions_.push_back( instruction );
+    }
+
+
+    unsigned int ProjectionBlock::Program::addConstant ( const std::vector< double > &value )
+    {
+      const unsigned int position = constants_.size();
+      constants_.insert( constants_.end(), value.begin(), value.end() );
+      return position;
+    }
+
+
+    void ProjectionBlock::Program::execute ( double *workspace, std::size_t count ) const
+    {
+      typedef std::vector< Instruction >::const_iterator Iterator;
+      const Iterator end = instructions_.end();
+      for( Iterator it = instructions_.begin(); it != end; ++it )
+      {
+        // all values of component j are stored contiguously, starting at j*count
+        double *target = workspace + it->target*count;
+        const std::size_t size = it->size;
+        const std::size_t n = size*count;
+
+        if( it->opCode == constant )
+        {
+          for( std::size_t j = 0; j < size; ++j )
+            std::fill( target + j*count, target + (j+1)*count, constants_[ it->argA + j ] );
+          continue;
+        }
+
+        const double *a = workspace + it->argA*count;
+        const double *b = workspace + it->argB*count;
+        switch( it->opCode )
+        {
+        case copy :
+          std::copy( a, a + n, target );
+          break;
+
+        case negate :
+          for( std::size_t k = 0; k < n; ++k )
+            target[ k ] = -a[ k ];
+          break;
+
+        case norm :
+          for( std::size_t p = 0; p < count; ++p )
+          {
+            double normsqr = 0.0;
+            for( std::size_t j = 0; j < size; ++j )
+              normsqr += a[ j*count + p ] * a[ j*count + p ];
+            target[ p ] = std::sqrt( normsqr );
+          }
+          break;
+
+        case squareRoot :
+          for( std::size_t p = 0; p < count; ++p )
+            target[ p ] = std::sqrt( a[ p ] );
+          break;
+
+        case sine :
+          for( std::size_t p = 0; p < count; ++p )
+            target[ p ] = std::sin( a[ p ] );
+          break;
+
+        case cosine :
+          for( std::size_t p = 0; p < count; ++p )
+            target[ p ] = std::cos( a[ p ] );
+          break;
+
+        case power :
+          for( std::size_t p = 0; p < count; ++p )
+            target[ p ] = std::pow( a[ p ], b[ p ] );
+          break;
+
+        case sum :
+          for( std::size_t k = 0; k < n; ++k )
+            target[ k ] = a[ k ] + b[ k ];
+          break;
+
+        case difference :
+          for( std::size_t k = 0; k < n; ++k )
+            target[ k ] = a[ k ] - b[ k ];
+          break;
+
+        case dotProduct :
+          for( std::size_t p = 0; p < count; ++p )
+          {
+            double product = 0.0;
+            for( std::size_t j = 0; j < size; ++j )
+              product += a[ j*count + p ] * b[ j*count + p ];
+            target[ p ] = product;
+          }
+          break;
+
+        case scale :
+          for( std::size_t j = 0; j < size; ++j )
+            for( std::size_t p = 0; p < count; ++p )
+              target[ j*count + p ] = a[ j*count + p ] * b[ p ];
+          break;
+
+        case divide :
+          for( std::size_t j = 0; j < size; ++j )
+            for( std::size_t p = 0; p < count; ++p )
+              target[ j*count + p ] = a[ j*count + p ] * (1.0 / b[ p ]);
+          break;
+
+        default :
+          DUNE_THROW( InvalidStateException, "Invalid instruction in projection program." );
+        }
+      }
+    }
+
+
+
     // ProjectionBlock
     // ---------------
 
@@ -3,7 +3,12 @@
 #ifndef DUNE_DGF_PROJECTIONBLOCK_HH
 #define DUNE_DGF_PROJECTIONBLOCK_HH
 
+#include <algorithm>
+#include <cstddef>
 #include <map>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
 
 #include <dune/grid/common/boundaryprojection.hh>
 #include <dune/grid/io/file/dgfparser/blocks/basic.hh>
@@ -52,12 +57,11 @@ namespace Dune
 
     public:
       struct Expression;
+      class Program;
 
-    private:
       template< int dimworld >
       class BoundaryProjection;
 
-    public:
       ProjectionBlock ( std::istream &in, int dimworld );
 
       template< int dimworld >
@@ -132,41 +136,166 @@ namespace Dune
     {
       typedef std::vector< double > Vector;
 
+      //! contiguous range of values in the workspace of a Program
+      struct Slot
+      {
+        Slot () : offset( 0 ), size( 0 ) {}
+        Slot ( unsigned int o, unsigned int s ) : offset( o ), size( s ) {}
+
+        unsigned int offset, size;
+      };
+
       virtual ~Expression ()
       {}
 
       virtual void evaluate ( const Vector &argument, Vector &result ) const = 0;
+
+      /** \brief append the instructions evaluating this expression to a program
+       *
+       *  \param      program   program to append the instructions to
+       *  \param[in]  argument  slot holding the value of the variable
+       *
+       *  \returns the slot holding the value of this expression
+       */
+      virtual Slot compile ( Program &program, const Slot &argument ) const = 0;
+    };
+
+
+
+    // ProjectionBlock::Program
+    // ------------------------
+
+    /** \brief an expression compiled into a flat list of instructions
+     *
+     *  The sizes of all intermediate values are fixed by the size of the
+     *  argument, so they are checked and laid out in a workspace once, when
+     *  the program is compiled. Evaluation just runs through the instruction
+     *  list and does not allocate any memory.
+     *
+     *  The workspace holds the values for a batch of points: Component j of
+     *  the value in the workspace position k for point p is stored at
+     *  workspace[ (k+j)*count + p ]. Hence each instruction is applied to all
+     *  points of the batch in a tight loop.
+     */
+    class ProjectionBlock::Program
+    {
+    public:
+      typedef Expression::Slot Slot;
+
+      enum OpCode
+      {
+        constant, copy, negate, norm, squareRoot, sine, cosine, power,
+        sum, difference, dotProduct, scale, divide
+      };
+
+      struct Instruction
+      {
+        OpCode opCode;
+        unsigned int target, argA, argB, size;
+      };
+
+      /** \brief compile an expression
+       *
+       *  \param[in]  expression    expression to compile
+       *  \param[in]  argumentSize  size of the argument vectors
+       */
+      Program ( const Expression &expression, unsigned int argumentSize );
+
+      //! slot the argument has to be stored in before execute() is called
+      const Slot &argument () const { return argument_; }
+
+      //! slot holding the result after execute()
+      const Slot &result () const { return result_; }
+
+      //! number of workspace entries required per point
+      unsigned int workspaceSize () const { return workspaceSize_; }
+
+      /** \brief evaluate the expression for a batch of points
+       *
+       *  \param      workspace  workspace of size workspaceSize()*count
+       *                         with the arguments stored in argument()
+       *  \param[in]  count      number of points in the batch
+       */
+      void execute ( double *workspace, std::size_t count ) const;
+
+      //! reserve a slot of given size in the workspace
+      Slot allocate ( unsigned int size );
+
+      //! append an instruction to the program
+      void append ( OpCode opCode, const Slot &target, const Slot &argA, const Slot &argB, unsigned int size );
+
+      //! store constant values in the program, returns their position
+      unsigned int addConstant ( const std::vector< double > &value );
+
+    private:
+      std::vector< Instruction > instructions_;
+      std::vector< double > constants_;
+      unsigned int workspaceSize_;
+      Slot argument_, result_;
     };
 
 
+    /** \brief boundary projection given by a compiled expression
+     *
+     *  Besides the projection of single points, this class provides the
+     *  projection of many points at once, which is considerably faster.
+     */
     template< int dimworld >
     class ProjectionBlock::BoundaryProjection
       : public DuneBoundaryProjection< dimworld >
     {
       typedef DuneBoundaryProjection< dimworld > Base;
 
+      // number of points evaluated in one sweep through the program
+      static const std::size_t batchSize = 64;
+
     public:
       typedef typename Base::CoordinateType CoordinateType;
 
       BoundaryProjection ( const Expression *expression )
-        : expression_( expression )
-      {}
+        : program_( *expression, dimworld ),
+          workspace_( program_.workspaceSize() * batchSize )
+      {
+        if( program_.result().size < (unsigned int)dimworld )
+          DUNE_THROW( MathError, "Projection does not return a vector of size " << dimworld << "." );
+      }
 
       virtual CoordinateType operator() ( const CoordinateType &global ) const
       {
-        std::vector< double > x( dimworld );
-        for( int i = 0; i < dimworld; ++i )
-          x[ i ] = global[ i ];
-        std::vector< double > y;
-        expression_->evaluate( x, y );
         CoordinateType result;
-        for( int i = 0; i < dimworld; ++i )
-          result[ i ] = y[ i ];
+        evaluate( &global, &result, 1 );
         return result;
       }
 
+      //! project all points of a vector
+      void operator() ( const std::vector< CoordinateType > &global, std::vector< CoordinateType > &result ) const
+      {
+        const std::size_t size = global.size();
+        result.resize( size );
+        for( std::size_t first = 0; first < size; first += batchSize )
+          evaluate( &global[ first ], &result[ first ], std::min( std::size_t( batchSize ), size - first ) );
+      }
+
     private:
-      const Expression *expression_;
+      void evaluate ( const CoordinateType *global, CoordinateType *result, std::size_t count ) const
+      {
+        double *workspace = &workspace_[ 0 ];
+
+        const unsigned int argument = program_.argument().offset;
+        for( int i = 0; i < dimworld; ++i )
+          for( std::size_t p = 0; p < count; ++p )
+            workspace[ (argument+i)*count + p ] = global[ p ][ i ];
+
+        program_.execute( workspace, count );
+
+        const unsigned int value = program_.result().offset;
+        for( int i = 0; i < dimworld; ++i )
+          for( std::size_t p = 0; p < count; ++p )
+            result[ p ][ i ] = workspace[ (value+i)*count + p ];
+      }
+
+      Program program_;
+      mutable std::vector< double > workspace_;
     };
 
   }
@@ -46,6 +46,84 @@ namespace Dune
       double tolerance_;
     };
 
+
+    // byte buffer holding the share of the macro grid of one process
+    struct MacroGridBuffer
+    {
+      // type of a face of a macro element
+      enum FaceType { interior = 0, boundary = 1, processBorder = 2 };
+
+      MacroGridBuffer () : position_( 0 ) {}
+
+      template< class T >
+      void write ( const T &value )
+      {
+        const char *bytes = reinterpret_cast< const char * >( &value );
+        data_.insert( data_.end(), bytes, bytes + sizeof( T ) );
+      }
+
+      void write ( const std::string &value )
+      {
+        write( int( value.size() ) );
+        data_.insert( data_.end(), value.begin(), value.end() );
+      }
+
+      template< class T >
+      void read ( T &value )
+      {
+        assert( position_ + sizeof( T ) <= data_.size() );
+        std::memcpy( &value, &data_[ position_ ], sizeof( T ) );
+        position_ += sizeof( T );
+      }
+
+      void read ( std::string &value )
+      {
+        int length;
+        read( length );
+        assert( position_ + length <= data_.size() );
+        value.assign( data_.begin() + position_, data_.begin() + position_ + length );
+        position_ += length;
+      }
+
+      // send buffers[ p ] from rank 0 to process p
+      template< class Communicator >
+      static void scatter ( const std::vector< MacroGridBuffer > &buffers, MacroGridBuffer &buffer,
+                            Communicator communicator )
+      {
+#if ALU3DGRID_PARALLEL
+        int rank, size;
+        MPI_Comm_rank( communicator, &rank );
+        MPI_Comm_size( communicator, &size );
+
+        std::vector< int > counts( size, 0 ), displacements( size, 0 );
+        std::vector< char > data;
+        if( rank == 0 )
+        {
+          for( int p = 0; p < size; ++p )
+          {
+            counts[ p ] = buffers[ p ].data_.size();
+            displacements[ p ] = data.size();
+            data.insert( data.end(), buffers[ p ].data_.begin(), buffers[ p ].data_.end() );
+          }
+        }
+
+        int count = 0;
+        MPI_Scatter( &counts[ 0 ], 1, MPI_INT, &count, 1, MPI_INT, 0, communicator );
+        buffer.data_.resize( count );
+        buffer.position_ = 0;
+        MPI_Scatterv( data.empty() ? 0 : &data[ 0 ], &counts[ 0 ], &displacements[ 0 ], MPI_BYTE,
+                      buffer.data_.empty() ? 0 : &buffer.data_[ 0 ], count, MPI_BYTE, 0, communicator );
+#else
+        assert( buffers.size() == 1 );
+        buffer = buffers[ 0 ];
+#endif
+      }
+
+    private:
+      std::vector< char > data_;
+      std::size_t position_;
+    };
+
   }
 
   template < class G >
@@ -69,15 +147,28 @@ namespace Dune
       return false;
 
     int rank = 0;
+    int size = 1;
 #if ALU3DGRID_PARALLEL
     MPI_Comm_rank( communicator, &rank );
+    MPI_Comm_size( communicator, &size );
 #endif
 
     dgf::GridParameterBlock parameter( file );
 
     typedef FieldVector< typename DGFGridType :: ctype, dimworld > CoordinateType ;
 
-    if( rank == 0 )
+    typedef dgf::PeriodicFaceTransformationBlock::AffineTransformation Transformation;
+    dgf::PeriodicFaceTransformationBlock trafoBlock( file, dimworld );
+
+    // if the grid factory supports it, each process inserts its own part of the macro grid
+    const bool distributed = Capabilities::hasDistributedGridFactory< DGFGridType >::v && (size > 1)
+                             && (trafoBlock.numTransformations() == 0) && parameter.dumpFileName().empty();
+
+    // if no boundary ids are given, the factory has to add the boundaries
+    bool addMissingBoundaries = true;
+    if( distributed )
+      addMissingBoundaries = insertDistributedALUGrid( eltype, file, communicator );
+    else if( rank == 0 )
     {
       if( !dgf_.readDuneGrid( file, dimworld, dimworld ) )
         DUNE_THROW( InvalidStateException, "DGF file not recognized on second call." );
@@ -137,10 +228,8 @@ namespace Dune
       }
     }
 
-    typedef dgf::PeriodicFaceTransformationBlock::AffineTransformation Transformation;
-    dgf::PeriodicFaceTransformationBlock trafoBlock( file, dimworld );
-    const int size = trafoBlock.numTransformations();
-    for( int k = 0; k < size; ++k )
+    const int numTransformations = trafoBlock.numTransformations();
+    for( int k = 0; k < numTransformations; ++k )
     {
       const Transformation &trafo = trafoBlock.transformation( k );
 
@@ -157,13 +246,241 @@ namespace Dune
     }
 
     if ( ! parameter.dumpFileName().empty() )
-      grid_ = factory_.createGrid( dgf_.facemap.empty(), false, parameter.dumpFileName() );
+      grid_ = factory_.createGrid( addMissingBoundaries && dgf_.facemap.empty(), false, parameter.dumpFileName() );
     else
-      grid_ = factory_.createGrid( dgf_.facemap.empty(), true, filename );
+      grid_ = factory_.createGrid( addMissingBoundaries && dgf_.facemap.empty(), true, filename );
     return true;
   }
 
 
+  template < class G >
+  inline bool DGFBaseFactory< G > ::
+  insertDistributedALUGrid( const ALUGridElementType eltype,
+                            std::istream &file, MPICommunicatorType communicator )
+  {
+    typedef G DGFGridType ;
+    typedef DuneGridFormatParser::facemap_t::key_type Key;
+    typedef DuneGridFormatParser::facemap_t::iterator Iterator;
+
+    const int dimworld = DGFGridType :: dimensionworld ;
+    typedef FieldVector< typename DGFGridType :: ctype, dimworld > CoordinateType ;
+
+    const int rank = this->rank( communicator );
+    const int size = this->size( communicator );
+
+    const int nCorners = (eltype == simplex) ? dimworld+1 : (1 << dimworld);
+    const int nFaces = (eltype == simplex) ? dimworld+1 : 2*dimworld;
+
+    // rank 0 parses the file and packs the share of the macro grid of each
+    // process, the other processes only receive their share
+    std::vector< dgf::MacroGridBuffer > buffers( rank == 0 ? size : 0 );
+    if( rank == 0 )
+    {
+      if( !dgf_.readDuneGrid( file, dimworld, dimworld ) )
+        DUNE_THROW( InvalidStateException, "DGF file not recognized on second call." );
+
+      if( eltype == simplex )
+      {
+        dgf_.setOrientation( 2, 3 );
+      }
+
+      // assign the elements to the processes by a geometric partition
+      std::vector< ALU3dGridPartitioner::CoordinateType > centers( dgf_.nofelements );
+      for( int n = 0; n < dgf_.nofelements; ++n )
+      {
+        const std::vector< unsigned int > &element = dgf_.elements[ n ];
+        centers[ n ] = 0;
+        for( size_t j = 0; j < element.size(); ++j )
+          for( int i = 0; i < dimworld; ++i )
+            centers[ n ][ i ] += dgf_.vtx[ element[ j ] ][ i ] / element.size();
+      }
+      std::vector< int > destination;
+      ALU3dGridSFCPartitioner().partition( centers, std::vector< double >( dgf_.nofelements, 1.0 ), size, destination );
+
+      // faces shared by elements assigned to different processes are process borders
+      std::vector< bool > processBorder( dgf_.nofelements * nFaces, false );
+      {
+        std::map< Key, int > faceOwner;
+        for( int n = 0; n < dgf_.nofelements; ++n )
+        {
+          for( int face = 0; face < nFaces; ++face )
+          {
+            const Key key = ElementFaceUtil::generateFace( dimworld, dgf_.elements[ n ], face );
+            const typename std::map< Key, int >::iterator it = faceOwner.find( key );
+            if( it == faceOwner.end() )
+              faceOwner.insert( std::make_pair( key, n*nFaces + face ) );
+            else if( destination[ it->second / nFaces ] != destination[ n ] )
+              processBorder[ it->second ] = processBorder[ n*nFaces + face ] = true;
+          }
+        }
+      }
+
+      // pack the vertices and elements of each process
+      std::vector< std::vector< int > > ownElements( size );
+      for( int n = 0; n < dgf_.nofelements; ++n )
+        ownElements[ destination[ n ] ].push_back( n );
+
+      std::vector< int > packed( dgf_.nofvtx, -1 );
+      for( int p = 0; p < size; ++p )
+      {
+        dgf::MacroGridBuffer &buffer = buffers[ p ];
+        buffer.write( dgf_.nofvtxparams );
+        buffer.write( dgf_.nofelparams );
+        buffer.write( int( dgf_.haveBndParameters ) );
+        buffer.write( int( dgf_.facemap.empty() ) );
+
+        std::vector< unsigned int > vertices;
+        for( size_t k = 0; k < ownElements[ p ].size(); ++k )
+        {
+          const std::vector< unsigned int > &element = dgf_.elements[ ownElements[ p ][ k ] ];
+          for( size_t j = 0; j < element.size(); ++j )
+          {
+            if( packed[ element[ j ] ] == p )
+              continue;
+            packed[ element[ j ] ] = p;
+            vertices.push_back( element[ j ] );
+          }
+        }
+
+        buffer.write( int( vertices.size() ) );
+        for( size_t k = 0; k < vertices.size(); ++k )
+        {
+          buffer.write( vertices[ k ] );
+          for( int i = 0; i < dimworld; ++i )
+            buffer.write( dgf_.vtx[ vertices[ k ] ][ i ] );
+          for( int i = 0; i < dgf_.nofvtxparams; ++i )
+            buffer.write( dgf_.vtxParams[ vertices[ k ] ][ i ] );
+        }
+
+        buffer.write( int( ownElements[ p ].size() ) );
+        for( size_t k = 0; k < ownElements[ p ].size(); ++k )
+        {
+          const int n = ownElements[ p ][ k ];
+          for( int j = 0; j < nCorners; ++j )
+            buffer.write( dgf_.elements[ n ][ j ] );
+          for( int i = 0; i < dgf_.nofelparams; ++i )
+            buffer.write( dgf_.elParams[ n ][ i ] );
+          for( int face = 0; face < nFaces; ++face )
+          {
+            const Iterator it = dgf_.facemap.find( ElementFaceUtil::generateFace( dimworld, dgf_.elements[ n ], face ) );
+            if( it != dgf_.facemap.end() )
+            {
+              buffer.write( int( dgf::MacroGridBuffer::boundary ) );
+              buffer.write( it->second.first );
+              buffer.write( it->second.second );
+            }
+            else
+              buffer.write( int( processBorder[ n*nFaces + face ] ? dgf::MacroGridBuffer::processBorder : dgf::MacroGridBuffer::interior ) );
+          }
+        }
+      }
+
+      // the global macro grid is not needed anymore
+      DuneGridFormatParser::facemap_t().swap( dgf_.facemap );
+      std::vector< std::vector< double > >().swap( dgf_.vtx );
+      std::vector< std::vector< unsigned int > >().swap( dgf_.elements );
+      std::vector< std::vector< double > >().swap( dgf_.vtxParams );
+      std::vector< std::vector< double > >().swap( dgf_.elParams );
+    }
+
+    dgf::MacroGridBuffer buffer;
+    dgf::MacroGridBuffer::scatter( buffers, buffer, communicator );
+
+    // insert the own share of the macro grid, using the DGF index as global vertex id
+    buffer.read( dgf_.nofvtxparams );
+    buffer.read( dgf_.nofelparams );
+    int haveBndParameters;
+    buffer.read( haveBndParameters );
+    dgf_.haveBndParameters = bool( haveBndParameters );
+    int noBoundaryIds;
+    buffer.read( noBoundaryIds );
+
+    int numVertices;
+    buffer.read( numVertices );
+    std::map< unsigned int, unsigned int > vertexIds;
+    vertexIndices_.resize( numVertices );
+    dgf_.vtxParams.resize( numVertices, std::vector< double >( dgf_.nofvtxparams ) );
+    for( int k = 0; k < numVertices; ++k )
+    {
+      buffer.read( vertexIndices_[ k ] );
+      CoordinateType pos;
+      for( int i = 0; i < dimworld; ++i )
+        buffer.read( pos[ i ] );
+      for( int i = 0; i < dgf_.nofvtxparams; ++i )
+        buffer.read( dgf_.vtxParams[ k ][ i ] );
+      vertexIds[ vertexIndices_[ k ] ] = factory_.insertVertex( pos, vertexIndices_[ k ] );
+    }
+
+    GeometryType elementType( (eltype == simplex) ?
+                              GeometryType::simplex :
+                              GeometryType::cube, dimworld );
+
+    int numElements;
+    buffer.read( numElements );
+    dgf_.elParams.resize( numElements, std::vector< double >( dgf_.nofelparams ) );
+    for( int n = 0; n < numElements; ++n )
+    {
+      std::vector< unsigned int > element( nCorners ), vertices( nCorners );
+      for( int j = 0; j < nCorners; ++j )
+      {
+        buffer.read( element[ j ] );
+        vertices[ j ] = vertexIds[ element[ j ] ];
+      }
+      for( int i = 0; i < dgf_.nofelparams; ++i )
+        buffer.read( dgf_.elParams[ n ][ i ] );
+      factory_.insertElement( elementType, vertices );
+
+      for( int face = 0; face < nFaces; ++face )
+      {
+        int type;
+        buffer.read( type );
+        if( type == dgf::MacroGridBuffer::boundary )
+        {
+          DuneGridFormatParser::BndParam bndParam;
+          buffer.read( bndParam.first );
+          buffer.read( bndParam.second );
+          dgf_.facemap[ ElementFaceUtil::generateFace( dimworld, element, face ) ] = bndParam;
+          factory_.insertBoundary( n, face, bndParam.first );
+        }
+        else if( type == dgf::MacroGridBuffer::processBorder )
+          factory_.insertProcessBorder( n, face );
+      }
+    }
+
+    dgf::ProjectionBlock projectionBlock( file, dimworld );
+    const DuneBoundaryProjection< dimworld > *projection
+      = projectionBlock.defaultProjection< dimworld >();
+
+    if( projection != 0 )
+      factory_.insertBoundaryProjection( *projection );
+
+    // insert the boundary projections of faces with local vertices
+    const size_t numBoundaryProjections = projectionBlock.numBoundaryProjections();
+    for( size_t i = 0; i < numBoundaryProjections; ++i )
+    {
+      GeometryType type( (eltype == simplex) ?
+                         GeometryType::simplex :
+                         GeometryType::cube,
+                         dimworld-1);
+
+      const std::vector< unsigned int > &face = projectionBlock.boundaryFace( i );
+      std::vector< unsigned int > vertices( face.size() );
+      bool local = true;
+      for( size_t j = 0; local && (j < face.size()); ++j )
+      {
+        const std::map< unsigned int, unsigned int >::const_iterator it = vertexIds.find( face[ j ] );
+        local = (it != vertexIds.end());
+        if( local )
+          vertices[ j ] = it->second;
+      }
+      if( local )
+        factory_.insertBoundaryProjection( type, vertices, projectionBlock.boundaryProjection< dimworld >( i ) );
+    }
+
+    return bool( noBoundaryIds );
+  }
+
+
   template < int dimw >
   inline bool DGFGridFactory< ALUSimplexGrid< 3, dimw > >
   ::generate( std::istream &file, MPICommunicatorType communicator, const std::string &filename )
@@ -6,6 +6,12 @@
 // only include if ALUGrid is used
 #if HAVE_ALUGRID
 
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <dune/grid/alugrid.hh>
 #include <dune/grid/io/file/dgfparser/dgfparser.hh>
 #include <dune/grid/io/file/dgfparser/parser.hh>
@@ -74,6 +80,21 @@ namespace Dune
   // DGFGridFactory for AluGrid
   // --------------------------
 
+  /** \brief common part of the DGFGridFactory for ALUGrid
+   *
+   *  If the grid factory accepts a distributed macro grid (see
+   *  Capabilities::hasDistributedGridFactory) and more than one process is
+   *  used, rank 0 parses the macro grid and assigns the macro elements to
+   *  the processes by a space-filling curve partition. Each process then
+   *  receives only its own elements, the vertices they need, their element
+   *  and vertex parameters and their boundary ids and parameters, and
+   *  inserts them into the grid factory. After the distribution, no process
+   *  holds the global macro grid anymore.
+   *
+   *  \note The whole file is parsed on rank 0. It cannot be split among the
+   *        processes, because DGF blocks may generate the macro grid (e.g.,
+   *        INTERVAL) and boundary segments refer to global vertex numbers.
+   */
   // template< int dim, int dimworld > // for a first version
   template < class G >
   struct DGFBaseFactory
@@ -121,7 +142,7 @@ namespace Dune
       for( int i=0; i < corners; ++i )
       {
         const int k =  refElem.subEntity( face, 1, i, dimension );
-        bound[ i ] = factory_.insertionIndex( *entity.template subEntity< dimension >( k ) );
+        bound[ i ] = vertexIndex( factory_.insertionIndex( *entity.template subEntity< dimension >( k ) ) );
       }
 
       DuneGridFormatParser::facemap_t::key_type key( bound, false );
@@ -148,7 +169,7 @@ namespace Dune
       for( int i=0; i < corners; ++i )
       {
         const int k =  refElem.subEntity( face, 1, i, dimension );
-        bound[ i ] = factory_.insertionIndex( *entity.template subEntity< dimension >( k ) );
+        bound[ i ] = vertexIndex( factory_.insertionIndex( *entity.template subEntity< dimension >( k ) ) );
       }
 
       DuneGridFormatParser::facemap_t::key_type key( bound, false );
@@ -202,6 +223,17 @@ namespace Dune
                           MPICommunicatorType communicator,
                           const std::string &filename );
 
+    // returns true if the DGF file specifies no boundary ids at all
+    bool insertDistributedALUGrid( const ALUGridElementType eltype,
+                                   std::istream &file,
+                                   MPICommunicatorType communicator );
+
+    // DGF index of a vertex given its insertion index
+    unsigned int vertexIndex ( unsigned int insertionIndex ) const
+    {
+      return (vertexIndices_.empty() ? insertionIndex : vertexIndices_[ insertionIndex ]);
+    }
+
     bool generateALU2dGrid( const ALUGridElementType eltype,
                             std::istream &file,
                             MPICommunicatorType communicator,
@@ -266,6 +298,8 @@ namespace Dune
     Grid *grid_;
     GridFactory factory_;
     DuneGridFormatParser dgf_;
+    // DGF index of each inserted vertex (only if the macro grid is distributed)
+    std::vector< unsigned int > vertexIndices_;
   };
 
   // note: template parameter dimw is only added to avoid ALUSimplexGrid deprecation warning
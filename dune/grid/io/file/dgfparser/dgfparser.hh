@@ -385,6 +385,9 @@ namespace Dune {
        Dune::GridPtr<GridType>::parameters(const Entity& en)
        method. Depending on the codimentsion of \c en the method returns either
        the element or vertex parameters of that entity in the DGF file.
+       The parameters are returned as a Dune::GridPtr<GridType>::EntityParameters,
+       a light weight view into the contiguous parameter storage, which can be
+       converted into a std::vector<double>.
        The number of parameters for a given
        codimension can be retrived using the method
        Dune::GridPtr<GridType>::nofParameters.
@@ -3,11 +3,14 @@
 #ifndef DUNE_DGF_GRIDPTR_HH
 #define DUNE_DGF_GRIDPTR_HH
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 //#include <memory>
-#include <map>
 #include <assert.h>
 
 //- Dune includes
@@ -111,6 +114,47 @@ namespace Dune
     typedef MPIHelper::MPICommunicator MPICommunicatorType;
     static const int dimension = GridType::dimension;
 
+    /** \brief read-only view of the parameters of an entity
+     *
+     *  The parameters of all elements (vertices) are stored contiguously
+     *  with a fixed number of parameters per entity. For compatibility, the
+     *  view can be converted into a std::vector< double >.
+     */
+    class EntityParameters
+    {
+    public:
+      typedef const double *const_iterator;
+
+      EntityParameters () : begin_( 0 ), size_( 0 ) {}
+
+      EntityParameters ( const double *begin, std::size_t size )
+        : begin_( begin ), size_( size )
+      {}
+
+      //! number of parameters
+      std::size_t size () const { return size_; }
+
+      //! are there any parameters?
+      bool empty () const { return (size_ == 0); }
+
+      //! access the i-th parameter
+      const double &operator[] ( std::size_t i ) const
+      {
+        assert( i < size_ );
+        return begin_[ i ];
+      }
+
+      const_iterator begin () const { return begin_; }
+      const_iterator end () const { return begin_ + size_; }
+
+      //! copy the parameters into a std::vector
+      operator std::vector< double > () const { return std::vector< double >( begin(), end() ); }
+
+    private:
+      const double *begin_;
+      std::size_t size_;
+    };
+
     //! constructor given the name of a DGF file
     explicit GridPtr ( const std::string &filename,
                        MPICommunicatorType comm = MPIHelper::getCommunicator() )
@@ -119,7 +163,6 @@ namespace Dune
         vtxParam_(),
         bndParam_(),
         bndId_(),
-        emptyParam_(),
         nofElParam_( 0 ),
         nofVtxParam_( 0 ),
         haveBndParam_( false )
@@ -136,7 +179,6 @@ namespace Dune
         vtxParam_(),
         bndParam_(),
         bndId_(),
-        emptyParam_(),
         nofElParam_( 0 ),
         nofVtxParam_( 0 ),
         haveBndParam_( false )
@@ -152,7 +194,6 @@ namespace Dune
         vtxParam_(),
         bndParam_(),
         bndId_(),
-        emptyParam_(),
         nofElParam_(0),
         nofVtxParam_(0),
         haveBndParam_( false )
@@ -165,7 +206,6 @@ namespace Dune
         vtxParam_(),
         bndParam_(),
         bndId_(),
-        emptyParam_(),
         nofElParam_(0),
         nofVtxParam_(0),
         haveBndParam_( false )
@@ -178,7 +218,6 @@ namespace Dune
         vtxParam_(org.vtxParam_),
         bndParam_(org.bndParam_),
         bndId_(org.bndId_),
-        emptyParam_( org.emptyParam_ ),
         nofElParam_(org.nofElParam_),
         nofVtxParam_(org.nofVtxParam_),
         haveBndParam_(org.haveBndParam_)
@@ -192,7 +231,6 @@ namespace Dune
       vtxParam_   = org.vtxParam_;
       bndParam_   = org.bndParam_;
       bndId_      = org.bndId_;
-      emptyParam_ = org.emptyParam_;
 
       nofElParam_ = org.nofElParam_;
       nofVtxParam_ = org.nofVtxParam_;
@@ -208,7 +246,6 @@ namespace Dune
       vtxParam_.resize(0);
       bndParam_.resize(0);
       bndId_.resize(0);
-      emptyParam_.resize(0);
 
       nofVtxParam_ = 0;
       nofElParam_ = 0;
@@ -264,28 +301,29 @@ namespace Dune
 
     //! get parameters defined for each codim 0 und dim entity on the grid through the grid file
     template <class Entity>
-    const std::vector< double > &parameters ( const Entity &entity ) const
+    EntityParameters parameters ( const Entity &entity ) const
     {
       typedef typename GridType::LevelGridView GridView;
       GridView gridView = gridPtr_->levelGridView( 0 );
+      const std::size_t index = gridView.indexSet().index( entity );
       switch( (int)Entity::codimension )
       {
       case 0 :
         if( nofElParam_ > 0 )
         {
-          assert( (unsigned int)gridView.indexSet().index( entity ) < elParam_.size() );
-          return elParam_[ gridView.indexSet().index( entity ) ];
+          assert( (index+1) * nofElParam_ <= elParam_.size() );
+          return EntityParameters( &elParam_[ index * nofElParam_ ], nofElParam_ );
         }
         break;
       case GridType::dimension :
         if( nofVtxParam_ > 0 )
         {
-          assert( (unsigned int)gridView.indexSet().index( entity ) < vtxParam_.size() );
-          return vtxParam_[ gridView.indexSet().index( entity ) ];
+          assert( (index+1) * nofVtxParam_ <= vtxParam_.size() );
+          return EntityParameters( &vtxParam_[ index * nofVtxParam_ ], nofVtxParam_ );
         }
         break;
       }
-      return emptyParam_;
+      return EntityParameters();
     }
 
     //! get parameters for intersection
@@ -303,11 +341,20 @@ namespace Dune
     {
       if ( gridPtr_->comm().size() == 1 )
         return;
+      // the parameters are communicated with a fixed size, so all processes
+      // need to agree on the number of parameters
+      nofElParam_ = gridPtr_->comm().max( nofElParam_ );
+      nofVtxParam_ = gridPtr_->comm().max( nofVtxParam_ );
       int params = nofElParam_ + nofVtxParam_;
       if ( haveBndParam_ )
         params += 1;
       if ( gridPtr_->comm().max( params ) > 0 )
       {
+        typedef typename GridType::LevelGridView GridView;
+        GridView gridView = gridPtr_->levelGridView( 0 );
+        elParam_.resize( gridView.indexSet().size( 0 ) * nofElParam_ );
+        vtxParam_.resize( gridView.indexSet().size( dimension ) * nofVtxParam_ );
+
         DataHandle dh(*this);
         gridPtr_->loadBalance( dh.interface() );
         gridPtr_->communicate( dh.interface(), InteriorBorder_All_Interface,ForwardCommunication);
@@ -330,10 +377,9 @@ namespace Dune
       nofVtxParam_ = dgfFactory.template numParameters< dimension >();
       haveBndParam_ = dgfFactory.haveBoundaryParameters();
 
-      if ( nofElParam_ > 0 )
-        elParam_.resize( indexSet.size(0) );
-      if ( nofVtxParam_ > 0 )
-        vtxParam_.resize( indexSet.size(dimension) );
+      elParam_.resize( indexSet.size(0) * nofElParam_ );
+      vtxParam_.resize( indexSet.size(dimension) * nofVtxParam_ );
+      std::vector< bool > vtxVisited( nofVtxParam_ > 0 ? indexSet.size(dimension) : 0, false );
       bndId_.resize( indexSet.size(1) );
       if ( haveBndParam_ )
         bndParam_.resize( gridPtr_->numBoundarySegments() );
@@ -345,17 +391,22 @@ namespace Dune
       {
         const typename Iterator::Entity &el = *iter;
         if ( nofElParam_ > 0 ) {
-          std::swap( elParam_[ indexSet.index(el) ], dgfFactory.parameter(el) );
-          assert( elParam_[ indexSet.index(el) ].size()  == (size_t)nofElParam_ );
+          const std::vector< double > &param = dgfFactory.parameter(el);
+          assert( param.size()  == (size_t)nofElParam_ );
+          std::copy( param.begin(), param.end(), elParam_.begin() + indexSet.index(el) * nofElParam_ );
         }
         if ( nofVtxParam_ > 0 )
         {
           for ( int v = 0; v < el.template count<dimension>(); ++v)
           {
             typename GridView::IndexSet::IndexType index = indexSet.subIndex(el,v,dimension);
-            if ( vtxParam_[ index ].empty() )
-              std::swap( vtxParam_[ index ], dgfFactory.parameter(*el.template subEntity<dimension>(v) ) );
-            assert( vtxParam_[ index ].size()  == (size_t)nofVtxParam_ );
+            if ( !vtxVisited[ index ] )
+            {
+              const std::vector< double > &param = dgfFactory.parameter(*el.template subEntity<dimension>(v) );
+              assert( param.size()  == (size_t)nofVtxParam_ );
+              std::copy( param.begin(), param.end(), vtxParam_.begin() + index * nofVtxParam_ );
+              vtxVisited[ index ] = true;
+            }
           }
         }
         if ( el.hasBoundaryIntersections() )
@@ -379,28 +430,29 @@ namespace Dune
     }
 
     template <class Entity>
-    std::vector< double > &params ( const Entity &entity )
+    double *params ( const Entity &entity )
     {
       typedef typename GridType::LevelGridView GridView;
       GridView gridView = gridPtr_->levelGridView( 0 );
+      const std::size_t index = gridView.indexSet().index( entity );
       switch( (int)Entity::codimension )
       {
       case 0 :
         if( nofElParam_ > 0 ) {
-          if ( gridView.indexSet().index( entity ) >= elParam_.size() )
-            elParam_.resize( gridView.indexSet().index( entity ) );
-          return elParam_[ gridView.indexSet().index( entity ) ];
+          if ( (index+1) * nofElParam_ > elParam_.size() )
+            elParam_.resize( (index+1) * nofElParam_ );
+          return &elParam_[ index * nofElParam_ ];
         }
         break;
       case GridType::dimension :
         if( nofVtxParam_ > 0 ) {
-          if ( gridView.indexSet().index( entity ) >= vtxParam_.size() )
-            vtxParam_.resize( gridView.indexSet().index( entity ) );
-          return vtxParam_[ gridView.indexSet().index( entity ) ];
+          if ( (index+1) * nofVtxParam_ > vtxParam_.size() )
+            vtxParam_.resize( (index+1) * nofVtxParam_ );
+          return &vtxParam_[ index * nofVtxParam_ ];
         }
         break;
       }
-      return emptyParam_;
+      return 0;
     }
 
     void setNofParams( int cdim, int nofP )
@@ -415,30 +467,43 @@ namespace Dune
     {
       DataHandle( GridPtr& gridPtr) :
         gridPtr_(gridPtr),
-        idSet_(gridPtr->localIdSet())
+        idSet_(gridPtr->localIdSet()),
+        elData_( gridPtr.nofElParam_ ),
+        vtxData_( gridPtr.nofVtxParam_ )
       {
         typedef typename GridType::LevelGridView GridView;
         GridView gridView = gridPtr_->levelGridView( 0 );
         const typename GridView::IndexSet &indexSet = gridView.indexSet();
 
+        const int nofElParam = gridPtr_.nofElParam_;
+        const int nofVtxParam = gridPtr_.nofVtxParam_;
+        std::vector< bool > vtxVisited( nofVtxParam > 0 ? indexSet.size(dimension) : 0, false );
+
         const PartitionIteratorType partType = Interior_Partition;
         typedef typename GridView::template Codim< 0 >::template Partition< partType >::Iterator Iterator;
         const Iterator enditer = gridView.template end< 0, partType >();
         for( Iterator iter = gridView.template begin< 0, partType >(); iter != enditer; ++iter )
         {
           const typename Iterator::Entity &el = *iter;
-          if ( gridPtr_.nofElParam_ > 0 )
-            std::swap( gridPtr_.elParam_[ indexSet.index(el) ], elData_[ idSet_.id(el) ] );
-          if ( gridPtr_.nofVtxParam_ > 0 )
+          if ( nofElParam > 0 )
+            elData_.insert( idSet_.id(el), &gridPtr_.elParam_[ indexSet.index(el) * nofElParam ] );
+          if ( nofVtxParam > 0 )
           {
             for ( int v = 0; v < el.template count<dimension>(); ++v)
             {
               typename GridView::IndexSet::IndexType index = indexSet.subIndex(el,v,dimension);
-              if ( ! gridPtr_.vtxParam_[ index ].empty() )
-                std::swap( gridPtr_.vtxParam_[ index ], vtxData_[ idSet_.subId(el,v,dimension) ] );
+              if ( !vtxVisited[ index ] )
+              {
+                vtxData_.insert( idSet_.subId(el,v,dimension), &gridPtr_.vtxParam_[ index * nofVtxParam ] );
+                vtxVisited[ index ] = true;
+              }
             }
           }
         }
+
+        // release the memory, the parameters are restored in the destructor
+        std::vector< double >().swap( gridPtr_.elParam_ );
+        std::vector< double >().swap( gridPtr_.vtxParam_ );
       }
 
       ~DataHandle()
@@ -447,10 +512,10 @@ namespace Dune
         GridView gridView = gridPtr_->levelGridView( 0 );
         const typename GridView::IndexSet &indexSet = gridView.indexSet();
 
-        if ( gridPtr_.nofElParam_ > 0 )
-          gridPtr_.elParam_.resize( indexSet.size(0) );
-        if ( gridPtr_.nofVtxParam_ > 0 )
-          gridPtr_.vtxParam_.resize( indexSet.size(dimension) );
+        const int nofElParam = gridPtr_.nofElParam_;
+        const int nofVtxParam = gridPtr_.nofVtxParam_;
+        gridPtr_.elParam_.resize( indexSet.size(0) * nofElParam );
+        gridPtr_.vtxParam_.resize( indexSet.size(dimension) * nofVtxParam );
 
         const PartitionIteratorType partType = All_Partition;
         typedef typename GridView::template Codim< 0 >::template Partition< partType >::Iterator Iterator;
@@ -458,19 +523,20 @@ namespace Dune
         for( Iterator iter = gridView.template begin< 0, partType >(); iter != enditer; ++iter )
         {
           const typename Iterator::Entity &el = *iter;
-          if ( gridPtr_.nofElParam_ > 0 )
+          if ( nofElParam > 0 )
           {
-            std::swap( gridPtr_.elParam_[ indexSet.index(el) ], elData_[ idSet_.id(el) ] );
-            assert( gridPtr_.elParam_[ indexSet.index(el) ].size() == (unsigned int)gridPtr_.nofElParam_ );
+            const double *param = elData_.find( idSet_.id(el) );
+            assert( param );
+            std::copy( param, param + nofElParam, gridPtr_.elParam_.begin() + indexSet.index(el) * nofElParam );
           }
-          if ( gridPtr_.nofVtxParam_ > 0 )
+          if ( nofVtxParam > 0 )
           {
             for ( int v = 0; v < el.template count<dimension>(); ++v)
             {
               typename GridView::IndexSet::IndexType index = indexSet.subIndex(el,v,dimension);
-              if ( gridPtr_.vtxParam_[ index ].empty() )
-                std::swap( gridPtr_.vtxParam_[ index ], vtxData_[ idSet_.subId(el,v,dimension) ] );
-              assert( gridPtr_.vtxParam_[ index ].size() == (unsigned int)gridPtr_.nofVtxParam_ );
+              const double *param = vtxData_.find( idSet_.subId(el,v,dimension) );
+              assert( param );
+              std::copy( param, param + nofVtxParam, gridPtr_.vtxParam_.begin() + index * nofVtxParam );
             }
           }
         }
@@ -488,7 +554,7 @@ namespace Dune
 
       bool fixedsize (int dim, int codim) const
       {
-        return false;
+        return true;
       }
 
       template<class EntityType>
@@ -500,38 +566,86 @@ namespace Dune
       template<class MessageBufferImp, class EntityType>
       void gather (MessageBufferImp& buff, const EntityType& e) const
       {
-        const std::vector<double> &v = (e.codimension==0) ? elData_[idSet_.id(e)] : vtxData_[idSet_.id(e)];
-        const size_t s = v.size();
+        const ParameterStore &data = (e.codimension==0) ? elData_ : vtxData_;
+        const size_t s = data.stride();
+        if ( s == 0 )
+          return;
+        const double *v = data.find( idSet_.id(e) );
+        if( !v )
+          DUNE_THROW( DGFException, "GridPtr: no parameters stored for an entity of codimension " << e.codimension );
         for (size_t i=0; i<s; ++i)
           buff.write( v[i] );
-        assert( s == (size_t)gridPtr_.nofParameters(e.codimension) );
       }
 
       template<class MessageBufferImp, class EntityType>
       void scatter (MessageBufferImp& buff, const EntityType& e, size_t n)
       {
-        std::vector<double> &v = (e.codimension==0) ? elData_[idSet_.id(e)] : vtxData_[idSet_.id(e)];
-        v.resize( n );
-        gridPtr_.setNofParams( e.codimension, n );
+        ParameterStore &data = (e.codimension==0) ? elData_ : vtxData_;
+        assert( n == data.stride() );
+        if ( n == 0 )
+          return;
+        double *v = data.insert( idSet_.id(e) );
         for (size_t i=0; i<n; ++i)
           buff.read( v[i] );
       }
 
     private:
       typedef typename GridType::LocalIdSet IdSet;
+      typedef typename IdSet::IdType IdType;
+
+      // parameters of a fixed number per entity, stored contiguously and found by id
+      class ParameterStore
+      {
+        typedef std::map< IdType, std::size_t > Offsets;
+
+      public:
+        explicit ParameterStore ( int stride )
+          : stride_( stride )
+        {}
+
+        std::size_t stride () const { return stride_; }
+
+        // returns the storage for the parameters of an entity, which is
+        // appended unless the entity is already present
+        double *insert ( const IdType &id )
+        {
+          const std::pair< typename Offsets::iterator, bool > result
+            = offsets_.insert( std::make_pair( id, data_.size() ) );
+          if( result.second )
+            data_.resize( data_.size() + stride_ );
+          return &data_[ result.first->second ];
+        }
+
+        void insert ( const IdType &id, const double *values )
+        {
+          std::copy( values, values + stride_, insert( id ) );
+        }
+
+        // find the parameters of an entity (0, if not present)
+        const double *find ( const IdType &id ) const
+        {
+          const typename Offsets::const_iterator it = offsets_.find( id );
+          return (it != offsets_.end() ? &data_[ it->second ] : 0);
+        }
+
+      private:
+        std::size_t stride_;
+        std::vector< double > data_;
+        Offsets offsets_;
+      };
+
       GridPtr &gridPtr_;
       const IdSet &idSet_;
-      mutable std::map< typename IdSet::IdType, std::vector<double> > elData_, vtxData_;
+      ParameterStore elData_, vtxData_;
     };
 
     // grid auto pointer
     mutable mygrid_ptr gridPtr_;
-    // element and vertex parameters
-    std::vector< std::vector< double > > elParam_;
-    std::vector< std::vector< double > > vtxParam_;
+    // element and vertex parameters (nofElParam_ and nofVtxParam_ per entity, stored contiguously)
+    std::vector< double > elParam_;
+    std::vector< double > vtxParam_;
     std::vector< DGFBoundaryParameter::type > bndParam_;
     std::vector< int > bndId_;
-    std::vector < double > emptyParam_;
 
     int nofElParam_;
     int nofVtxParam_;
@@ -0,0 +1,128 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief compare the macro grid of an ALU3dGrid read from a DGF file on
+ *         all processes with the one read by each process on its own
+ *
+ *  On more than one process, rank 0 parses the DGF file and sends each
+ *  process its share of the macro grid. The distributed grid has to consist
+ *  of the same elements with the same boundary ids as the serial one.
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#include <dune/grid/io/file/dgfparser/dgfalu.hh>
+#include <dune/grid/io/file/dgfparser/gridptr.hh>
+
+// number and volume of the interior macro elements and the number of
+// boundary intersections for each boundary id, summed over all processes
+struct MacroGridSummary
+{
+  int elements;
+  double volume;
+  std::vector< int > boundaryIds;
+};
+
+template< class Grid >
+MacroGridSummary summarize ( const Grid &grid )
+{
+  typedef typename Grid::LevelGridView MacroView;
+  typedef typename MacroView::template Codim< 0 >::template Partition< Dune::Interior_Partition >::Iterator Iterator;
+  typedef typename MacroView::IntersectionIterator IntersectionIterator;
+
+  MacroGridSummary summary;
+  summary.elements = 0;
+  summary.volume = 0.0;
+
+  std::vector< int > boundaryIds;
+  const MacroView macroView = grid.levelGridView( 0 );
+  const Iterator end = macroView.template end< 0, Dune::Interior_Partition >();
+  for( Iterator it = macroView.template begin< 0, Dune::Interior_Partition >(); it != end; ++it )
+  {
+    ++summary.elements;
+    summary.volume += it->geometry().volume();
+
+    const IntersectionIterator iend = macroView.iend( *it );
+    for( IntersectionIterator iit = macroView.ibegin( *it ); iit != iend; ++iit )
+    {
+      if( !iit->boundary() )
+        continue;
+      const int id = iit->boundaryId();
+      if( id < 0 )
+        DUNE_THROW( Dune::GridError, "negative boundary id " << id );
+      if( std::size_t( id ) >= boundaryIds.size() )
+        boundaryIds.resize( id+1, 0 );
+      ++boundaryIds[ id ];
+    }
+  }
+
+  summary.elements = grid.comm().sum( summary.elements );
+  summary.volume = grid.comm().sum( summary.volume );
+
+  summary.boundaryIds.resize( grid.comm().max( int( boundaryIds.size() ) ), 0 );
+  std::copy( boundaryIds.begin(), boundaryIds.end(), summary.boundaryIds.begin() );
+  if( !summary.boundaryIds.empty() )
+    grid.comm().sum( &summary.boundaryIds[ 0 ], summary.boundaryIds.size() );
+  return summary;
+}
+
+template< class Grid >
+void checkDistributedRead ( const std::string &name, const std::string &filename )
+{
+  std::cout << "Comparing the distributed and serial macro grids of " << name
+            << " read from " << filename << std::endl;
+
+  Dune::GridPtr< Grid > distributedGrid( filename, Dune::MPIHelper::getCommunicator() );
+  Dune::GridPtr< Grid > serialGrid( filename, Dune::MPIHelper::getLocalCommunicator() );
+
+  const MacroGridSummary distributed = summarize( *distributedGrid );
+  const MacroGridSummary serial = summarize( *serialGrid );
+
+  if( distributed.elements != serial.elements )
+    DUNE_THROW( Dune::GridError, name << ": distributed macro grid has " << distributed.elements
+                                      << " elements instead of " << serial.elements );
+  if( std::abs( distributed.volume - serial.volume ) > 1e-8 * serial.volume )
+    DUNE_THROW( Dune::GridError, name << ": distributed macro grid has volume " << distributed.volume
+                                      << " instead of " << serial.volume );
+  if( distributed.boundaryIds != serial.boundaryIds )
+    DUNE_THROW( Dune::GridError, name << ": distributed macro grid has different boundary ids" );
+}
+#endif // #if HAVE_ALUGRID
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+#if HAVE_ALUGRID
+  const std::string filename( DUNE_GRID_EXAMPLE_GRIDS_PATH "dgf/simplex-testgrid-3-3.dgf" );
+  checkDistributedRead< Dune::ALUGrid< 3, 3, Dune::simplex, Dune::nonconforming > >( "ALUGrid< 3, 3, simplex, nonconforming >", filename );
+  checkDistributedRead< Dune::ALUGrid< 3, 3, Dune::cube, Dune::nonconforming > >( "ALUGrid< 3, 3, cube, nonconforming >", filename );
+  return 0;
+#else
+  std::cerr << "ALUGrid not available, test skipped." << std::endl;
+  return 77;
+#endif
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch( ... )
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
@@ -0,0 +1,198 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief Read a partitioned Gmsh file in parallel with the CurvilinearGmshReader
+ */
+
+#include <config.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#endif
+#include <dune/grid/io/file/curvilineargmshreader.hh>
+
+// The unit cube in cube-2partitions.msh consists of 2x2x2 cubes of 6
+// tetrahedra each. Gmsh partition 1 holds the tetrahedra with x < 0.5,
+// partition 2 those with x > 0.5. cube-2partitions-boundarytags.msh is the
+// same mesh with each boundary triangle tagged for the other partition.
+const int numElements = 48;
+const int numVertices = 27;
+const int numBoundaryFaces = 48;
+const int numInterfaceFaces = 8;
+
+template< class Grid >
+bool checkGrid ( const Grid &grid, bool partitioned )
+{
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::template Partition< Dune::Interior_Partition >::Iterator ElementIterator;
+  typedef typename GridView::template Codim< Grid::dimension >::Iterator VertexIterator;
+  typedef typename GridView::IntersectionIterator IntersectionIterator;
+
+  const GridView gridView = grid.leafGridView();
+  const int rank = grid.comm().rank();
+  const int size = grid.comm().size();
+
+  bool passed = true;
+
+  // count the elements, boundary faces and faces at the process borders
+  int elements = 0, boundaryFaces = 0, interfaceFaces = 0;
+  double volume = 0;
+  const ElementIterator end = gridView.template end< 0, Dune::Interior_Partition >();
+  for( ElementIterator it = gridView.template begin< 0, Dune::Interior_Partition >(); it != end; ++it )
+  {
+    ++elements;
+    volume += it->geometry().volume();
+
+    // without load balancing, the elements are where the partition tags put them
+    const double x = it->geometry().center()[ 0 ];
+    if( partitioned && (size == 2) && ((x < 0.5) != (rank == 0)) )
+    {
+      std::cerr << "Error: Element with center " << it->geometry().center() << " on rank " << rank << "." << std::endl;
+      passed = false;
+    }
+
+    const IntersectionIterator iend = gridView.iend( *it );
+    for( IntersectionIterator iit = gridView.ibegin( *it ); iit != iend; ++iit )
+    {
+      if( iit->boundary() )
+        ++boundaryFaces;
+      else if( !iit->neighbor() || (iit->outside()->partitionType() != Dune::InteriorEntity) )
+      {
+        ++interfaceFaces;
+        if( partitioned && (std::abs( iit->geometry().center()[ 0 ] - 0.5 ) > 1e-8) )
+        {
+          std::cerr << "Error: Process border at " << iit->geometry().center() << " on rank " << rank << "." << std::endl;
+          passed = false;
+        }
+      }
+    }
+  }
+
+  // vertices on the process border are border vertices on both sides
+  int interiorVertices = 0, borderVertices = 0;
+  const VertexIterator vend = gridView.template end< Grid::dimension >();
+  for( VertexIterator it = gridView.template begin< Grid::dimension >(); it != vend; ++it )
+  {
+    if( it->partitionType() == Dune::InteriorEntity )
+      ++interiorVertices;
+    else if( it->partitionType() == Dune::BorderEntity )
+      ++borderVertices;
+  }
+
+  elements = grid.comm().sum( elements );
+  boundaryFaces = grid.comm().sum( boundaryFaces );
+  interfaceFaces = grid.comm().sum( interfaceFaces );
+  volume = grid.comm().sum( volume );
+  interiorVertices = grid.comm().sum( interiorVertices );
+  borderVertices = grid.comm().sum( borderVertices );
+
+  if( elements != numElements )
+  {
+    std::cerr << "Error: Grid has " << elements << " elements instead of " << numElements << "." << std::endl;
+    passed = false;
+  }
+  if( std::abs( volume - 1.0 ) > 1e-8 )
+  {
+    std::cerr << "Error: Grid has volume " << volume << " instead of 1." << std::endl;
+    passed = false;
+  }
+  if( boundaryFaces != numBoundaryFaces )
+  {
+    std::cerr << "Error: Grid has " << boundaryFaces << " boundary faces instead of " << numBoundaryFaces << "." << std::endl;
+    passed = false;
+  }
+
+  // only for two processes the interface is known
+  if( partitioned && (size <= 2) )
+  {
+    const int expected = (size == 2 ? 2*numInterfaceFaces : 0);
+    if( interfaceFaces != expected )
+    {
+      std::cerr << "Error: Grid has " << interfaceFaces << " faces at process borders instead of " << expected << "." << std::endl;
+      passed = false;
+    }
+    if( interiorVertices + borderVertices / size != numVertices )
+    {
+      std::cerr << "Error: Grid has " << (interiorVertices + borderVertices / size) << " vertices instead of " << numVertices << "." << std::endl;
+      passed = false;
+    }
+  }
+
+  return passed;
+}
+
+template< class Grid >
+bool readPartitioned ( const std::string &fileName, bool partitioned )
+{
+  Dune::GridFactory< Grid > factory;
+  std::vector< int > boundaryIds, elementIds;
+  const Dune::CollectiveCommunication< Dune::MPIHelper::MPICommunicator > comm( Dune::MPIHelper::getCommunicator() );
+  Dune::CurvilinearGmshReader< Grid >::read( factory, fileName, comm, boundaryIds, elementIds, false, true );
+
+  bool passed = true;
+  for( std::size_t i = 0; i < elementIds.size(); ++i )
+    passed &= (elementIds[ i ] == 2);
+  for( std::size_t i = 0; i < boundaryIds.size(); ++i )
+    passed &= (boundaryIds[ i ] == 1);
+  if( !passed )
+    std::cerr << "Error: Wrong physical entities." << std::endl;
+
+  Dune::shared_ptr< Grid > grid( factory.createGrid() );
+  if( !partitioned )
+    grid->loadBalance();
+  return checkGrid( *grid, partitioned ) && passed;
+}
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  const std::string fileNames[ 2 ] = { std::string( DUNE_GRID_EXAMPLE_GRIDS_PATH ) + "gmsh/cube-2partitions.msh",
+                                       std::string( DUNE_GRID_EXAMPLE_GRIDS_PATH ) + "gmsh/cube-2partitions-boundarytags.msh" };
+
+  bool passed = true;
+  bool tested = false;
+
+  for( int i = 0; i < 2; ++i )
+  {
+#if HAVE_ALUGRID
+    // ALUGrid accepts the distributed coarse grid directly
+    {
+      typedef Dune::ALUGrid< 3, 3, Dune::simplex, Dune::nonconforming > Grid;
+      passed &= readPartitioned< Grid >( fileNames[ i ], Dune::Capabilities::hasDistributedGridFactory< Grid >::v );
+      tested = true;
+    }
+#endif
+
+#if HAVE_UG
+    // UGGrid reads the mesh on rank 0 and distributes it by load balancing
+    {
+      typedef Dune::UGGrid< 3 > Grid;
+      passed &= readPartitioned< Grid >( fileNames[ i ], Dune::Capabilities::hasDistributedGridFactory< Grid >::v );
+      tested = true;
+    }
+#endif
+  }
+
+  if( !tested )
+    return 77;
+  return (passed ? 0 : 1);
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
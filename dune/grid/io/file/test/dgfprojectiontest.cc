@@ -0,0 +1,110 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief Compare the compiled DGF boundary projections with the expression trees
+ */
+
+#include <config.h>
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/grid/io/file/dgfparser/blocks/projection.hh>
+
+template< int dimworld >
+bool checkProjection ( const Dune::dgf::ProjectionBlock &block, const std::string &name )
+{
+  typedef Dune::dgf::ProjectionBlock::BoundaryProjection< dimworld > Projection;
+  typedef typename Projection::CoordinateType Coordinate;
+
+  const Dune::dgf::ProjectionBlock::Expression *expression = block.function( name );
+  if( !expression )
+    DUNE_THROW( Dune::Exception, "Function " << name << " not found." );
+  const Projection projection( expression );
+
+  // some points, more than fit into one batch
+  std::vector< Coordinate > points;
+  for( int k = 0; k < 150; ++k )
+  {
+    Coordinate x;
+    for( int i = 0; i < dimworld; ++i )
+      x[ i ] = std::cos( 0.37*k + i ) * (1.0 + 0.01*k);
+    points.push_back( x );
+  }
+
+  std::vector< Coordinate > batch;
+  projection( points, batch );
+
+  bool passed = (batch.size() == points.size());
+  for( std::size_t k = 0; passed && (k < points.size()); ++k )
+  {
+    std::vector< double > argument( points[ k ].begin(), points[ k ].end() ), value;
+    expression->evaluate( argument, value );
+
+    const Coordinate y = projection( points[ k ] );
+    for( int i = 0; i < dimworld; ++i )
+    {
+      if( std::abs( y[ i ] - value[ i ] ) > 1e-12 * (1.0 + std::abs( value[ i ] )) )
+      {
+        std::cerr << "Error: " << name << "( " << points[ k ] << " ) = " << y
+                  << ", but the expression evaluates to " << value[ i ] << " in component " << i << "." << std::endl;
+        passed = false;
+      }
+      if( std::abs( batch[ k ][ i ] - y[ i ] ) > 1e-14 * (1.0 + std::abs( y[ i ] )) )
+      {
+        std::cerr << "Error: Batched evaluation of " << name << "( " << points[ k ] << " ) yields " << batch[ k ]
+                  << " instead of " << y << "." << std::endl;
+        passed = false;
+      }
+    }
+  }
+  return passed;
+}
+
+int main ( int argc, char **argv )
+try
+{
+  std::istringstream input( "PROJECTION\n"
+                            "function p(x) = sqrt(2) * x / |x|\n"
+                            "function id(x) = x\n"
+                            "function swap(x) = [ x[1], -x[0] ]\n"
+                            "function wave(x) = [ x[0], x[1] + 0.1*sin(2*pi*x[0]) * cos(x[1])**2 ]\n"
+                            "function twice(x) = id(2*x) - swap(swap(x)) / 2\n"
+                            "function sphere(x) = x / |x|\n"
+                            "function scaled(x) = x * (|x| + [1, 2, 3] * [x[0], x[1], x[2]])\n"
+                            "#\n" );
+  Dune::dgf::ProjectionBlock block( input, 2 );
+
+  bool passed = true;
+  passed &= checkProjection< 2 >( block, "p" );
+  passed &= checkProjection< 2 >( block, "id" );
+  passed &= checkProjection< 2 >( block, "swap" );
+  passed &= checkProjection< 2 >( block, "wave" );
+  passed &= checkProjection< 2 >( block, "twice" );
+  passed &= checkProjection< 3 >( block, "sphere" );
+  passed &= checkProjection< 3 >( block, "scaled" );
+
+  // size errors are detected when the projection is compiled
+  try
+  {
+    checkProjection< 3 >( block, "swap" );
+    std::cerr << "Error: Projection to a vector of wrong size not detected." << std::endl;
+    passed = false;
+  }
+  catch( const Dune::MathError & )
+  {}
+
+  return (passed ? 0 : 1);
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
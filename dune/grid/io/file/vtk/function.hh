@@ -5,6 +5,7 @@
 #define DUNE_GRID_IO_FILE_VTK_FUNCTION_HH
 
 #include <string>
+#include <vector>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/fvector.hh>
@@ -56,6 +57,27 @@ namespace Dune
     virtual double evaluate (int comp, const Entity& e,
                              const Dune::FieldVector<ctype,dim>& xi) const = 0;
 
+    //! evaluate all components in the entity e at several local coordinates
+    /*! Writers that sample a function at many points of each entity use this
+       method, so it may be overridden to share work between the points.
+       The default implementation calls evaluate() for each component and
+       point.
+       @param[in]  e       reference to grid entity of codimension 0
+       @param[in]  xi      points in local coordinates of the reference
+                           element of e
+       @param[out] values  values, ncomps() components for each point
+     */
+    virtual void evaluateAll (const Entity& e,
+                              const std::vector< Dune::FieldVector<ctype,dim> >& xi,
+                              std::vector< double >& values) const
+    {
+      const int n = ncomps();
+      values.resize( xi.size() * n );
+      for (std::size_t k = 0; k < xi.size(); ++k)
+        for (int j = 0; j < n; ++j)
+          values[ k*n + j ] = evaluate( j, e, xi[ k ] );
+    }
+
     //! get name
     virtual std::string name () const = 0;
 
@@ -4,7 +4,9 @@
 #ifndef DUNE_SUBSAMPLINGVTKWRITER_HH
 #define DUNE_SUBSAMPLINGVTKWRITER_HH
 
+#include <map>
 #include <ostream>
+#include <vector>
 
 #include <dune/common/indent.hh>
 #include <dune/geometry/type.hh>
@@ -46,6 +48,7 @@ namespace Dune
 
     typedef typename Base::CellIterator CellIterator;
     typedef typename Base::FunctionIterator FunctionIterator;
+    typedef typename Base::VTKFunction VTKFunction;
     using Base::cellBegin;
     using Base::cellEnd;
     using Base::celldata;
@@ -83,6 +86,29 @@ namespace Dune
       return geometryType;
     }
 
+    //! the subsampling of one geometry type at the writer's level
+    struct Subsampling
+    {
+      //! geometry type of the sub-elements
+      GeometryType coercedToType;
+      //! local coordinates of the sub-vertices
+      std::vector< FieldVector<ctype, dim> > vertexCoords;
+      //! local coordinates of the sub-elements (where cell data is sampled)
+      std::vector< FieldVector<ctype, dim> > elementCoords;
+      //! sub-element corners in VTK numbering, relative to the first sub-vertex
+      std::vector< int > connectivity;
+      //! number of corners of each sub-element
+      int verticesPerElement;
+    };
+
+    //! get the subsampling of a geometry type, computed on first use
+    const Subsampling &subsampling(const GeometryType &geometryType);
+
+    //! write the values of a function at the subsampled points of each cell
+    void writeSubsampledData(VTK::DataArrayWriter<float> &p,
+                             const VTKFunction &f, unsigned writecomps,
+                             bool atVertices);
+
   protected:
     //! count the vertices, cells and corners
     virtual void countEntities(int &nvertices, int &ncells, int &ncorners);
@@ -112,8 +138,71 @@ namespace Dune
 
     unsigned int level;
     bool coerceToSimplex;
+
+    // refinements depend only on the geometry type since level is fixed
+    std::map< GeometryType, Subsampling > subsamplings;
   };
 
+  //! get the subsampling of a geometry type, computed on first use
+  template <class GridView>
+  const typename SubsamplingVTKWriter<GridView>::Subsampling &
+  SubsamplingVTKWriter<GridView>::subsampling(const GeometryType &geometryType)
+  {
+    typename std::map< GeometryType, Subsampling >::iterator pos
+      = subsamplings.find(geometryType);
+    if(pos != subsamplings.end())
+      return pos->second;
+
+    Subsampling &s = subsamplings[geometryType];
+    s.coercedToType = subsampledGeometryType(geometryType);
+    Refinement &refinement =
+      buildRefinement<dim, ctype>(geometryType, s.coercedToType);
+
+    s.vertexCoords.reserve(refinement.nVertices(level));
+    for(SubVertexIterator sit = refinement.vBegin(level),
+        send = refinement.vEnd(level);
+        sit != send; ++sit)
+      s.vertexCoords.push_back(sit.coords());
+
+    s.verticesPerElement = refinement.eBegin(level).vertexIndices().size();
+    s.elementCoords.reserve(refinement.nElements(level));
+    s.connectivity.reserve(refinement.nElements(level) * s.verticesPerElement);
+    for(SubElementIterator sit = refinement.eBegin(level),
+        send = refinement.eEnd(level);
+        sit != send; ++sit)
+    {
+      s.elementCoords.push_back(sit.coords());
+      IndexVector indices = sit.vertexIndices();
+      for(unsigned int ii = 0; ii < indices.size(); ++ii)
+        s.connectivity.push_back(indices[VTK::renumber(s.coercedToType, ii)]);
+    }
+    return s;
+  }
+
+  //! write the values of a function at the subsampled points of each cell
+  template <class GridView>
+  void SubsamplingVTKWriter<GridView>::
+  writeSubsampledData(VTK::DataArrayWriter<float> &p, const VTKFunction &f,
+                      unsigned writecomps, bool atVertices)
+  {
+    const unsigned ncomps = f.ncomps();
+    std::vector<double> values;
+    for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
+    {
+      const Subsampling &s = subsampling(i->type());
+      f.evaluateAll(*i, (atVertices ? s.vertexCoords : s.elementCoords), values);
+      for(std::size_t k = 0; k < values.size(); k += ncomps)
+      {
+        for (unsigned j=0; j<ncomps; j++)
+          p.write(values[k+j]);
+        // vtk file format: a vector data always should have 3 comps (with
+        // 3rd comp = 0 in 2D case)
+        for(unsigned j = ncomps; j < writecomps; j++)
+          p.write(0.0);
+      }
+    }
+  }
+
   //! count the vertices, cells and corners
   template <class GridView>
   void SubsamplingVTKWriter<GridView>::countEntities(int &nvertices, int &ncells, int &ncorners)
@@ -123,11 +212,11 @@ namespace Dune
     ncorners = 0;
     for (CellIterator it=this->cellBegin(); it!=cellEnd(); ++it)
     {
-      Refinement &refinement = buildRefinement<dim, ctype>(it->type(), subsampledGeometryType(it->type()));
+      const Subsampling &s = subsampling(it->type());
 
-      ncells += refinement.nElements(level);
-      nvertices += refinement.nVertices(level);
-      ncorners += refinement.nElements(level) * refinement.eBegin(level).vertexIndices().size();
+      ncells += s.elementCoords.size();
+      nvertices += s.vertexCoords.size();
+      ncorners += s.connectivity.size();
     }
   }
 
@@ -164,22 +253,7 @@ namespace Dune
       shared_ptr<VTK::DataArrayWriter<float> > p
         (writer.makeArrayWriter<float>((*it)->name(), writecomps, ncells));
       if(!p->writeIsNoop())
-        for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
-        {
-          Refinement &refinement =
-            buildRefinement<dim, ctype>(i->type(),
-                                        subsampledGeometryType(i->type()));
-          for(SubElementIterator sit = refinement.eBegin(level),
-              send = refinement.eEnd(level);
-              sit != send; ++sit)
-          {
-            for (int j=0; j<(*it)->ncomps(); j++)
-              p->write((*it)->evaluate(j,*i,sit.coords()));
-            // expand 2D-Vectors to 3D
-            for(unsigned j = (*it)->ncomps(); j < writecomps; j++)
-              p->write(0.0);
-          }
-        }
+        writeSubsampledData(*p, **it, writecomps, false);
     }
     writer.endCellData();
   }
@@ -217,23 +291,7 @@ namespace Dune
       shared_ptr<VTK::DataArrayWriter<float> > p
         (writer.makeArrayWriter<float>((*it)->name(), writecomps, nvertices));
       if(!p->writeIsNoop())
-        for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
-        {
-          Refinement &refinement =
-            buildRefinement<dim, ctype>(i->type(),
-                                        subsampledGeometryType(i->type()));
-          for(SubVertexIterator sit = refinement.vBegin(level),
-              send = refinement.vEnd(level);
-              sit != send; ++sit)
-          {
-            for (int j=0; j<(*it)->ncomps(); j++)
-              p->write((*it)->evaluate(j,*i,sit.coords()));
-            // vtk file format: a vector data always should have 3 comps (with
-            // 3rd comp = 0 in 2D case)
-            for(unsigned j = (*it)->ncomps(); j < writecomps; j++)
-              p->write(0.0);
-          }
-        }
+        writeSubsampledData(*p, **it, writecomps, true);
     }
     writer.endPointData();
   }
@@ -249,14 +307,11 @@ namespace Dune
     if(!p->writeIsNoop())
       for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
       {
-        Refinement &refinement =
-          buildRefinement<dim, ctype>(i->type(),
-                                      subsampledGeometryType(i->type()));
-        for(SubVertexIterator sit = refinement.vBegin(level),
-            send = refinement.vEnd(level);
-            sit != send; ++sit)
+        const Subsampling &s = subsampling(i->type());
+        const typename GridView::template Codim<0>::Geometry geometry = i->geometry();
+        for(std::size_t k = 0; k < s.vertexCoords.size(); ++k)
         {
-          FieldVector<ctype, dimw> coords = i->geometry().global(sit.coords());
+          FieldVector<ctype, dimw> coords = geometry.global(s.vertexCoords[k]);
           for (int j=0; j<std::min(int(dimw),3); j++)
             p->write(coords[j]);
           for (int j=std::min(int(dimw),3); j<3; j++)
@@ -284,18 +339,10 @@ namespace Dune
         int offset = 0;
         for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
         {
-          GeometryType coercedToType = subsampledGeometryType(i->type());
-          Refinement &refinement =
-            buildRefinement<dim, ctype>(i->type(), coercedToType);
-          for(SubElementIterator sit = refinement.eBegin(level),
-              send = refinement.eEnd(level);
-              sit != send; ++sit)
-          {
-            IndexVector indices = sit.vertexIndices();
-            for(unsigned int ii = 0; ii < indices.size(); ++ii)
-              p1->write(offset+indices[VTK::renumber(coercedToType, ii)]);
-          }
-          offset += refinement.nVertices(level);
+          const Subsampling &s = subsampling(i->type());
+          for(std::size_t ii = 0; ii < s.connectivity.size(); ++ii)
+            p1->write(offset+s.connectivity[ii]);
+          offset += s.vertexCoords.size();
         }
       }
     }
@@ -309,15 +356,11 @@ namespace Dune
         int offset = 0;
         for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
         {
-          Refinement &refinement =
-            buildRefinement<dim, ctype>(i->type(),
-                                        subsampledGeometryType(i->type()));
-          unsigned int verticesPerCell =
-            refinement.eBegin(level).vertexIndices().size();
-          for(int element = 0; element < refinement.nElements(level);
+          const Subsampling &s = subsampling(i->type());
+          for(std::size_t element = 0; element < s.elementCoords.size();
               ++element)
           {
-            offset += verticesPerCell;
+            offset += s.verticesPerElement;
             p2->write(offset);
           }
         }
@@ -332,11 +375,9 @@ namespace Dune
       if(!p3->writeIsNoop())
         for (CellIterator it=cellBegin(); it!=cellEnd(); ++it)
         {
-          GeometryType coerceTo = subsampledGeometryType(it->type());
-          Refinement &refinement =
-            buildRefinement<dim, ctype>(it->type(), coerceTo);
-          int vtktype = VTK::geometryType(coerceTo);
-          for(int i = 0; i < refinement.nElements(level); ++i)
+          const Subsampling &s = subsampling(it->type());
+          int vtktype = VTK::geometryType(s.coercedToType);
+          for(std::size_t i = 0; i < s.elementCoords.size(); ++i)
             p3->write(vtktype);
         }
     }
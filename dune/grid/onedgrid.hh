@@ -3,13 +3,19 @@
 #ifndef DUNE_ONE_D_GRID_HH
 #define DUNE_ONE_D_GRID_HH
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <vector>
 #include <list>
 
-#include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/static_assert.hh>
 #include <dune/common/tuples.hh>
+#include <dune/common/typetraits.hh>
 
 #include <dune/grid/common/capabilities.hh>
+#include <dune/grid/common/datahandleif.hh>
 #include <dune/grid/common/grid.hh>
 #include <dune/grid/common/gridfactory.hh>
 
@@ -20,6 +26,7 @@
  */
 
 #include "onedgrid/onedgridlist.hh"
+#include "onedgrid/onedgridcommunication.hh"
 #include "onedgrid/nulliteratorfactory.hh"
 #include "onedgrid/onedgridentity.hh"
 #include "onedgrid/onedgridentitypointer.hh"
@@ -39,6 +46,8 @@ namespace Dune {
   template<int dim, int dimw>
   struct OneDGridFamily
   {
+    typedef OneDGridCommunication CCType;
+
     typedef GridTraits<dim,dimw,Dune::OneDGrid,
         OneDGridGeometry,
         OneDGridEntity,
@@ -56,7 +65,7 @@ namespace Dune {
         unsigned int,
         OneDGridIdSet<const OneDGrid>,
         unsigned int,
-        CollectiveCommunication<Dune::OneDGrid>,
+        CCType,
         DefaultLevelGridViewTraits,
         DefaultLeafGridViewTraits,
         OneDGridEntitySeed>
@@ -79,6 +88,21 @@ namespace Dune {
      This implementation of the grid interface provides one-dimensional
      grids only. The OneDGrid can be nonuniform
      and provides local mesh refinement and coarsening.
+
+     A OneDGrid can also be distributed over several processes.  Each process
+     owns a contiguous range of coarse grid elements (together with all their
+     descendants) and additionally stores the coarse grid elements on either
+     side of this range as ghost elements.  Vertices between an interior and a
+     ghost element are border vertices.  communicate() exchanges data of
+     elements and vertices with the neighboring processes, and loadBalance()
+     moves contiguous ranges of coarse grid elements between the processes
+     such that all of them get about the same number of leaf elements.
+     Ghost elements are refined and coarsened like their originals; the
+     COPY refinement type is not supported for distributed grids.
+
+     The layout of OneDGrid does not depend on MPI, code compiled with and
+     without the MPI flags can use the same library.  Sequential grids never
+     call MPI and can be used without initializing MPI.
    */
   class OneDGrid : public GridDefaultImplementation <1, 1,double,OneDGridFamily<1,1> >
   {
@@ -144,6 +168,37 @@ namespace Dune {
     /** \brief Constructor for a uniform grid */
     OneDGrid(int numElements, const ctype& leftBoundary, const ctype& rightBoundary);
 
+    /** \brief Constructor for a grid distributed over the processes of a communicator
+
+       All processes have to pass the same coordinates.  The elements are split
+       into contiguous ranges of equal size, there has to be at least one element
+       per process.
+     */
+    OneDGrid(MPIHelper::MPICommunicator comm, const std::vector<ctype>& coords)
+      : ccobj(comm),
+        refinementType_(LOCAL),
+        leafIndexSet_(*this),
+        idSet_(*this),
+        freeVertexIdCounter_(0),
+        freeElementIdCounter_(0),
+        reversedBoundarySegmentNumbering_(false)
+    {
+      distribute(coords);
+    }
+
+    /** \brief Constructor for a uniform grid distributed over the processes of a communicator */
+    OneDGrid(MPIHelper::MPICommunicator comm, int numElements, const ctype& leftBoundary, const ctype& rightBoundary)
+      : ccobj(comm),
+        refinementType_(LOCAL),
+        leafIndexSet_(*this),
+        idSet_(*this),
+        freeVertexIdCounter_(0),
+        freeElementIdCounter_(0),
+        reversedBoundarySegmentNumbering_(false)
+    {
+      distribute(uniformCoordinates(numElements, leftBoundary, rightBoundary));
+    }
+
     //! Destructor
     ~OneDGrid();
 
@@ -239,27 +294,27 @@ namespace Dune {
     }
 
     /** \brief The processor overlap for parallel computing.  Always zero because
-        this is a strictly sequential grid */
+        distributed OneDGrids have ghost elements only */
     int overlapSize(int codim) const {
       return 0;
     }
 
-    /** \brief The processor ghost overlap for parallel computing.  Always zero because
-        this is a strictly sequential grid */
+    /** \brief The processor ghost overlap for parallel computing.  One coarse grid
+        element for distributed grids, zero otherwise */
     int ghostSize(int codim) const {
-      return 0;
+      return (comm().size() > 1 && codim == 0) ? 1 : 0;
     }
 
     /** \brief The processor overlap for parallel computing.  Always zero because
-        this is a strictly sequential grid */
+        distributed OneDGrids have ghost elements only */
     int overlapSize(int level, int codim) const {
       return 0;
     }
 
-    /** \brief The processor ghost overlap for parallel computing.  Always zero because
-        this is a strictly sequential grid */
+    /** \brief The processor ghost overlap for parallel computing.  One coarse grid
+        element for distributed grids, zero otherwise */
     int ghostSize(int level, int codim) const {
-      return 0;
+      return ghostSize(codim);
     }
 
     /** \brief Get the set of global ids */
@@ -343,15 +398,39 @@ namespace Dune {
      */
     void globalRefine(int refCount);
 
-    // dummy parallel functions
+    /** \brief Communicate data of the entities on a level with the neighboring processes
 
+       This does nothing for sequential grids.  The levels may differ between the
+       processes, a level not existing on this process is considered empty.
+     */
     template<class DataHandle>
     void communicate (DataHandle& data, InterfaceType iftype, CommunicationDirection dir, int level) const
-    {}
+    {
+      if (level<0)
+        DUNE_THROW(GridError, "Communication on nonexisting level " << level << " requested!");
+
+      communicateLevel(data, iftype, dir, level);
+    }
+
+    /** \brief Communicate data of the leaf entities with the neighboring processes
 
+       This does nothing for sequential grids.
+     */
     template<class DataHandle>
     void communicate (DataHandle& data, InterfaceType iftype, CommunicationDirection dir) const
-    {}
+    {
+      communicateLevel(data, iftype, dir, -1);
+    }
+
+    /** \brief Redistribute the coarse grid elements such that all processes have
+        about the same number of leaf elements
+
+       Each process keeps a contiguous range of at least one coarse grid element.
+       The ids of all entities are preserved.
+
+       \return true if the grid has changed
+     */
+    bool loadBalance();
 
     const CollectiveCommunication &comm () const
     {
@@ -361,6 +440,165 @@ namespace Dune {
 
   private:
 
+    /** \brief The entities shared with another process, ordered by position */
+    struct CommunicationInterface
+    {
+      int rank;
+      tuple<std::vector<OneDEntityImp<0>*>, std::vector<OneDEntityImp<1>*> > send;
+      tuple<std::vector<OneDEntityImp<0>*>, std::vector<OneDEntityImp<1>*> > recv;
+    };
+
+    /** \brief Message buffer handed to the data handles, reading and writing a byte vector */
+    template<class DT>
+    class MessageBuffer
+    {
+    public:
+      explicit MessageBuffer (std::vector<char>& buffer)
+        : buffer_(buffer), position_(0)
+      {}
+
+      template<class Y>
+      void write (const Y& data)
+      {
+        dune_static_assert(( is_same<DT,Y>::value ), "DataType mismatch");
+        append(&data, sizeof(DT));
+      }
+
+      template<class Y>
+      void read (Y& data) const
+      {
+        dune_static_assert(( is_same<DT,Y>::value ), "DataType mismatch");
+        extract(&data, sizeof(DT));
+      }
+
+      /** \brief Write the number of objects of an entity, for variable size data */
+      void writeSize (std::size_t n)
+      {
+        append(&n, sizeof(n));
+      }
+
+      /** \brief Read the number of objects of an entity, for variable size data */
+      void readSize (std::size_t& n) const
+      {
+        extract(&n, sizeof(n));
+      }
+
+    private:
+      void append (const void* data, std::size_t bytes)
+      {
+        const char* begin = static_cast<const char*>(data);
+        buffer_.insert(buffer_.end(), begin, begin+bytes);
+      }
+
+      void extract (void* data, std::size_t bytes) const
+      {
+        std::memcpy(data, &buffer_[position_], bytes);
+        position_ += bytes;
+      }
+
+      std::vector<char>& buffer_;
+      mutable std::size_t position_;
+    };
+
+    /** \brief Data handles used by adapt() to keep the ghost elements consistent */
+    class MarkHandle;
+    class IdHandle;
+
+    /** \brief Communicate on a level, or on the leaf level if level is negative */
+    template<class DataHandle>
+    void communicateLevel (DataHandle& data, InterfaceType iftype, CommunicationDirection dir, int level) const
+    {
+      if (comm().size() == 1)
+        return;
+
+      std::vector<CommunicationInterface> interfaces;
+      computeInterfaces(iftype, dir, level, interfaces);
+
+      if (data.contains(dim, 0))
+        communicateCodim<0>(data, interfaces);
+      if (data.contains(dim, 1))
+        communicateCodim<1>(data, interfaces);
+    }
+
+    template<int codim, class DataHandle>
+    void communicateCodim (DataHandle& data, const std::vector<CommunicationInterface>& interfaces) const
+    {
+      typedef typename DataHandle::DataType DataType;
+      typedef typename Traits::template Codim<codim>::EntityPointer EntityPointer;
+      typedef OneDGridEntityPointer<codim,const OneDGrid> EntityPointerImp;
+      typedef std::vector<OneDEntityImp<1-codim>*> EntityList;
+
+      const std::size_t numInterfaces = interfaces.size();
+      const bool fixedSize = data.fixedsize(dim, codim);
+
+      // Gather the data.  For variable size data, the number of objects per
+      // entity precedes the data in the message.
+      std::vector<int> ranks(numInterfaces);
+      std::vector<std::vector<char> > sendBuffers(numInterfaces), recvBuffers;
+      for (std::size_t i=0; i<numInterfaces; i++) {
+        ranks[i] = interfaces[i].rank;
+
+        const EntityList& send = Dune::get<1-codim>(interfaces[i].send);
+        MessageBuffer<DataType> sendBuffer(sendBuffers[i]);
+        if (!fixedSize)
+          for (std::size_t k=0; k<send.size(); k++)
+            sendBuffer.writeSize(data.size(*EntityPointer(EntityPointerImp(send[k]))));
+        for (std::size_t k=0; k<send.size(); k++)
+          data.gather(sendBuffer, *EntityPointer(EntityPointerImp(send[k])));
+      }
+
+      // Both processes of an interface have it in their list, so every
+      // process sends one message to and receives one message from each neighbor
+      comm().exchange(ranks, sendBuffers, ranks, recvBuffers);
+
+      // Scatter the received data
+      for (std::size_t i=0; i<numInterfaces; i++) {
+        const EntityList& recv = Dune::get<1-codim>(interfaces[i].recv);
+        MessageBuffer<DataType> recvBuffer(recvBuffers[i]);
+        std::vector<std::size_t> recvSizes(recv.size());
+        if (!fixedSize)
+          for (std::size_t k=0; k<recv.size(); k++)
+            recvBuffer.readSize(recvSizes[k]);
+        for (std::size_t k=0; k<recv.size(); k++) {
+          EntityPointer entity = EntityPointerImp(recv[k]);
+          data.scatter(recvBuffer, *entity, (fixedSize) ? data.size(*entity) : recvSizes[k]);
+        }
+      }
+    }
+
+    /** \brief Collect the entities shared with each neighboring process
+
+       Both processes list the shared entities in the same order, hence no
+       further information has to be exchanged.
+     */
+    void computeInterfaces(InterfaceType iftype, CommunicationDirection dir, int level,
+                           std::vector<CommunicationInterface>& interfaces) const;
+
+    /** \brief Set up the coarse grid part of a process in a distributed grid */
+    void distribute(const std::vector<ctype>& coords);
+
+    /** \brief The vertex coordinates of a uniform grid */
+    static std::vector<ctype> uniformCoordinates(int numElements, const ctype& leftBoundary, const ctype& rightBoundary);
+
+    /** \brief Set the partition types of all entities from the distribution of the coarse grid */
+    void setPartitionTypes();
+
+    /** \brief Partition type on a process of an entity contained in the given range of coarse grid elements */
+    PartitionType partitionType(int firstMacroElement, int lastMacroElement, int rank) const;
+
+    /** \brief First coarse grid element stored on a process (including the ghost element) */
+    int firstStoredMacroElement(int rank) const {
+      return std::max(macroOffsets_[rank]-1, 0);
+    }
+
+    /** \brief One after the last coarse grid element stored on a process (including the ghost element) */
+    int endStoredMacroElement(int rank) const {
+      return std::min(macroOffsets_[rank+1]+1, macroOffsets_.back());
+    }
+
+    /** \brief The refinement part of adapt(), without any communication */
+    bool adaptLocal();
+
     /** \brief Get vertex lists directly -- makes the code more readable */
     OneDGridList<OneDEntityImp<0> >& vertices(int level) {
       return Dune::get<0>(entityImps_[level]);
@@ -386,9 +624,14 @@ namespace Dune {
     /** \brief Update all indices and ids */
     void setIndices();
 
-    unsigned int getNextFreeId(int codim) {
-      return (codim==0) ? freeElementIdCounter_++ : freeVertexIdCounter_++;
-    }
+    /** \brief Update the level indices only */
+    void setLevelIndices();
+
+    /** \brief Get a new id.  In a distributed grid, the processes use disjoint sets of ids
+
+       \throw GridError if the ids are exhausted
+     */
+    unsigned int getNextFreeId(int codim);
 
     //! The type of grid refinement currently in use
     RefinementType refinementType_;
@@ -422,6 +665,11 @@ namespace Dune {
         This flag stores which is the case. */
     bool reversedBoundarySegmentNumbering_;
 
+    /** \brief The first coarse grid element owned by each process, followed by the number
+        of coarse grid elements (only used for distributed grids).  The id of a coarse
+        grid element of a distributed grid is its global number. */
+    std::vector<int> macroOffsets_;
+
   }; // end Class OneDGrid
 
   namespace Capabilities
@@ -454,13 +702,22 @@ namespace Dune {
       static const bool v = true;
     };
 
-    /** \brief OneDGrid is not parallel
+    /** \brief OneDGrid can be distributed
        \ingroup OneDGrid
      */
     template<>
     struct isParallel< OneDGrid >
     {
-      static const bool v = false;
+      static const bool v = true;
+    };
+
+    /** \brief OneDGrid can communicate data on elements and vertices
+       \ingroup OneDGrid
+     */
+    template<int codim>
+    struct canCommunicate< OneDGrid, codim >
+    {
+      static const bool v = true;
     };
 
     /** \brief OneDGrid is levelwise conforming
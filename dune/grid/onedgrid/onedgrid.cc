@@ -2,6 +2,9 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include "config.h"
 
+#include <limits>
+#include <map>
+
 #include "../onedgrid.hh"
 
 
@@ -96,38 +99,356 @@ Dune::OneDGrid::OneDGrid(const std::vector<ctype>& coords)
   setIndices();
 }
 
+std::vector<Dune::OneDGrid::ctype>
+Dune::OneDGrid::uniformCoordinates(int numElements, const ctype& leftBoundary, const ctype& rightBoundary)
+{
+  if (numElements<1)
+    DUNE_THROW(GridError, "Nonpositive number of elements requested!");
 
-Dune::OneDGrid::~OneDGrid()
+  if (leftBoundary >= rightBoundary)
+    DUNE_THROW(GridError, "The left boundary coordinate has to be strictly less than the right boundary one!");
+
+  std::vector<ctype> coords(numElements+1);
+  for (int i=0; i<numElements+1; i++)
+    coords[i] = leftBoundary + i*(rightBoundary-leftBoundary) / numElements;
+
+  return coords;
+}
+
+unsigned int Dune::OneDGrid::getNextFreeId(int codim)
 {
-  // Delete all vertices
-  for (unsigned int i=0; i<entityImps_.size(); i++) {
+  const unsigned int size = comm().size();
+  const unsigned int rank = comm().rank();
+
+  // The ids are packed into ints when moving elements between processes
+  const unsigned int maxId = (size > 1) ? std::numeric_limits<int>::max() : std::numeric_limits<unsigned int>::max();
+
+  unsigned int& counter = (codim==0) ? freeElementIdCounter_ : freeVertexIdCounter_;
+  if (counter > (maxId - rank) / size)
+    DUNE_THROW(GridError, "OneDGrid has run out of " << ((codim==0) ? "element" : "vertex") << " ids!");
+
+  return (counter++) * size + rank;
+}
+
+void Dune::OneDGrid::distribute(const std::vector<ctype>& coords)
+{
+  if (coords.size()<2)
+    DUNE_THROW(GridError, "You have to provide at least two coordinates!");
+
+  for (size_t i=0; i<coords.size()-1; i++)
+    if (coords[i] >= coords[i+1])
+      DUNE_THROW(GridError, "The coordinates have to be in ascending order!");
+
+  const int numElements = coords.size()-1;
+  const int size = comm().size();
+  const int rank = comm().rank();
+
+  if (numElements < size)
+    DUNE_THROW(GridError, "A distributed OneDGrid needs at least one element per process!");
 
-    OneDGridList<OneDEntityImp<0> >::iterator v = vertices(i).begin();
+  // Contiguous ranges of (almost) equal size
+  macroOffsets_.resize(size+1);
+  for (int q=0; q<=size; q++)
+    macroOffsets_[q] = (long(q)*numElements) / size;
 
-    while (v) {
+  // The ids of the coarse grid entities are their global numbers,
+  // make sure that no process hands them out again
+  freeElementIdCounter_ = (numElements+size-1) / size;
+  freeVertexIdCounter_  = (numElements+size) / size;
+
+  // Init grid hierarchy
+  entityImps_.resize(1);
+
+  const int first = firstStoredMacroElement(rank);
+  const int end   = endStoredMacroElement(rank);
+
+  // Init vertex set
+  for (int i=first; i<=end; i++) {
+    OneDEntityImp<0> newVertex(0, coords[i], i);
+    vertices(0).push_back(newVertex);
+  }
+
+  // Init element set
+  OneDGridList<OneDEntityImp<0> >::iterator it = vertices(0).begin();
+  for (int i=first; i<end; i++) {
+
+    OneDEntityImp<1> newElement(0, i, false);
+    newElement.vertex_[0] = it;
+    it = it->succ_;
+    newElement.vertex_[1] = it;
+
+    elements(0).push_back(newElement);
+
+  }
+
+  setIndices();
+  setPartitionTypes();
+}
 
-      OneDGridList<OneDEntityImp<0> >::iterator vSucc = v->succ_;
-      vertices(i).erase(v);
-      v = vSucc;
+namespace {
 
+  // The coarse grid element containing an element, its id is the global
+  // number of the coarse grid element in a distributed grid
+  const Dune::OneDEntityImp<1>* macroElement(const Dune::OneDEntityImp<1>* e)
+  {
+    while (e->level_ > 0)
+      e = e->father_;
+    return e;
+  }
+
+  // The range of coarse grid elements containing a vertex of the element e
+  void vertexMacroElements(const Dune::OneDEntityImp<0>* v, const Dune::OneDEntityImp<1>* e,
+                           int numMacroElements, int& first, int& last)
+  {
+    const Dune::OneDEntityImp<1>* macro = macroElement(e);
+    first = last = macro->id_;
+    if (v->pos_[0] == macro->vertex_[0]->pos_[0])
+      first = std::max(first-1, 0);
+    if (v->pos_[0] == macro->vertex_[1]->pos_[0])
+      last = std::min(last+1, numMacroElements-1);
+  }
+
+  // The vertex of the leaf grid view at the position of v
+  Dune::OneDEntityImp<0>* leafVertex(Dune::OneDEntityImp<0>* v)
+  {
+    while (!v->isLeaf())
+      v = v->son_;
+    return v;
+  }
+
+  bool compareElementPositions(const Dune::OneDEntityImp<1>* a, const Dune::OneDEntityImp<1>* b)
+  {
+    return a->vertex_[0]->pos_[0] < b->vertex_[0]->pos_[0];
+  }
+
+  // Entities sending data through the interface
+  bool isInterfaceSource(Dune::InterfaceType iftype, Dune::PartitionType type)
+  {
+    switch (iftype) {
+    case Dune::InteriorBorder_InteriorBorder_Interface :
+    case Dune::InteriorBorder_All_Interface :
+      return type == Dune::InteriorEntity || type == Dune::BorderEntity;
+    case Dune::Overlap_OverlapFront_Interface :
+    case Dune::Overlap_All_Interface :
+      return type == Dune::OverlapEntity;
+    case Dune::All_All_Interface :
+      return true;
+    }
+    return false;
+  }
+
+  // Entities receiving data through the interface
+  bool isInterfaceTarget(Dune::InterfaceType iftype, Dune::PartitionType type)
+  {
+    switch (iftype) {
+    case Dune::InteriorBorder_InteriorBorder_Interface :
+      return type == Dune::InteriorEntity || type == Dune::BorderEntity;
+    case Dune::Overlap_OverlapFront_Interface :
+      return type == Dune::OverlapEntity || type == Dune::FrontEntity;
+    case Dune::InteriorBorder_All_Interface :
+    case Dune::Overlap_All_Interface :
+    case Dune::All_All_Interface :
+      return true;
+    }
+    return false;
+  }
+
+}
+
+Dune::PartitionType Dune::OneDGrid::partitionType(int firstMacroElement, int lastMacroElement, int rank) const
+{
+  const int first = macroOffsets_[rank];
+  const int end   = macroOffsets_[rank+1];
+
+  if (firstMacroElement >= first && lastMacroElement < end)
+    return InteriorEntity;
+  if (lastMacroElement >= first && firstMacroElement < end)
+    return BorderEntity;
+  return GhostEntity;
+}
+
+void Dune::OneDGrid::setPartitionTypes()
+{
+  if (macroOffsets_.empty())
+    return;
+
+  const int numMacroElements = macroOffsets_.back();
+  const int rank = comm().rank();
+
+  for (int i=0; i<=maxLevel(); i++) {
+    OneDGridList<OneDEntityImp<1> >::iterator eIt;
+    for (eIt = elements(i).begin(); eIt!=elements(i).end(); eIt = eIt->succ_) {
+
+      const int m = macroElement(eIt)->id_;
+      eIt->partitionType_ = partitionType(m, m, rank);
+
+      for (int k=0; k<2; k++) {
+        int first, last;
+        vertexMacroElements(eIt->vertex_[k], eIt, numMacroElements, first, last);
+        eIt->vertex_[k]->partitionType_ = partitionType(first, last, rank);
+      }
     }
+  }
+}
+
+void Dune::OneDGrid::computeInterfaces(InterfaceType iftype, CommunicationDirection dir, int level,
+                                       std::vector<CommunicationInterface>& interfaces) const
+{
+  interfaces.clear();
+
+  const int numMacroElements = macroOffsets_.back();
+  const int size = comm().size();
+  const int rank = comm().rank();
+
+  // The elements of the level or leaf grid view, ordered by position.  If the
+  // level does not exist here, no other process has entities of this level
+  // in common with us either.
+  std::vector<OneDEntityImp<1>*> elementList;
+  if (level >= 0 && level <= maxLevel()) {
+    for (const OneDEntityImp<1>* eIt = elements(level).begin(); eIt!=elements(level).end(); eIt = eIt->succ_)
+      elementList.push_back(const_cast<OneDEntityImp<1>*>(eIt));
+  } else if (level < 0) {
+    for (int i=0; i<=maxLevel(); i++)
+      for (const OneDEntityImp<1>* eIt = elements(i).begin(); eIt!=elements(i).end(); eIt = eIt->succ_)
+        if (eIt->isLeaf())
+          elementList.push_back(const_cast<OneDEntityImp<1>*>(eIt));
+    std::sort(elementList.begin(), elementList.end(), compareElementPositions);
+  }
+
+  // The coarse grid element of each element
+  std::vector<int> elementMacros(elementList.size());
+  for (size_t i=0; i<elementList.size(); i++)
+    elementMacros[i] = macroElement(elementList[i])->id_;
+
+  // The vertices, ordered by position, with the range of coarse grid elements
+  // they lie in and the range of coarse grid elements of the adjacent elements
+  // of the grid view.  A vertex is shared with all processes storing one of
+  // these adjacent elements.
+  std::vector<OneDEntityImp<0>*> vertexList;
+  std::vector<std::pair<int,int> > vertexSpans, vertexMacros;
+  for (size_t i=0; i<elementList.size(); i++) {
+    for (int k=0; k<2; k++) {
+      OneDEntityImp<0>* v = elementList[i]->vertex_[k];
+      if (level < 0)
+        v = leafVertex(v);
+
+      if (!vertexList.empty() && vertexList.back() == v) {
+        vertexMacros.back().second = elementMacros[i];
+        continue;
+      }
 
+      int first, last;
+      vertexMacroElements(v, elementList[i], numMacroElements, first, last);
+      vertexList.push_back(v);
+      vertexSpans.push_back(std::make_pair(first, last));
+      vertexMacros.push_back(std::make_pair(elementMacros[i], elementMacros[i]));
+    }
   }
 
-  // Delete all elements
-  for (unsigned int i=0; i<entityImps_.size(); i++) {
+  const bool forward = (dir == ForwardCommunication);
+
+  for (int q=0; q<size; q++) {
 
-    OneDGridList<OneDEntityImp<1> >::iterator e = elements(i).begin();
+    if (q == rank)
+      continue;
 
-    while (e) {
+    // Only the processes storing an adjacent range of coarse grid elements share entities
+    const int first = firstStoredMacroElement(q);
+    const int end   = endStoredMacroElement(q);
+    if (end <= firstStoredMacroElement(rank) || first >= endStoredMacroElement(rank))
+      continue;
 
-      OneDGridList<OneDEntityImp<1> >::iterator eSucc = e->succ_;
-      elements(i).erase(e);
-      e = eSucc;
+    CommunicationInterface interface;
+    interface.rank = q;
 
+    for (size_t i=0; i<elementList.size(); i++) {
+      const int m = elementMacros[i];
+      if (m < first || m >= end)
+        continue;
+
+      const PartitionType here  = elementList[i]->partitionType_;
+      const PartitionType there = partitionType(m, m, q);
+      if ((forward) ? (isInterfaceSource(iftype, here) && isInterfaceTarget(iftype, there))
+          : (isInterfaceTarget(iftype, here) && isInterfaceSource(iftype, there)))
+        Dune::get<1>(interface.send).push_back(elementList[i]);
+      if ((forward) ? (isInterfaceTarget(iftype, here) && isInterfaceSource(iftype, there))
+          : (isInterfaceSource(iftype, here) && isInterfaceTarget(iftype, there)))
+        Dune::get<1>(interface.recv).push_back(elementList[i]);
+    }
+
+    for (size_t i=0; i<vertexList.size(); i++) {
+      if (vertexMacros[i].second < first || vertexMacros[i].first >= end)
+        continue;
+
+      const PartitionType here  = vertexList[i]->partitionType_;
+      const PartitionType there = partitionType(vertexSpans[i].first, vertexSpans[i].second, q);
+      if ((forward) ? (isInterfaceSource(iftype, here) && isInterfaceTarget(iftype, there))
+          : (isInterfaceTarget(iftype, here) && isInterfaceSource(iftype, there)))
+        Dune::get<0>(interface.send).push_back(vertexList[i]);
+      if ((forward) ? (isInterfaceTarget(iftype, here) && isInterfaceSource(iftype, there))
+          : (isInterfaceSource(iftype, here) && isInterfaceTarget(iftype, there)))
+        Dune::get<0>(interface.recv).push_back(vertexList[i]);
     }
 
+    interfaces.push_back(interface);
   }
+}
+
+/** \brief Copies the refinement marks of the interior elements to their ghost copies */
+class Dune::OneDGrid::MarkHandle
+  : public CommDataHandleIF<MarkHandle, int>
+{
+public:
+  bool contains (int dim, int codim) const { return codim == 0; }
+
+  bool fixedsize (int dim, int codim) const { return true; }
+
+  template<class EntityType>
+  size_t size (const EntityType& e) const { return 1; }
+
+  template<class MessageBufferImp, class EntityType>
+  void gather (MessageBufferImp& buff, const EntityType& e) const
+  {
+    buff.write(int(OneDGrid::getRealImplementation(e).target_->markState_));
+  }
+
+  template<class MessageBufferImp, class EntityType>
+  void scatter (MessageBufferImp& buff, const EntityType& e, size_t n)
+  {
+    int markState;
+    buff.read(markState);
+    OneDGrid::getRealImplementation(e).target_->markState_ = OneDEntityImp<1>::MarkState(markState);
+  }
+};
+
+/** \brief Copies the ids of new interior entities to their ghost copies */
+class Dune::OneDGrid::IdHandle
+  : public CommDataHandleIF<IdHandle, unsigned int>
+{
+public:
+  bool contains (int dim, int codim) const { return true; }
+
+  bool fixedsize (int dim, int codim) const { return true; }
+
+  template<class EntityType>
+  size_t size (const EntityType& e) const { return 1; }
+
+  template<class MessageBufferImp, class EntityType>
+  void gather (MessageBufferImp& buff, const EntityType& e) const
+  {
+    buff.write(OneDGrid::getRealImplementation(e).target_->id_);
+  }
+
+  template<class MessageBufferImp, class EntityType>
+  void scatter (MessageBufferImp& buff, const EntityType& e, size_t n)
+  {
+    buff.read(OneDGrid::getRealImplementation(e).target_->id_);
+  }
+};
+
+Dune::OneDGrid::~OneDGrid()
+{
+  // The vertices and elements are released together with the lists of entityImps_
 
   // Delete levelIndexSets
   for (unsigned int i=0; i<levelIndexSets_.size(); i++)
@@ -260,6 +581,29 @@ Dune::OneDGrid::getLeftNeighborWithSon(OneDGridList<OneDEntityImp<1> >::iterator
 
 
 bool Dune::OneDGrid::adapt()
+{
+  if (comm().size() == 1)
+    return adaptLocal();
+
+  if (refinementType_ == COPY)
+    DUNE_THROW(NotImplemented, "COPY refinement of a distributed OneDGrid");
+
+  // Ghost elements are refined and coarsened like their originals
+  MarkHandle markHandle;
+  communicate(markHandle, InteriorBorder_All_Interface, ForwardCommunication);
+
+  int refinedGrid = adaptLocal();
+  refinedGrid = comm().max(refinedGrid);
+
+  // New entities get their ids from the process owning them.  Shared vertices
+  // are copies of coarser vertices and have the same ids on all processes.
+  IdHandle idHandle;
+  communicate(idHandle, InteriorBorder_All_Interface, ForwardCommunication);
+
+  return refinedGrid;
+}
+
+bool Dune::OneDGrid::adaptLocal()
 {
   OneDGridList<OneDEntityImp<1> >::iterator eIt;
 
@@ -310,8 +654,13 @@ bool Dune::OneDGrid::adapt()
 
         // Delete vertex between left and right element to be deleted
         assert(leftElementToBeDeleted->vertex_[1] == rightElementToBeDeleted->vertex_[0]);
+        leafIndexSet_.removeVertex(leftElementToBeDeleted->vertex_[1]);
         vertices(i).erase(leftElementToBeDeleted->vertex_[1]);
 
+        // The father becomes a leaf element and takes over the leaf index of its left son
+        leafIndexSet_.replaceElement(leftElementToBeDeleted, leftElementToBeDeleted->father_);
+        leafIndexSet_.removeElement(rightElementToBeDeleted);
+
         // Remove references from the father element
         assert(rightElementToBeDeleted->father_->sons_[1] == rightElementToBeDeleted);
         leftElementToBeDeleted->father_->sons_[0]  = NULL;
@@ -376,6 +725,8 @@ bool Dune::OneDGrid::adapt()
           OneDEntityImp<0> newLeftUpperVertex(i+1,
                                               eIt->vertex_[0]->pos_,
                                               eIt->vertex_[0]->id_);
+          newLeftUpperVertex.leafIndex_ = eIt->vertex_[0]->leafIndex_;
+          newLeftUpperVertex.partitionType_ = eIt->vertex_[0]->partitionType_;
 
           // Insert new vertex into vertex list
           leftUpperVertex = vertices(i+1).insert((leftNeighbor)
@@ -394,8 +745,10 @@ bool Dune::OneDGrid::adapt()
         ctype p = 0.5*(eIt->vertex_[0]->pos_[0] + eIt->vertex_[1]->pos_[0]);
 
         OneDEntityImp<0> centerVertex(i+1, p, getNextFreeId(1));
+        centerVertex.partitionType_ = eIt->partitionType_;
 
         OneDGridList<OneDEntityImp<0> >::iterator centerVertexIterator = vertices(i+1).insert(leftUpperVertex->succ_, centerVertex);
+        leafIndexSet_.insertVertex(centerVertexIterator);
 
         // ////////////////////////////////////////////////////////////
         // Does the right vertex exist on the next-higher level?
@@ -407,6 +760,8 @@ bool Dune::OneDGrid::adapt()
           OneDEntityImp<0> newRightUpperVertex(i+1,
                                                eIt->vertex_[1]->pos_,
                                                eIt->vertex_[1]->id_);
+          newRightUpperVertex.leafIndex_ = eIt->vertex_[1]->leafIndex_;
+          newRightUpperVertex.partitionType_ = eIt->vertex_[1]->partitionType_;
 
           rightUpperVertex = vertices(i+1).insert(centerVertexIterator->succ_, newRightUpperVertex);
 
@@ -422,12 +777,14 @@ bool Dune::OneDGrid::adapt()
         newElement0.vertex_[1] = centerVertexIterator;
         newElement0.father_ = eIt;
         newElement0.isNew_ = true;
+        newElement0.partitionType_ = eIt->partitionType_;
 
         OneDEntityImp<1> newElement1(i+1, getNextFreeId(0), reversedBoundarySegmentNumbering_);
         newElement1.vertex_[0] = centerVertexIterator;
         newElement1.vertex_[1] = rightUpperVertex;
         newElement1.father_ = eIt;
         newElement1.isNew_ = true;
+        newElement1.partitionType_ = eIt->partitionType_;
 
         // Insert new elements into element list
         if (leftNeighbor!=NULL)
@@ -439,6 +796,10 @@ bool Dune::OneDGrid::adapt()
 
         eIt->sons_[1] = elements(i+1).insert(eIt->sons_[0]->succ_, newElement1);
 
+        // The left son takes over the leaf index of the father
+        leafIndexSet_.replaceElement(eIt, eIt->sons_[0]);
+        leafIndexSet_.insertElement(eIt->sons_[1]);
+
         // The grid has been modified
         refinedGrid = true;
 
@@ -475,6 +836,7 @@ bool Dune::OneDGrid::adapt()
           if (leftUpperVertex==NULL) {
 
             OneDEntityImp<0> newLeftUpperVertex(i+1, eIt->vertex_[0]->pos_, eIt->vertex_[0]->id_);
+            newLeftUpperVertex.leafIndex_ = eIt->vertex_[0]->leafIndex_;
 
             // Insert new vertex into vertex list
             leftUpperVertex = vertices(i+1).insert((leftNeighbor)
@@ -493,6 +855,7 @@ bool Dune::OneDGrid::adapt()
           if (rightUpperVertex==NULL) {
 
             OneDEntityImp<0> newRightUpperVertex(i+1, eIt->vertex_[1]->pos_, eIt->vertex_[1]->id_);
+            newRightUpperVertex.leafIndex_ = eIt->vertex_[1]->leafIndex_;
 
             // Insert new vertex into list
             rightUpperVertex = vertices(i+1).insert(leftUpperVertex->succ_, newRightUpperVertex);
@@ -521,6 +884,9 @@ bool Dune::OneDGrid::adapt()
           // Mark the new element as the sons of the refined element
           eIt->sons_[0] = eIt->sons_[1] = newElementIterator;
 
+          // The copy takes over the leaf index
+          leafIndexSet_.replaceElement(eIt, newElementIterator);
+
         }
 
       }
@@ -529,10 +895,12 @@ bool Dune::OneDGrid::adapt()
 
   }
 
-  // ////////////////////////////////////
-  //   renumber vertices and elements
-  // ////////////////////////////////////
-  setIndices();
+  // ////////////////////////////////////////////////////////////////
+  //   renumber the level entities, the leaf indices have been
+  //   updated above and only need to be made consecutive again
+  // ////////////////////////////////////////////////////////////////
+  setLevelIndices();
+  leafIndexSet_.compress();
 
   return refinedGrid;
 }
@@ -564,6 +932,15 @@ void Dune::OneDGrid::postAdapt()
 }
 
 void Dune::OneDGrid::setIndices()
+{
+  setLevelIndices();
+
+  leafIndexSet_.update();
+
+  // IdSets don't need updating
+}
+
+void Dune::OneDGrid::setLevelIndices()
 {
   // Add space for new LevelIndexSets if the grid hierarchy got higher
   // They are not created until they are actually requested
@@ -581,10 +958,256 @@ void Dune::OneDGrid::setIndices()
   for (int i=0; i<=maxLevel(); i++)
     if (levelIndexSets_[i])
       levelIndexSets_[i]->update();
+}
 
-  leafIndexSet_.update();
+namespace {
+
+  // Append the refinement tree of an element in preorder: the id, whether
+  // the element is refined, and for refined elements the id of the center
+  // vertex followed by the trees of the sons
+  void packRefinementTree(const Dune::OneDEntityImp<1>* e, std::vector<int>& buffer)
+  {
+    buffer.push_back(e->id_);
+    buffer.push_back(!e->isLeaf());
+    if (e->isLeaf())
+      return;
+    buffer.push_back(e->sons_[0]->vertex_[1]->id_);
+    packRefinementTree(e->sons_[0], buffer);
+    packRefinementTree(e->sons_[1], buffer);
+  }
 
-  // IdSets don't need updating
+  // A node of a refinement tree, i.e., an element id, the id of its center
+  // vertex, or -1 if the element is not refined
+  struct RefinementNode
+  {
+    RefinementNode (int elementId, int centerId) : elementId(elementId), centerId(centerId) {}
+    int elementId;
+    int centerId;
+  };
+
+  // Sort the nodes of a refinement tree into the levels.  Preorder visits the
+  // elements of each level from left to right.
+  std::size_t unpackRefinementTree(const std::vector<int>& buffer, std::size_t pos, unsigned int level,
+                                   std::vector<std::vector<RefinementNode> >& levels)
+  {
+    if (levels.size() <= level)
+      levels.resize(level+1);
+
+    const int id = buffer[pos++];
+    const bool refined = buffer[pos++];
+    levels[level].push_back(RefinementNode(id, (refined) ? buffer[pos] : -1));
+    if (!refined)
+      return pos;
+
+    pos++;
+    pos = unpackRefinementTree(buffer, pos, level+1, levels);
+    return unpackRefinementTree(buffer, pos, level+1, levels);
+  }
+
+}
+
+bool Dune::OneDGrid::loadBalance()
+{
+  if (comm().size() == 1)
+    return false;
+
+  const int numMacroElements = macroOffsets_.back();
+  const int size = comm().size();
+  const int rank = comm().rank();
+
+  // ////////////////////////////////////////////////////////////////
+  //   Count the leaf elements of each coarse grid element and split
+  //   the coarse grid into ranges of about the same weight
+  // ////////////////////////////////////////////////////////////////
+  std::vector<int> weights(numMacroElements, 0);
+  for (int i=0; i<=maxLevel(); i++) {
+    OneDGridList<OneDEntityImp<1> >::iterator eIt;
+    for (eIt = elements(i).begin(); eIt!=elements(i).end(); eIt = eIt->succ_)
+      if (eIt->isLeaf() && eIt->partitionType_ == InteriorEntity)
+        weights[macroElement(eIt)->id_]++;
+  }
+  comm().sum(&weights[0], numMacroElements);
+
+  std::vector<long> prefix(numMacroElements+1, 0);
+  for (int m=0; m<numMacroElements; m++)
+    prefix[m+1] = prefix[m] + weights[m];
+
+  std::vector<int> newOffsets(size+1);
+  newOffsets[0] = 0;
+  newOffsets[size] = numMacroElements;
+  for (int q=1; q<size; q++) {
+    // The cut closest to the ideal position, leaving at least one coarse grid
+    // element to this and all following processes
+    const long target = (prefix[numMacroElements]*q) / size;
+    int cut = std::lower_bound(prefix.begin(), prefix.end(), target) - prefix.begin();
+    if (cut > 0 && target - prefix[cut-1] < prefix[cut] - target)
+      cut--;
+    newOffsets[q] = std::min(std::max(cut, newOffsets[q-1]+1), numMacroElements-(size-q));
+  }
+
+  if (newOffsets == macroOffsets_)
+    return false;
+
+  const std::vector<int> oldOffsets = macroOffsets_;
+  const int oldFirst = firstStoredMacroElement(rank);
+  const int oldEnd   = endStoredMacroElement(rank);
+  macroOffsets_ = newOffsets;
+  const int newFirst = firstStoredMacroElement(rank);
+  const int newEnd   = endStoredMacroElement(rank);
+
+  // //////////////////////////////////////////////////////////////////
+  //   Pack the coarse grid elements with their refinement trees:
+  //   ints  [macro element, tree size, left vertex id, right vertex id, tree]
+  //   ctype [left vertex position, right vertex position]
+  // //////////////////////////////////////////////////////////////////
+  std::vector<std::vector<int> > sendInts(size);
+  std::vector<std::vector<ctype> > sendCoords(size);
+  std::vector<int> localInts;
+  std::vector<ctype> localCoords;
+
+  OneDGridList<OneDEntityImp<1> >::iterator eIt;
+  for (eIt = elements(0).begin(); eIt!=elements(0).end(); eIt = eIt->succ_) {
+
+    const int m = eIt->id_;
+    std::vector<int> tree;
+    packRefinementTree(eIt, tree);
+
+    for (int q=0; q<size; q++) {
+
+      std::vector<int>* ints;
+      std::vector<ctype>* coords;
+      if (q == rank) {
+        // Keep what is still needed here
+        if (m < newFirst || m >= newEnd)
+          continue;
+        ints = &localInts;
+        coords = &localCoords;
+      } else {
+        // Send owned coarse grid elements that q needs and does not have yet
+        if (m < oldOffsets[rank] || m >= oldOffsets[rank+1])
+          continue;
+        const int newFirstQ = std::max(newOffsets[q]-1, 0);
+        const int newEndQ   = std::min(newOffsets[q+1]+1, numMacroElements);
+        const int oldFirstQ = std::max(oldOffsets[q]-1, 0);
+        const int oldEndQ   = std::min(oldOffsets[q+1]+1, numMacroElements);
+        if (m < newFirstQ || m >= newEndQ || (m >= oldFirstQ && m < oldEndQ))
+          continue;
+        ints = &sendInts[q];
+        coords = &sendCoords[q];
+      }
+
+      ints->push_back(m);
+      ints->push_back(tree.size());
+      ints->push_back(eIt->vertex_[0]->id_);
+      ints->push_back(eIt->vertex_[1]->id_);
+      ints->insert(ints->end(), tree.begin(), tree.end());
+      coords->push_back(eIt->vertex_[0]->pos_[0]);
+      coords->push_back(eIt->vertex_[1]->pos_[0]);
+    }
+  }
+
+  // //////////////////////////////////////////////////////////////////
+  //   Exchange the coarse grid elements
+  // //////////////////////////////////////////////////////////////////
+  std::vector<int> sendRanks;
+  std::vector<std::vector<int> > sendIntBuffers;
+  std::vector<std::vector<ctype> > sendCoordBuffers;
+  for (int q=0; q<size; q++) {
+    if (sendInts[q].empty())
+      continue;
+    sendRanks.push_back(q);
+    sendIntBuffers.push_back(sendInts[q]);
+    sendCoordBuffers.push_back(sendCoords[q]);
+  }
+
+  // The processes owning the coarse grid elements missing here
+  std::vector<bool> receiveFrom(size, false);
+  for (int m=newFirst; m<newEnd; m++)
+    if (m < oldFirst || m >= oldEnd)
+      receiveFrom[std::upper_bound(oldOffsets.begin(), oldOffsets.end(), m) - oldOffsets.begin() - 1] = true;
+
+  std::vector<int> recvRanks;
+  for (int q=0; q<size; q++)
+    if (receiveFrom[q])
+      recvRanks.push_back(q);
+
+  std::vector<std::vector<int> > recvIntBuffers;
+  std::vector<std::vector<ctype> > recvCoordBuffers;
+  comm().exchange(sendRanks, sendIntBuffers, recvRanks, recvIntBuffers);
+  comm().exchange(sendRanks, sendCoordBuffers, recvRanks, recvCoordBuffers);
+
+  std::vector<int> recvInts = localInts;
+  std::vector<ctype> recvCoords = localCoords;
+  for (std::size_t i=0; i<recvRanks.size(); i++) {
+    recvInts.insert(recvInts.end(), recvIntBuffers[i].begin(), recvIntBuffers[i].end());
+    recvCoords.insert(recvCoords.end(), recvCoordBuffers[i].begin(), recvCoordBuffers[i].end());
+  }
+
+  // Sort the received coarse grid elements by their number
+  std::map<int, std::pair<std::size_t, std::size_t> > macroElements;
+  for (std::size_t pos=0, k=0; pos<recvInts.size(); k++) {
+    macroElements[recvInts[pos]] = std::make_pair(pos, k);
+    pos += 4 + recvInts[pos+1];
+  }
+  assert(int(macroElements.size()) == newEnd-newFirst);
+
+  // //////////////////////////////////////////////////////////////////
+  //   Rebuild the grid: set up the coarse grid, then replay the
+  //   refinement level by level
+  // //////////////////////////////////////////////////////////////////
+  entityImps_.clear();
+  entityImps_.resize(1);
+
+  std::vector<std::vector<RefinementNode> > levels(1);
+  std::map<int, std::pair<std::size_t, std::size_t> >::const_iterator mIt;
+  for (mIt = macroElements.begin(); mIt != macroElements.end(); ++mIt) {
+    const std::size_t pos = mIt->second.first;
+    const std::size_t k   = mIt->second.second;
+
+    if (mIt == macroElements.begin()) {
+      OneDEntityImp<0> newVertex(0, recvCoords[2*k], recvInts[pos+2]);
+      vertices(0).push_back(newVertex);
+    }
+    OneDEntityImp<0> newVertex(0, recvCoords[2*k+1], recvInts[pos+3]);
+    vertices(0).push_back(newVertex);
+
+    OneDEntityImp<1> newElement(0, mIt->first, reversedBoundarySegmentNumbering_);
+    newElement.vertex_[0] = vertices(0).rbegin()->pred_;
+    newElement.vertex_[1] = vertices(0).rbegin();
+    elements(0).push_back(newElement);
+
+    unpackRefinementTree(recvInts, pos+4, 0, levels);
+  }
+
+  setIndices();
+
+  for (std::size_t i=0; i+1<levels.size(); i++) {
+
+    assert(elements(i).size() == int(levels[i].size()));
+
+    std::size_t k = 0;
+    for (eIt = elements(i).begin(); eIt!=elements(i).end(); eIt = eIt->succ_, k++)
+      if (levels[i][k].centerId >= 0)
+        eIt->markState_ = OneDEntityImp<1>::REFINE;
+
+    adaptLocal();
+
+    // Restore the ids of the new entities
+    k = 0;
+    for (eIt = elements(i).begin(); eIt!=elements(i).end(); eIt = eIt->succ_, k++)
+      if (levels[i][k].centerId >= 0)
+        eIt->sons_[0]->vertex_[1]->id_ = levels[i][k].centerId;
+
+    k = 0;
+    for (eIt = elements(i+1).begin(); eIt!=elements(i+1).end(); eIt = eIt->succ_, k++)
+      eIt->id_ = levels[i+1][k].elementId;
+  }
+
+  postAdapt();
+  setIndices();
+  setPartitionTypes();
+
+  return true;
 }
 
 void Dune::OneDGrid::globalRefine(int refCount)
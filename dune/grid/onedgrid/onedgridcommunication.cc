@@ -0,0 +1,113 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include "config.h"
+
+#include <cstring>
+
+#include <dune/grid/onedgrid/onedgridcommunication.hh>
+
+// The communication is sequential unless it was constructed from an MPI
+// communicator with more than one process.  In that case the library has
+// been compiled with MPI, because the MPI constructor is only available
+// with MPI.
+
+int Dune::OneDGridCommunication::barrier() const
+{
+#if HAVE_MPI
+  if (size_ > 1)
+    MPI_Barrier(*this);
+#endif
+  return 0;
+}
+
+void Dune::OneDGridCommunication::broadcastBytes(void* data, std::size_t bytes, int root) const
+{
+#if HAVE_MPI
+  if (size_ > 1 && bytes > 0)
+    MPI_Bcast(data, bytes, MPI_BYTE, root, *this);
+#endif
+}
+
+void Dune::OneDGridCommunication::gatherBytes(const void* in, std::size_t bytes, void* out, int root) const
+{
+#if HAVE_MPI
+  if (size_ > 1) {
+    if (bytes > 0)
+      MPI_Gather(const_cast<void*>(in), bytes, MPI_BYTE, out, bytes, MPI_BYTE, root, *this);
+    return;
+  }
+#endif
+  if (bytes > 0)
+    std::memcpy(out, in, bytes);
+}
+
+void Dune::OneDGridCommunication::scatterBytes(const void* in, void* out, std::size_t bytes, int root) const
+{
+#if HAVE_MPI
+  if (size_ > 1) {
+    if (bytes > 0)
+      MPI_Scatter(const_cast<void*>(in), bytes, MPI_BYTE, out, bytes, MPI_BYTE, root, *this);
+    return;
+  }
+#endif
+  if (bytes > 0)
+    std::memcpy(out, in, bytes);
+}
+
+void Dune::OneDGridCommunication::allgatherBytes(const void* in, std::size_t bytes, void* out) const
+{
+#if HAVE_MPI
+  if (size_ > 1) {
+    if (bytes > 0)
+      MPI_Allgather(const_cast<void*>(in), bytes, MPI_BYTE, out, bytes, MPI_BYTE, *this);
+    return;
+  }
+#endif
+  if (bytes > 0)
+    std::memcpy(out, in, bytes);
+}
+
+void Dune::OneDGridCommunication::exchange(const std::vector<int>& sendRanks,
+                                           const std::vector<std::vector<char> >& sendBuffers,
+                                           const std::vector<int>& recvRanks,
+                                           std::vector<std::vector<char> >& recvBuffers) const
+{
+  recvBuffers.resize(recvRanks.size());
+
+#if HAVE_MPI
+  if (size_ > 1) {
+    enum { tag = 4711 };
+    MPI_Comm communicator = *this;
+
+    std::vector<MPI_Request> requests(sendRanks.size());
+    for (std::size_t i=0; i<sendRanks.size(); i++) {
+      void* data = (sendBuffers[i].empty()) ? 0 : const_cast<char*>(&sendBuffers[i][0]);
+      MPI_Isend(data, sendBuffers[i].size(), MPI_BYTE, sendRanks[i], tag, communicator, &requests[i]);
+    }
+
+    // Messages between two processes arrive in the order they were sent,
+    // hence consecutive exchanges cannot get mixed up
+    for (std::size_t i=0; i<recvRanks.size(); i++) {
+      MPI_Status status;
+      int count;
+      MPI_Probe(recvRanks[i], tag, communicator, &status);
+      MPI_Get_count(&status, MPI_BYTE, &count);
+      recvBuffers[i].resize(count);
+      void* data = (recvBuffers[i].empty()) ? 0 : &recvBuffers[i][0];
+      MPI_Recv(data, count, MPI_BYTE, recvRanks[i], tag, communicator, MPI_STATUS_IGNORE);
+    }
+
+    if (!requests.empty())
+      MPI_Waitall(requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+    return;
+  }
+#endif
+
+  // Sequentially, a process can only exchange messages with itself
+  for (std::size_t i=0; i<recvRanks.size(); i++) {
+    recvBuffers[i].clear();
+    for (std::size_t j=0; j<sendRanks.size(); j++)
+      if (sendRanks[j] == recvRanks[i])
+        recvBuffers[i] = sendBuffers[j];
+  }
+}
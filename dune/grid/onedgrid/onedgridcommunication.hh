@@ -0,0 +1,257 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_ONEDGRID_COMMUNICATION_HH
+#define DUNE_ONEDGRID_COMMUNICATION_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+/** \file
+ * \brief The collective communication of the OneDGrid
+ */
+
+namespace Dune {
+
+  /** \brief Collective communication of a OneDGrid
+
+     The layout of this class and the signatures of its non-template methods
+     do not depend on whether MPI is enabled.  Hence code compiled with and
+     without the MPI flags can be linked against the same OneDGrid library.
+     The data is transferred by a few non-template methods implemented in the
+     library, everything else is built on top of them.
+
+     A default-constructed object communicates within the calling process only
+     and never calls MPI, i.e., sequential grids can be used without
+     initializing MPI.
+
+     Data is transferred as raw bytes, so all types have to be trivially copyable.
+   */
+  class OneDGridCommunication
+  {
+  public:
+    /** \brief Communication within the calling process */
+    OneDGridCommunication ()
+      : handle_(0), rank_(0), size_(1)
+    {}
+
+    /** \brief Communication within the calling process */
+    explicit OneDGridCommunication (const No_Comm&)
+      : handle_(0), rank_(0), size_(1)
+    {}
+
+#if HAVE_MPI
+    /** \brief Communication among the processes of an MPI communicator */
+    explicit OneDGridCommunication (MPI_Comm comm)
+      : handle_(MPI_Comm_c2f(comm)), rank_(0), size_(1)
+    {
+      MPI_Comm_rank(comm, &rank_);
+      MPI_Comm_size(comm, &size_);
+    }
+
+    /** \brief The MPI communicator, MPI_COMM_SELF for a single process */
+    operator MPI_Comm () const
+    {
+      return (size_ > 1) ? MPI_Comm_f2c(handle_) : MPI_COMM_SELF;
+    }
+#endif
+
+    //! Return rank, is between 0 and size()-1
+    int rank () const { return rank_; }
+
+    //! Number of processes in set, is greater than 0
+    int size () const { return size_; }
+
+    //! Compute the sum of the argument over all processes and return the result
+    template<class T>
+    T sum (const T& in) const
+    {
+      T out = in;
+      sum(&out, 1);
+      return out;
+    }
+
+    //! Compute the sum over all processes for each component of an array
+    template<class T>
+    int sum (T* inout, int len) const
+    {
+      return allreduce<std::plus<T> >(inout, len);
+    }
+
+    //! Compute the product of the argument over all processes and return the result
+    template<class T>
+    T prod (const T& in) const
+    {
+      T out = in;
+      prod(&out, 1);
+      return out;
+    }
+
+    //! Compute the product over all processes for each component of an array
+    template<class T>
+    int prod (T* inout, int len) const
+    {
+      return allreduce<std::multiplies<T> >(inout, len);
+    }
+
+    //! Compute the minimum of the argument over all processes and return the result
+    template<class T>
+    T min (const T& in) const
+    {
+      T out = in;
+      min(&out, 1);
+      return out;
+    }
+
+    //! Compute the minimum over all processes for each component of an array
+    template<class T>
+    int min (T* inout, int len) const
+    {
+      return allreduce<Min<T> >(inout, len);
+    }
+
+    //! Compute the maximum of the argument over all processes and return the result
+    template<class T>
+    T max (const T& in) const
+    {
+      T out = in;
+      max(&out, 1);
+      return out;
+    }
+
+    //! Compute the maximum over all processes for each component of an array
+    template<class T>
+    int max (T* inout, int len) const
+    {
+      return allreduce<Max<T> >(inout, len);
+    }
+
+    //! Wait until all processes have arrived at this point in the program
+    int barrier () const;
+
+    //! Distribute an array from the process with rank root to all other processes
+    template<class T>
+    int broadcast (T* inout, int len, int root) const
+    {
+      broadcastBytes(inout, len*sizeof(T), root);
+      return 0;
+    }
+
+    //! Gather arrays on the root process, out has to hold size()*len entries on root
+    template<class T>
+    int gather (T* in, T* out, int len, int root) const
+    {
+      gatherBytes(in, len*sizeof(T), out, root);
+      return 0;
+    }
+
+    //! Scatter the array in from the root process, each process receives len entries
+    template<class T>
+    int scatter (T* in, T* out, int len, int root) const
+    {
+      scatterBytes(in, out, len*sizeof(T), root);
+      return 0;
+    }
+
+    //! Gather arrays on all processes, rbuf has to hold size()*count entries
+    template<class T>
+    int allgather (T* sbuf, int count, T* rbuf) const
+    {
+      allgatherBytes(sbuf, count*sizeof(T), rbuf);
+      return 0;
+    }
+
+    /** \brief Combine an array over all processes with a binary function
+
+       The values are combined in the order of the ranks, so all processes get
+       the same result.
+     */
+    template<class BinaryFunction, class T>
+    int allreduce (T* inout, int len) const
+    {
+      if (size_ == 1 || len == 0)
+        return 0;
+
+      std::vector<T> all(std::size_t(size_)*len);
+      allgather(inout, len, &all[0]);
+
+      BinaryFunction op;
+      for (int i=0; i<len; i++) {
+        inout[i] = all[i];
+        for (int q=1; q<size_; q++)
+          inout[i] = op(inout[i], all[std::size_t(q)*len+i]);
+      }
+      return 0;
+    }
+
+    //! Combine an array over all processes with a binary function, storing the result in out
+    template<class BinaryFunction, class T>
+    int allreduce (const T* in, T* out, int len) const
+    {
+      std::copy(in, in+len, out);
+      return allreduce<BinaryFunction>(out, len);
+    }
+
+    /** \brief Exchange byte messages with other processes
+
+       The message sendBuffers[i] is sent to the process sendRanks[i], and a
+       message is received from each process in recvRanks.  The receive buffers
+       are resized to the size of the incoming messages.  All processes of a
+       communication have to take part in the same sequence of exchanges.
+     */
+    void exchange (const std::vector<int>& sendRanks, const std::vector<std::vector<char> >& sendBuffers,
+                   const std::vector<int>& recvRanks, std::vector<std::vector<char> >& recvBuffers) const;
+
+    //! Exchange messages of trivially copyable objects with other processes
+    template<class T>
+    void exchange (const std::vector<int>& sendRanks, const std::vector<std::vector<T> >& sendBuffers,
+                   const std::vector<int>& recvRanks, std::vector<std::vector<T> >& recvBuffers) const
+    {
+      std::vector<std::vector<char> > sendBytes(sendBuffers.size()), recvBytes;
+      for (std::size_t i=0; i<sendBuffers.size(); i++) {
+        sendBytes[i].resize(sendBuffers[i].size()*sizeof(T));
+        if (!sendBuffers[i].empty())
+          std::memcpy(&sendBytes[i][0], &sendBuffers[i][0], sendBytes[i].size());
+      }
+
+      exchange(sendRanks, sendBytes, recvRanks, recvBytes);
+
+      recvBuffers.resize(recvBytes.size());
+      for (std::size_t i=0; i<recvBytes.size(); i++) {
+        recvBuffers[i].resize(recvBytes[i].size()/sizeof(T));
+        if (!recvBuffers[i].empty())
+          std::memcpy(&recvBuffers[i][0], &recvBytes[i][0], recvBytes[i].size());
+      }
+    }
+
+  private:
+    template<class T>
+    struct Min
+    {
+      T operator() (const T& a, const T& b) const { return (b < a) ? b : a; }
+    };
+
+    template<class T>
+    struct Max
+    {
+      T operator() (const T& a, const T& b) const { return (a < b) ? b : a; }
+    };
+
+    void broadcastBytes (void* data, std::size_t bytes, int root) const;
+    void gatherBytes (const void* in, std::size_t bytes, void* out, int root) const;
+    void scatterBytes (const void* in, void* out, std::size_t bytes, int root) const;
+    void allgatherBytes (const void* in, std::size_t bytes, void* out) const;
+
+    // The Fortran handle of the MPI communicator, which is a plain integer
+    int handle_;
+    int rank_;
+    int size_;
+  };
+
+} // end namespace Dune
+
+#endif
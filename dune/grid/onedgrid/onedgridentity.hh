@@ -31,6 +31,27 @@ namespace Dune {
   template<int mydim, int coorddim, class GridImp>
   class OneDGridGeometry;
 
+  /** \brief Return true if entities of the given partition type are visited by iterators over pitype */
+  template <PartitionIteratorType pitype>
+  inline bool oneDGridPartitionContains (PartitionType type)
+  {
+    switch (pitype) {
+    case Interior_Partition :
+      return type == InteriorEntity;
+    case InteriorBorder_Partition :
+      return type == InteriorEntity || type == BorderEntity;
+    case Overlap_Partition :
+      return type == InteriorEntity || type == BorderEntity || type == OverlapEntity;
+    case OverlapFront_Partition :
+      return type != GhostEntity;
+    case All_Partition :
+      return true;
+    case Ghost_Partition :
+      return type == GhostEntity;
+    }
+    return false;
+  }
+
   template <int mydim>
   class OneDEntityImp {};
 
@@ -42,6 +63,7 @@ namespace Dune {
 
     OneDEntityImp(int level, double pos)
       : pos_(pos), levelIndex_(0), leafIndex_(0), level_(level),
+        partitionType_(InteriorEntity),
         son_(OneDGridNullIteratorFactory<0>::null()),
         pred_(OneDGridNullIteratorFactory<0>::null()),
         succ_(OneDGridNullIteratorFactory<0>::null())
@@ -49,6 +71,7 @@ namespace Dune {
 
     OneDEntityImp(int level, const FieldVector<double, 1>& pos, unsigned int id)
       : pos_(pos), levelIndex_(0), leafIndex_(0), id_(id), level_(level),
+        partitionType_(InteriorEntity),
         son_(OneDGridNullIteratorFactory<0>::null()),
         pred_(OneDGridNullIteratorFactory<0>::null()),
         succ_(OneDGridNullIteratorFactory<0>::null())
@@ -71,6 +94,9 @@ namespace Dune {
     //! level
     int level_;
 
+    //! partition type in a distributed grid
+    PartitionType partitionType_;
+
     //! Son vertex on the next finer grid
     OneDEntityImp<0>* son_;
 
@@ -95,6 +121,7 @@ namespace Dune {
     OneDEntityImp(int level, unsigned int id, bool reversedBoundarySegmentNumbering)
       : levelIndex_(0), leafIndex_(0), id_(id), level_(level),
         markState_(DO_NOTHING), isNew_(false),
+        partitionType_(InteriorEntity),
         reversedBoundarySegmentNumbering_(reversedBoundarySegmentNumbering),
         pred_(OneDGridNullIteratorFactory<1>::null()),
         succ_(OneDGridNullIteratorFactory<1>::null())
@@ -132,6 +159,9 @@ namespace Dune {
     /** \brief This flag is set by adapt() if this element has been newly created. */
     bool isNew_;
 
+    //! partition type in a distributed grid
+    PartitionType partitionType_;
+
     /** Since a OneDGrid is one-dimensional and connected, there can only be two possible numberings
         of the boundary segments.  Either the left one is '0' and the right one is '1' or the reverse.
         This flag stores which is the case. It has the same value throughout the entire grid.
@@ -189,8 +219,8 @@ namespace Dune {
     //! level of this element
     int level () const {return target_->level_;}
 
-    //! only interior entities
-    PartitionType partitionType () const { return InteriorEntity; }
+    //! partition type of this entity (always interior for sequential grids)
+    PartitionType partitionType () const { return target_->partitionType_; }
 
     unsigned int levelIndex() const {return target_->levelIndex_;}
 
@@ -272,8 +302,8 @@ namespace Dune {
     //! Level of this element
     int level () const {return target_->level_;}
 
-    //! only interior entities
-    PartitionType partitionType () const { return InteriorEntity; }
+    //! partition type of this entity (always interior for sequential grids)
+    PartitionType partitionType () const { return target_->partitionType_; }
 
     //! Level index is unique and consecutive per level and codim
     unsigned int levelIndex() const {return target_->levelIndex_;}
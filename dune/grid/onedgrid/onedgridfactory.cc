@@ -172,6 +172,7 @@ createGrid()
   grid_->levelIndexSets_[0]->setSizesAndTypes(vertexPositions_.size(), elements_.size());
 
   grid_->leafIndexSet_.setSizesAndTypes(vertexPositions_.size(), elements_.size());
+  grid_->leafIndexSet_.collectEntities();
 
   // ///////////////////////////////////////////////////
   // hand over the grid and delete the member pointer
@@ -7,6 +7,8 @@
     \brief The index and id sets for the OneDGrid class
  */
 
+#include <algorithm>
+#include <cassert>
 #include <vector>
 
 #include <dune/grid/common/indexidset.hh>
@@ -66,26 +68,13 @@ namespace Dune {
 
     /** \brief Return true if e is contained in the index set.
 
-       Warning: this implementation takes O(n) time!  It also assumes that e belongs
-       to the correct grid.
+       Each entity of the grid lives on exactly one level, hence this only
+       compares the levels.  It assumes that e belongs to the correct grid.
      */
     template <class EntityType>
     bool contains (const EntityType& e) const
     {
-      // If the entity isn't on the same level as this index set it cannot be contained in the index set
-      if (e.level() != level_)
-        return false;
-
-      enum { cd = EntityType::codimension };
-      typedef typename GridImp::template Codim<cd>::template Partition<All_Partition>::LevelIterator IteratorType;
-      IteratorType iend = grid_->template lend<cd,All_Partition>(level_);
-      for (IteratorType it = grid_->template lbegin<cd,All_Partition>(level_);
-           it != iend; ++it)
-      {
-        if (this->template index<cd>(*it) == this->template index<cd>(e))
-          return true;
-      }
-      return false;
+      return e.level() == level_;
     }
 
     /** \brief Sets the corresponding internal fields.  Used by the GridFactory */
@@ -220,22 +209,14 @@ namespace Dune {
 
     /** \brief Return true if e is contained in the index set.
 
-       Warning: this implementation takes O(n) time!  It also assumes that e belongs
-       to the correct grid.
+       An element is a leaf element if it has no sons, and a vertex is a leaf
+       vertex if it has no copy on the next level.  Hence this takes O(1) time.
+       It assumes that e belongs to the correct grid.
      */
     template <class EntityType>
     bool contains (const EntityType& e) const
     {
-      enum { cd = EntityType::codimension };
-      typedef typename GridImp::template Codim<cd>::template Partition<All_Partition>::LeafIterator IteratorType;
-      IteratorType iend = grid_.template leafend<cd,All_Partition>();
-      for (IteratorType it = grid_.template leafbegin<cd,All_Partition>();
-           it != iend; ++it)
-      {
-        if (it->level() == e.level() && this->template index<cd>(*it) == this->template index<cd>(e))
-          return true;
-      }
-      return false;
+      return grid_.getRealImplementation(e).target_->isLeaf();
     }
 
     /** \brief Sets the corresponding internal fields.  Used by the GridFactory */
@@ -301,15 +282,141 @@ namespace Dune {
       // set the list of geometry types
       setSizesAndTypes(numVertices_, numElements_);
 
+      collectEntities();
+    }
+
+    /** \brief Store the leaf entities by their index.
+
+       This has to be called after the indices have been set, either by update()
+       or by the GridFactory.  The incremental update in OneDGrid::adapt() relies
+       on it.
+     */
+    void collectEntities() {
+
+      elements_.assign(numElements_, NULL);
+      vertices_.assign(numVertices_, NULL);
+      freeElementIndices_.clear();
+      freeVertexIndices_.clear();
+
+      for (int i=grid_.maxLevel(); i>=0; i--) {
+
+        const OneDEntityImp<1>* eIt;
+        for (eIt = grid_.elements(i).begin(); eIt != grid_.elements(i).end(); eIt = eIt->succ_)
+          /** \todo Remove the const casts */
+          if (eIt->isLeaf())
+            elements_[eIt->leafIndex_] = const_cast<OneDEntityImp<1>*>(eIt);
+
+        // All copies of a vertex share its leaf index, the coarsest one is stored
+        const OneDEntityImp<0>* vIt;
+        for (vIt = grid_.vertices(i).begin(); vIt != grid_.vertices(i).end(); vIt = vIt->succ_)
+          vertices_[vIt->leafIndex_] = const_cast<OneDEntityImp<0>*>(vIt);
+
+      }
+
     }
 
   private:
 
+    friend class OneDGrid;
+
+    // ///////////////////////////////////////////////////////////////////
+    //   Incremental update of the leaf indices, used by OneDGrid::adapt().
+    //   Indices of removed entities are recycled for new entities, and
+    //   compress() closes the remaining gaps.  Hence the work is
+    //   proportional to the number of entities changed by the adaptation.
+    // ///////////////////////////////////////////////////////////////////
+
+    /** \brief Element takes over the leaf index of a former leaf element */
+    void replaceElement(OneDEntityImp<1>* element, OneDEntityImp<1>* newElement) {
+      newElement->leafIndex_ = element->leafIndex_;
+      elements_[newElement->leafIndex_] = newElement;
+    }
+
+    /** \brief Give a new leaf element a leaf index */
+    void insertElement(OneDEntityImp<1>* element) {
+      element->leafIndex_ = nextIndex(elements_, freeElementIndices_);
+      elements_[element->leafIndex_] = element;
+    }
+
+    /** \brief Release the leaf index of an element that is removed */
+    void removeElement(OneDEntityImp<1>* element) {
+      assert(elements_[element->leafIndex_] == element);
+      elements_[element->leafIndex_] = NULL;
+      freeElementIndices_.push_back(element->leafIndex_);
+    }
+
+    /** \brief Give a new vertex (which is not a copy of a coarser vertex) a leaf index */
+    void insertVertex(OneDEntityImp<0>* vertex) {
+      vertex->leafIndex_ = nextIndex(vertices_, freeVertexIndices_);
+      vertices_[vertex->leafIndex_] = vertex;
+    }
+
+    /** \brief Release the leaf index of a vertex (which is not a copy of a coarser vertex) */
+    void removeVertex(OneDEntityImp<0>* vertex) {
+      assert(vertices_[vertex->leafIndex_] == vertex);
+      vertices_[vertex->leafIndex_] = NULL;
+      freeVertexIndices_.push_back(vertex->leafIndex_);
+    }
+
+    /** \brief Make the leaf indices consecutive again after adaptation */
+    void compress() {
+      compress(elements_, freeElementIndices_);
+      compress(vertices_, freeVertexIndices_);
+      setSizesAndTypes(vertices_.size(), elements_.size());
+    }
+
+    template <class T>
+    static unsigned int nextIndex(std::vector<T*>& entities, std::vector<unsigned int>& freeIndices) {
+      if (freeIndices.empty()) {
+        entities.push_back(NULL);
+        return entities.size()-1;
+      }
+      unsigned int index = freeIndices.back();
+      freeIndices.pop_back();
+      return index;
+    }
+
+    // fill the gaps, in increasing order, with the entities of the largest indices
+    template <class T>
+    static void compress(std::vector<T*>& entities, std::vector<unsigned int>& freeIndices) {
+      std::sort(freeIndices.begin(), freeIndices.end());
+      std::vector<unsigned int>::const_iterator gap = freeIndices.begin();
+      while (true) {
+        while (!entities.empty() && entities.back() == NULL)
+          entities.pop_back();
+        if (gap == freeIndices.end() || *gap >= entities.size())
+          break;
+        setLeafIndex(entities.back(), *gap);
+        entities[*gap++] = entities.back();
+        entities.pop_back();
+      }
+      freeIndices.clear();
+    }
+
+    static void setLeafIndex(OneDEntityImp<1>* element, unsigned int index) {
+      element->leafIndex_ = index;
+    }
+
+    // set the index of a vertex and all its copies on finer levels
+    static void setLeafIndex(OneDEntityImp<0>* vertex, unsigned int index) {
+      for (; vertex != NULL; vertex = vertex->son_)
+        vertex->leafIndex_ = index;
+    }
+
     const GridImp& grid_;
 
     int numElements_;
     int numVertices_;
 
+    /** \brief The leaf elements by leaf index */
+    std::vector<OneDEntityImp<1>*> elements_;
+
+    /** \brief The vertices by leaf index (the coarsest copy of each vertex) */
+    std::vector<OneDEntityImp<0>*> vertices_;
+
+    std::vector<unsigned int> freeElementIndices_;
+    std::vector<unsigned int> freeVertexIndices_;
+
     /** \brief The GeometryTypes present for each codim */
     std::vector<GeometryType> myTypes_[2];
   };
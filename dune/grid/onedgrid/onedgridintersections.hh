@@ -86,8 +86,9 @@ namespace Dune {
         }
 
         // We have reached level 0.  If there is no element of the left
-        // we're truly on the boundary
-        return !ancestor->pred_;
+        // we're truly on the boundary, unless this is a ghost element at the
+        // end of the local part of a distributed grid
+        return !ancestor->pred_ && ancestor->partitionType_ != GhostEntity;
       }
 
       // ////////////////////////////////
@@ -108,9 +109,10 @@ namespace Dune {
         ancestor = ancestor->father_;
       }
 
-      // We have reached level 0.  If there is no element of the left
-      // we're truly on the boundary
-      return !ancestor->succ_;
+      // We have reached level 0.  If there is no element of the right
+      // we're truly on the boundary, unless this is a ghost element at the
+      // end of the local part of a distributed grid
+      return !ancestor->succ_ && ancestor->partitionType_ != GhostEntity;
 
     }
 
@@ -352,13 +354,28 @@ namespace Dune {
 
     //! return true if intersection is with boundary.
     bool boundary () const {
+      // The ghost elements at the end of the local part of a distributed
+      // grid have no neighbor, but are not on the domain boundary
+      const OneDEntityImp<1>* ancestor = endOfGrid();
+      return ancestor && ancestor->partitionType_ != GhostEntity;
+    }
+
+    //! return true if across the edge an neighbor on this level exists
+    bool neighbor () const {
+      return !endOfGrid();
+    }
+
+  private:
+    /** \brief Return the level 0 ancestor if there is no element on the
+        other side of the intersection (on any level), and NULL otherwise */
+    const OneDEntityImp<1>* endOfGrid () const {
 
       // Check whether we're on the left boundary
       if (neighbor_==0) {
 
         // If there's an element to the left we can't be on the boundary
         if (center_->pred_)
-          return false;
+          return NULL;
 
         const OneDEntityImp<1>* ancestor = center_;
 
@@ -366,14 +383,14 @@ namespace Dune {
 
           // Check if we're the left son of our father
           if (ancestor != ancestor->father_->sons_[0])
-            return false;
+            return NULL;
 
           ancestor = ancestor->father_;
         }
 
         // We have reached level 0.  If there is no element of the left
-        // we're truly on the boundary
-        return !ancestor->pred_;
+        // we're at the end of the grid
+        return (ancestor->pred_) ? NULL : ancestor;
       }
 
       // ////////////////////////////////
@@ -381,7 +398,7 @@ namespace Dune {
       // ////////////////////////////////
       // If there's an element to the right we can't be on the boundary
       if (center_->succ_)
-        return false;
+        return NULL;
 
       const OneDEntityImp<1>* ancestor = center_;
 
@@ -389,21 +406,18 @@ namespace Dune {
 
         // Check if we're the left son of our father
         if (ancestor != ancestor->father_->sons_[1])
-          return false;
+          return NULL;
 
         ancestor = ancestor->father_;
       }
 
-      // We have reached level 0.  If there is no element of the left
-      // we're truly on the boundary
-      return !ancestor->succ_;
+      // We have reached level 0.  If there is no element of the right
+      // we're at the end of the grid
+      return (ancestor->succ_) ? NULL : ancestor;
 
     }
 
-    //! return true if across the edge an neighbor on this level exists
-    bool neighbor () const {
-      return !boundary();
-    }
+  public:
 
     //! return true if intersection is conform.
     bool conforming () const {
@@ -33,7 +33,8 @@ namespace Dune {
 
       GridImp::getRealImplementation(this->virtualEntity_).setToTarget((OneDEntityImp<1-codim>*) Dune::get<1-codim>(grid_->entityImps_[fullRefineLevel]).begin());
 
-      if (!GridImp::getRealImplementation(this->virtualEntity_).target_->isLeaf())
+      if (!GridImp::getRealImplementation(this->virtualEntity_).target_->isLeaf()
+          || !oneDGridPartitionContains<pitype>(GridImp::getRealImplementation(this->virtualEntity_).target_->partitionType_))
         increment();
     }
 
@@ -45,11 +46,12 @@ namespace Dune {
 
     //! prefix increment
     void increment() {
-      // Increment until you find a leaf entity
+      // Increment until you find a leaf entity of the partition
       do {
         globalIncrement();
       } while (GridImp::getRealImplementation(this->virtualEntity_).target_
-               && !GridImp::getRealImplementation(this->virtualEntity_).target_->isLeaf());
+               && (!GridImp::getRealImplementation(this->virtualEntity_).target_->isLeaf()
+                   || !oneDGridPartitionContains<pitype>(GridImp::getRealImplementation(this->virtualEntity_).target_->partitionType_)));
     }
 
   private:
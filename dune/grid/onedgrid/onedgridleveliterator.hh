@@ -39,13 +39,20 @@ namespace Dune {
     /** \brief Constructor from a given iterator */
     OneDGridLevelIterator<codim,pitype, GridImp>(OneDEntityImp<dim-codim>* it)
       : OneDGridEntityPointer<codim, GridImp>(it)
-    {}
+    {
+      if (it && !oneDGridPartitionContains<pitype>(it->partitionType_))
+        increment();
+    }
 
   public:
 
     //! prefix increment
     void increment() {
-      GridImp::getRealImplementation(this->virtualEntity_).setToTarget(GridImp::getRealImplementation(this->virtualEntity_).target_->succ_);
+      // Skip the entities of other partitions
+      do {
+        GridImp::getRealImplementation(this->virtualEntity_).setToTarget(GridImp::getRealImplementation(this->virtualEntity_).target_->succ_);
+      } while (GridImp::getRealImplementation(this->virtualEntity_).target_
+               && !oneDGridPartitionContains<pitype>(GridImp::getRealImplementation(this->virtualEntity_).target_->partitionType_));
     }
   };
 
@@ -3,7 +3,14 @@
 #ifndef DUNE_ONEDGRID_LIST_HH
 #define DUNE_ONEDGRID_LIST_HH
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <dune/common/iteratorfacades.hh>
+#include <dune/common/shared_ptr.hh>
 
 namespace Dune {
   /** \file
@@ -12,6 +19,73 @@ namespace Dune {
       Unfortunately, there are problems.  I need to store pointers/iterators
       within one element which point to another element (e.g. the element father).
    */
+
+  /** \brief Chunked memory for the objects of a OneDGridList
+
+      The objects are placed in chunks of growing size, such that objects
+      created one after the other lie next to each other in memory.  The
+      slots of erased objects are reused.  All memory is released at once
+      when the storage is destroyed; objects still alive at that point are
+      not destructed, so T must not hold any resources.
+   */
+  template<class T>
+  class OneDGridListStorage
+  {
+    enum { minChunkSize = 16 };
+
+  public:
+    OneDGridListStorage() : next_(0), end_(0), capacity_(0) {}
+
+    ~OneDGridListStorage() {
+      for (std::size_t i=0; i<chunks_.size(); i++)
+        allocator_.deallocate(chunks_[i].first, chunks_[i].second);
+    }
+
+    /** \brief Create a copy of value in the storage */
+    T* create(const T& value) {
+      T* t;
+      if (!free_.empty()) {
+        t = free_.back();
+        free_.pop_back();
+      } else {
+        if (next_==end_) {
+          // double the capacity
+          const std::size_t size = std::max(std::size_t(minChunkSize), capacity_);
+          next_ = allocator_.allocate(size);
+          end_ = next_ + size;
+          chunks_.push_back(std::make_pair(next_, size));
+          capacity_ += size;
+        }
+        t = next_++;
+      }
+      allocator_.construct(t, value);
+      return t;
+    }
+
+    /** \brief Destruct an object and keep its slot for reuse */
+    void destroy(T* t) {
+      allocator_.destroy(t);
+      free_.push_back(t);
+    }
+
+  private:
+    // copying would release the memory twice
+    OneDGridListStorage(const OneDGridListStorage&);
+    OneDGridListStorage& operator=(const OneDGridListStorage&);
+
+    std::allocator<T> allocator_;
+
+    std::vector<std::pair<T*, std::size_t> > chunks_;
+
+    // unused part of the last chunk
+    T* next_;
+    T* end_;
+
+    std::size_t capacity_;
+
+    // slots of erased objects
+    std::vector<T*> free_;
+  };
   template<class T>
   class OneDGridListIterator
     : public BidirectionalIteratorFacade<OneDGridListIterator<T>,T>
@@ -66,7 +140,7 @@ namespace Dune {
       T* i = rbegin();
 
       // New list element by copy construction
-      T* t = new T(value);
+      T* t = storage().create(value);
 
       // einfuegen
       if (begin_==0) {
@@ -101,7 +175,7 @@ namespace Dune {
         return push_back(value);
 
       // New list element by copy construction
-      T* t = new T(value);
+      T* t = storage().create(value);
 
       // insert
       if (begin_==0)
@@ -151,7 +225,7 @@ namespace Dune {
       numelements = numelements-1;
 
       // Actually delete the object
-      delete(i);
+      storage_->destroy(i);
     }
 
     iterator begin() {
@@ -180,11 +254,24 @@ namespace Dune {
 
   private:
 
+    OneDGridListStorage<T>& storage() {
+      if (!storage_)
+        storage_ = shared_ptr<OneDGridListStorage<T> >(new OneDGridListStorage<T>());
+      return *storage_;
+    }
+
     int numelements;
 
     T* begin_;
     T* rbegin_;
 
+    /** \brief The memory of the list elements
+
+       It is shared between copies of the list (the grid keeps its lists in a
+       std::vector) and released when the last copy is destroyed.
+     */
+    shared_ptr<OneDGridListStorage<T> > storage_;
+
   };   // end class OneDGridList
 
 } // namespace Dune
@@ -0,0 +1,119 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief compare the traversal of the leaf elements of an ALU3dGrid by
+ *         ALUGrid's own leaf iterator, by the element walker used in the
+ *         codim 0 Dune iterators and by the Dune leaf iterator
+ *
+ *  A cube grid with n cells per direction is refined globally, so the
+ *  walkers have to descend into the element hierarchy. For 10 million leaf
+ *  elements, use e.g. 27 cells per direction and 3 refinements.
+ *
+ *  usage: benchmark-alutraversal [cells per direction] [refinements] [repetitions]
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include <dune/common/array.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/mpihelper.hh>
+#include <dune/common/shared_ptr.hh>
+#include <dune/common/timer.hh>
+
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+template< class Grid >
+void benchmark ( int n, int refinements, int repetitions )
+{
+  typedef typename Grid::MPICommunicatorType Comm;
+  typedef typename Dune::ALU3dBasicImplTraits< Comm >::HElementType HElementType;
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+
+  Dune::array< unsigned int, 3 > elements;
+  std::fill( elements.begin(), elements.end(), n );
+  Dune::shared_ptr< Grid > grid
+    = Dune::StructuredGridFactory< Grid >::createCubeGrid( Dune::FieldVector< double, 3 >( 0.0 ),
+                                                          Dune::FieldVector< double, 3 >( 1.0 ),
+                                                          elements );
+  grid->globalRefine( refinements );
+  std::cout << "ALU3dGrid with " << grid->size( 0 ) << " leaf elements ("
+            << refinements << " refinements):" << std::endl;
+
+  // ALUGrid's leaf iterator (used by the Dune iterators before)
+  long nativeSum = 0;
+  Dune::Timer watch;
+  for( int r = 0; r < repetitions; ++r )
+  {
+    ALU3DSPACE LeafIterator< HElementType > it( grid->myGrid() );
+    for( it->first(); !it->done(); it->next() )
+      nativeSum += it->item().getIndex();
+  }
+  const double nativeTime = watch.elapsed();
+
+  // the element walker
+  long walkerSum = 0;
+  watch.reset();
+  for( int r = 0; r < repetitions; ++r )
+  {
+    ALU3DSPACE ALU3dGridElementWalker< Comm > it( *grid, -1 );
+    for( it.first(); !it.done(); it.next() )
+      walkerSum += it.item().first->getIndex();
+  }
+  const double walkerTime = watch.elapsed();
+
+  // the Dune leaf iterator (including the construction of the entities)
+  long duneSum = 0;
+  const GridView gridView = grid->leafGridView();
+  const Iterator end = gridView.template end< 0 >();
+  watch.reset();
+  for( int r = 0; r < repetitions; ++r )
+  {
+    for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+      duneSum += Grid::getRealImplementation( *it ).getItem().getIndex();
+  }
+  const double duneTime = watch.elapsed();
+
+  if( (walkerSum != nativeSum) || (duneSum != nativeSum) )
+    std::cerr << "Warning: the traversals visit different elements." << std::endl;
+
+  std::cout << "  ALUGrid leaf iterator: " << nativeTime << " seconds" << std::endl;
+  std::cout << "  element walker:        " << walkerTime << " seconds" << std::endl;
+  std::cout << "  Dune leaf iterator:    " << duneTime << " seconds" << std::endl;
+}
+#endif // #if HAVE_ALUGRID
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  const int n = (argc >= 2 ? std::atoi( argv[ 1 ] ) : 16);
+  const int refinements = (argc >= 3 ? std::atoi( argv[ 2 ] ) : 2);
+  const int repetitions = (argc >= 4 ? std::atoi( argv[ 3 ] ) : 10);
+
+#if HAVE_ALUGRID
+  benchmark< Dune::ALUGrid< 3, 3, Dune::cube, Dune::nonconforming, Dune::No_Comm > >( n, refinements, repetitions );
+#else
+  std::cerr << "ALUGrid not available, nothing to benchmark." << std::endl;
+#endif
+
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch( ... )
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
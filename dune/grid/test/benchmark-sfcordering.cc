@@ -0,0 +1,229 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief compare a cell-centered stencil loop on unstructured grids created
+ *         with and without reordering the macro elements along a Hilbert curve
+ *
+ *  The cube [0,1]^3 is split into 6 n^3 tetrahedra, which are inserted into
+ *  the grid factory in random order (as some mesh generators do). For each
+ *  available grid the benchmark reports the mean index distance of
+ *  neighboring elements, which measures how many cache lines are touched by
+ *  the stencil, and the time spent in the stencil loop.
+ *
+ *  usage: benchmark-sfcordering [cells per direction] [repetitions]
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/grid/common/gridfactory.hh>
+
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#endif
+
+// insert the Kuhn triangulation of a cube with n cells per direction in random order
+template< class Grid >
+void insertCube ( Dune::GridFactory< Grid > &factory, int n )
+{
+  typedef Dune::FieldVector< double, 3 > Vertex;
+
+  std::vector< Vertex > vertices;
+  for( int k = 0; k <= n; ++k )
+    for( int j = 0; j <= n; ++j )
+      for( int i = 0; i <= n; ++i )
+      {
+        Vertex x;
+        x[ 0 ] = double( i ) / n;
+        x[ 1 ] = double( j ) / n;
+        x[ 2 ] = double( k ) / n;
+        factory.insertVertex( x );
+        vertices.push_back( x );
+      }
+
+  const int permutations[ 6 ][ 3 ] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+  const int stride[ 3 ] = { 1, n+1, (n+1)*(n+1) };
+
+  std::vector< std::vector< unsigned int > > elements;
+  for( int k = 0; k < n; ++k )
+    for( int j = 0; j < n; ++j )
+      for( int i = 0; i < n; ++i )
+      {
+        for( int p = 0; p < 6; ++p )
+        {
+          std::vector< unsigned int > element( 4 );
+          element[ 0 ] = i*stride[ 0 ] + j*stride[ 1 ] + k*stride[ 2 ];
+          for( int l = 0; l < 3; ++l )
+            element[ l+1 ] = element[ l ] + stride[ permutations[ p ][ l ] ];
+
+          // make sure the tetrahedron is positively oriented
+          Vertex a = vertices[ element[ 1 ] ], b = vertices[ element[ 2 ] ], c = vertices[ element[ 3 ] ];
+          a -= vertices[ element[ 0 ] ];
+          b -= vertices[ element[ 0 ] ];
+          c -= vertices[ element[ 0 ] ];
+          const double det = a[ 0 ]*(b[ 1 ]*c[ 2 ] - b[ 2 ]*c[ 1 ])
+                             - a[ 1 ]*(b[ 0 ]*c[ 2 ] - b[ 2 ]*c[ 0 ])
+                             + a[ 2 ]*(b[ 0 ]*c[ 1 ] - b[ 1 ]*c[ 0 ]);
+          if( det < 0 )
+            std::swap( element[ 2 ], element[ 3 ] );
+          elements.push_back( element );
+        }
+      }
+
+  // shuffle the elements (using a simple, reproducible linear congruential generator)
+  unsigned long seed = 42;
+  for( std::size_t k = elements.size(); k > 1; --k )
+  {
+    seed = (seed * 1103515245ul + 12345ul) % 2147483648ul;
+    std::swap( elements[ k-1 ], elements[ seed % k ] );
+  }
+
+  const Dune::GeometryType tetrahedron( Dune::GeometryType::simplex, 3 );
+  for( std::size_t k = 0; k < elements.size(); ++k )
+    factory.insertElement( tetrahedron, elements[ k ] );
+}
+
+template< class Grid >
+void benchmark ( const std::string &name, int n, int repetitions, bool ordered )
+{
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+  typedef typename GridView::IntersectionIterator IntersectionIterator;
+
+  Dune::GridFactory< Grid > factory;
+  if( ordered )
+    factory.orderElementsAlongCurve();
+  insertCube( factory, n );
+  Grid *grid = factory.createGrid();
+
+  const GridView gridView = grid->leafView();
+  const int numElements = gridView.indexSet().size( 0 );
+
+  // set up the stencil (neighbors of each element)
+  std::vector< int > offset( 1, 0 ), neighbors;
+  const Iterator end = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    const IntersectionIterator iend = gridView.iend( *it );
+    for( IntersectionIterator iit = gridView.ibegin( *it ); iit != iend; ++iit )
+    {
+      if( iit->neighbor() )
+        neighbors.push_back( gridView.indexSet().index( *iit->outside() ) );
+    }
+    offset.push_back( neighbors.size() );
+  }
+
+  // mean index distance of neighboring elements (in iteration order)
+  double distance = 0.0;
+  for( int e = 0; e < numElements; ++e )
+    for( int k = offset[ e ]; k < offset[ e+1 ]; ++k )
+      distance += std::abs( neighbors[ k ] - e );
+  distance /= std::max( std::size_t( 1 ), neighbors.size() );
+
+  std::vector< double > u( numElements ), v( numElements, 0.0 );
+  for( int e = 0; e < numElements; ++e )
+    u[ e ] = std::sin( double( e ) );
+
+  // stencil loop: v = A u for the finite volume Laplacian
+  Dune::Timer watch;
+  for( int r = 0; r < repetitions; ++r )
+  {
+    for( int e = 0; e < numElements; ++e )
+    {
+      double value = 0.0;
+      for( int k = offset[ e ]; k < offset[ e+1 ]; ++k )
+        value += u[ e ] - u[ neighbors[ k ] ];
+      v[ e ] += value;
+    }
+  }
+  const double stencilTime = watch.elapsed();
+
+  // assembly loop: same stencil, but traversing the grid
+  watch.reset();
+  for( int r = 0; r < repetitions; ++r )
+  {
+    for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+    {
+      const int e = gridView.indexSet().index( *it );
+      double value = 0.0;
+      const IntersectionIterator iend = gridView.iend( *it );
+      for( IntersectionIterator iit = gridView.ibegin( *it ); iit != iend; ++iit )
+      {
+        if( iit->neighbor() )
+          value += u[ e ] - u[ gridView.indexSet().index( *iit->outside() ) ];
+      }
+      v[ e ] -= value;
+    }
+  }
+  const double assemblyTime = watch.elapsed();
+
+  double error = 0.0;
+  for( int e = 0; e < numElements; ++e )
+    error = std::max( error, std::abs( v[ e ] ) );
+
+  std::cout << name << " with " << numElements << " elements, "
+            << (ordered ? "Hilbert ordering" : "insertion ordering") << ":" << std::endl;
+  std::cout << "  mean neighbor index distance: " << distance << std::endl;
+  std::cout << "  stencil loop:  " << stencilTime << " seconds" << std::endl;
+  std::cout << "  assembly loop: " << assemblyTime << " seconds"
+            << " (max. deviation " << error << ")" << std::endl;
+
+  Dune::GridFactory< Grid >::destroyGrid( grid );
+}
+
+template< class Grid >
+void benchmark ( const std::string &name, int n, int repetitions )
+{
+  benchmark< Grid >( name, n, repetitions, false );
+  benchmark< Grid >( name, n, repetitions, true );
+}
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  const int n = (argc >= 2 ? std::atoi( argv[ 1 ] ) : 24);
+  const int repetitions = (argc >= 3 ? std::atoi( argv[ 2 ] ) : 10);
+
+#if HAVE_UG
+  benchmark< Dune::UGGrid< 3 > >( "UGGrid< 3 >", n, repetitions );
+#endif
+
+#if HAVE_ALUGRID
+  benchmark< Dune::ALUSimplexGrid< 3, 3 > >( "ALUSimplexGrid< 3, 3 >", n, repetitions );
+#endif
+
+#if !HAVE_UG && !HAVE_ALUGRID
+  std::cerr << "Neither UG nor ALUGrid available, nothing to benchmark." << std::endl;
+#endif
+
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch( ... )
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
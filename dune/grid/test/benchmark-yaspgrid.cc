@@ -0,0 +1,124 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief compare the cost of a loop over all cells of a YaspGrid level
+ *         using the generic level iterator and YaspGrid::forEachCell
+ *
+ *  usage: benchmark-yaspgrid [cells per direction] [repetitions]
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/mpihelper.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+// accumulate a weighted sum of the cell centers into a vector indexed by the cells
+template< int dim >
+struct AccumulateCenters
+{
+  explicit AccumulateCenters ( std::vector< double > &values ) : values_( &values ) {}
+
+  template< class Coord, class Center >
+  void operator() ( int index, const Coord &coord, const Center &center )
+  {
+    double value = 0.0;
+    for( int i = 0; i < dim; ++i )
+      value += (i+1)*center[ i ];
+    (*values_)[ index ] += value;
+  }
+
+private:
+  std::vector< double > *values_;
+};
+
+template< int dim >
+void benchmark ( int n, int repetitions )
+{
+  typedef Dune::YaspGrid< dim > Grid;
+  typedef typename Grid::LevelGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+
+  Dune::FieldVector< double, dim > length( 1.0 );
+  Dune::array< int, dim > size;
+  std::fill( size.begin(), size.end(), n );
+  std::bitset< dim > periodic;
+
+#if HAVE_MPI
+  Grid grid( MPI_COMM_WORLD, length, size, periodic, 1 );
+#else
+  Grid grid( length, size, periodic, 1 );
+#endif
+
+  const GridView gridView = grid.levelGridView( 0 );
+  const int numCells = gridView.indexSet().size( 0 );
+  std::vector< double > iteratorValues( numCells, 0.0 );
+  std::vector< double > loopValues( numCells, 0.0 );
+
+  Dune::Timer watch;
+
+  watch.reset();
+  for( int r = 0; r < repetitions; ++r )
+  {
+    const Iterator end = gridView.template end< 0 >();
+    for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+    {
+      const Dune::FieldVector< double, dim > center = it->geometry().center();
+      double value = 0.0;
+      for( int i = 0; i < dim; ++i )
+        value += (i+1)*center[ i ];
+      iteratorValues[ gridView.indexSet().index( *it ) ] += value;
+    }
+  }
+  const double iteratorTime = watch.elapsed();
+
+  watch.reset();
+  for( int r = 0; r < repetitions; ++r )
+    grid.forEachCell( 0, Dune::All_Partition, AccumulateCenters< dim >( loopValues ) );
+  const double loopTime = watch.elapsed();
+
+  double error = 0.0;
+  for( int k = 0; k < numCells; ++k )
+    error = std::max( error, std::abs( iteratorValues[ k ] - loopValues[ k ] ) );
+
+  std::cout << "YaspGrid< " << dim << " > with " << numCells << " cells, "
+            << repetitions << " repetitions:" << std::endl;
+  std::cout << "  level iterator: " << iteratorTime << " seconds" << std::endl;
+  std::cout << "  forEachCell:    " << loopTime << " seconds" << std::endl;
+  std::cout << "  speedup:        " << (loopTime > 0.0 ? iteratorTime / loopTime : 0.0)
+            << " (max. deviation " << error << ")" << std::endl;
+}
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  const int n = (argc >= 2 ? std::atoi( argv[ 1 ] ) : 64);
+  const int repetitions = (argc >= 3 ? std::atoi( argv[ 2 ] ) : 10);
+
+  benchmark< 2 >( 4*n, repetitions );
+  benchmark< 3 >( n, repetitions );
+
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch( ... )
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
@@ -3,6 +3,9 @@
 #ifndef DUNE_GEOGRID_TEST_FUNCTIONS_HH
 #define DUNE_GEOGRID_TEST_FUNCTIONS_HH
 
+#include <cmath>
+#include <cstddef>
+
 #include <dune/grid/geometrygrid/coordfunction.hh>
 #include <dune/grid/geometrygrid/identity.hh>
 
@@ -25,6 +28,32 @@ namespace Dune
       y[ 1 ] = (x[ 0 ] + 0.2) * sin( 2.0 * M_PI * x[ 1 ] );
       y[ 2 ] = x[ 1 ];
     }
+
+    // evaluate the trigonometric terms for all points first, then scale them
+    void evaluateBatch ( const DomainVector *x, RangeVector *y, std::size_t n ) const
+    {
+      for( std::size_t i = 0; i < n; ++i )
+      {
+        const double angle = 2.0 * M_PI * x[ i ][ 1 ];
+        y[ i ][ 0 ] = cos( angle );
+        y[ i ][ 1 ] = sin( angle );
+        y[ i ][ 2 ] = x[ i ][ 1 ];
+      }
+      for( std::size_t i = 0; i < n; ++i )
+      {
+        const double radius = x[ i ][ 0 ] + 0.2;
+        y[ i ][ 0 ] *= radius;
+        y[ i ][ 1 ] *= radius;
+      }
+      batchedPoints() += n;
+    }
+
+    //! number of points evaluated by evaluateBatch so far
+    static std::size_t &batchedPoints ()
+    {
+      static std::size_t count = 0;
+      return count;
+    }
   };
 
 
@@ -7,9 +7,13 @@
 
 #define DISABLE_DEPRECATED_METHOD_CHECK 1
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <dune/common/tupleutility.hh>
 #include <dune/common/tuples.hh>
@@ -18,6 +22,7 @@
 
 #include <dune/grid/io/file/dgfparser/dgfalu.hh>
 #include <dune/grid/io/file/dgfparser/dgfwriter.hh>
+#include <dune/grid/utility/persistentcontainer.hh>
 
 #include "gridcheck.cc"
 
@@ -519,6 +524,236 @@ void checkALUParallel(GridType & grid, int gref, int mxl = 3)
 }
 
 
+// the codim 0 leaf and level iterators walk the element hierarchy
+// themselves, they have to visit the same elements in the same order as
+// ALUGrid's own iterators
+template <class GridType>
+void checkElementWalker ( const GridType &grid )
+{
+  typedef typename GridType :: MPICommunicatorType Comm;
+  typedef typename ALU3dBasicImplTraits< Comm > :: HElementType HElementType;
+  typedef typename GridType :: template Codim< 0 > :: template Partition< Interior_Partition > :: LeafIterator DuneLeafIterator;
+  typedef typename GridType :: template Codim< 0 > :: template Partition< Interior_Partition > :: LevelIterator DuneLevelIterator;
+
+  std::vector< const HElementType * > elements;
+  ALU3DSPACE LeafIterator< HElementType > leafIt( grid.myGrid() );
+  for( leafIt->first(); !leafIt->done(); leafIt->next() )
+    elements.push_back( &leafIt->item() );
+
+  std::size_t k = 0;
+  const DuneLeafIterator leafEnd = grid.template leafend< 0, Interior_Partition >();
+  for( DuneLeafIterator it = grid.template leafbegin< 0, Interior_Partition >(); it != leafEnd; ++it, ++k )
+  {
+    const HElementType *item = &GridType :: getRealImplementation( *it ).getItem();
+    if( (k >= elements.size()) || (elements[ k ] != item) )
+      DUNE_THROW( GridError, "Leaf iterator differs from ALUGrid's leaf iterator at element " << k );
+  }
+  if( k != elements.size() )
+    DUNE_THROW( GridError, "Leaf iterator visits " << k << " instead of " << elements.size() << " elements" );
+
+  for( int level = 0; level <= grid.maxLevel(); ++level )
+  {
+    elements.clear();
+    ALU3DSPACE LevelIterator< HElementType > levelIt( grid.myGrid(), level );
+    for( levelIt->first(); !levelIt->done(); levelIt->next() )
+      elements.push_back( &levelIt->item() );
+
+    k = 0;
+    const DuneLevelIterator levelEnd = grid.template lend< 0, Interior_Partition >( level );
+    for( DuneLevelIterator it = grid.template lbegin< 0, Interior_Partition >( level ); it != levelEnd; ++it, ++k )
+    {
+      const HElementType *item = &GridType :: getRealImplementation( *it ).getItem();
+      if( (k >= elements.size()) || (elements[ k ] != item) )
+        DUNE_THROW( GridError, "Level iterator differs from ALUGrid's level iterator at element " << k << " of level " << level );
+    }
+    if( k != elements.size() )
+      DUNE_THROW( GridError, "Level iterator visits " << k << " instead of " << elements.size() << " elements on level " << level );
+  }
+}
+
+// weight of a macro element, growing in x-direction
+struct LinearWeight
+{
+  template <class Entity>
+  double weight ( const Entity &entity ) const
+  {
+    return 1.0 + 4.0 * entity.geometry().center()[ 0 ];
+  }
+};
+
+// sum of the volumes and the number of the interior macro elements
+template <class GridType>
+std::pair< double, int > macroVolume ( const GridType &grid )
+{
+  typedef typename GridType :: LevelGridView MacroView;
+  typedef typename MacroView :: template Codim< 0 > :: template Partition< Interior_Partition > :: Iterator Iterator;
+
+  std::pair< double, int > result( 0.0, 0 );
+  const MacroView macroView = grid.levelGridView( 0 );
+  const Iterator end = macroView.template end< 0, Interior_Partition >();
+  for( Iterator it = macroView.template begin< 0, Interior_Partition >(); it != end; ++it )
+  {
+    result.first += it->geometry().volume();
+    ++result.second;
+  }
+  result.first = grid.comm().sum( result.first );
+  result.second = grid.comm().sum( result.second );
+  return result;
+}
+
+template <class GridType>
+void checkRepartition ( const GridType &grid )
+{
+  const ALU3dGridSFCPartitioner partitioner;
+  const LinearWeight weights;
+
+  GridType *newGrid = repartitionMacroGrid( grid, partitioner, weights );
+
+  const std::pair< double, int > oldVolume = macroVolume( grid );
+  const std::pair< double, int > newVolume = macroVolume( *newGrid );
+  if( newVolume.second != oldVolume.second )
+    DUNE_THROW( GridError, "repartitionMacroGrid changed the number of macro elements from "
+                << oldVolume.second << " to " << newVolume.second );
+  if( std::abs( newVolume.first - oldVolume.first ) > 1e-8 * oldVolume.first )
+    DUNE_THROW( GridError, "repartitionMacroGrid changed the volume of the domain" );
+
+  // the new grid is distributed as proposed by the partitioner
+  if( newGrid->weightedLoadImbalanced( partitioner, weights ) )
+    DUNE_THROW( GridError, "weighted load imbalanced after repartitionMacroGrid" );
+
+  checkCommunication( *newGrid, -1, Dune::dvverb );
+  delete newGrid;
+}
+
+// the indices of the leaf entities of codimension codim have to be 0, ..., size-1
+template <int codim, class GridType>
+void checkLeafIndices ( const GridType &grid, const std::string &name )
+{
+  typedef typename GridType :: LeafGridView GridView;
+  typedef typename GridView :: template Codim< codim > :: Iterator Iterator;
+
+  const GridView gridView = grid.leafGridView();
+  std::vector< bool > used( gridView.size( codim ), false );
+  const Iterator end = gridView.template end< codim >();
+  for( Iterator it = gridView.template begin< codim >(); it != end; ++it )
+  {
+    const int index = gridView.indexSet().index( *it );
+    if( (index < 0) || (index >= int( used.size() )) || used[ index ] )
+      DUNE_THROW( GridError, name << ": invalid or duplicate leaf index " << index << " in codimension " << codim );
+    used[ index ] = true;
+  }
+  if( std::find( used.begin(), used.end(), false ) != used.end() )
+    DUNE_THROW( GridError, name << ": leaf indices of codimension " << codim << " are not consecutive" );
+}
+
+// store the level 0 index + 1 of each macro element, new elements get 0
+template <class GridType, class Container>
+void fillMacroData ( const GridType &grid, Container &container )
+{
+  typedef typename GridType :: LevelGridView MacroView;
+  typedef typename MacroView :: template Codim< 0 > :: Iterator Iterator;
+
+  const MacroView macroView = grid.levelGridView( 0 );
+  const Iterator end = macroView.template end< 0 >();
+  for( Iterator it = macroView.template begin< 0 >(); it != end; ++it )
+    container[ *it ] = macroView.indexSet().index( *it ) + 1;
+}
+
+// the macro data has to survive the refinement and the new elements have to
+// hold the default value
+template <class GridType, class Container>
+void checkMacroData ( const GridType &grid, const Container &container, const std::string &name )
+{
+  typedef typename GridType :: LeafGridView GridView;
+  typedef typename GridView :: template Codim< 0 > :: Iterator Iterator;
+  typedef typename GridType :: template Codim< 0 > :: EntityPointer EntityPointer;
+
+  const GridView gridView = grid.leafGridView();
+  const Iterator end = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    if( it->level() == 0 )
+      continue;
+    if( container[ *it ] != 0 )
+      DUNE_THROW( GridError, name << ": new element has data in the persistent container" );
+    EntityPointer father = it->father();
+    while( father->level() > 0 )
+      father = father->father();
+    if( container[ *father ] != grid.levelIndexSet( 0 ).index( *father ) + 1 )
+      DUNE_THROW( GridError, name << ": data of a macro element lost in the persistent container" );
+  }
+}
+
+// globalRefine refines all levels inside ALUGrid and updates the DUNE
+// structures once; it has to yield the same grid as refCount rounds of
+// marking all leaf elements and adapting
+template <class GridType>
+void checkGlobalRefine ( const std::string &filename, const int refCount )
+{
+  typedef typename GridType :: template Codim< 0 > :: template Partition< Interior_Partition > :: LeafIterator LeafIterator;
+  typedef PersistentContainer< GridType, int > Container;
+
+  std::cout << "Check globalRefine( " << refCount << " ) against mark and adapt" << std::endl;
+
+  GridPtr< GridType > globalGridPtr( filename );
+  GridPtr< GridType > markedGridPtr( filename );
+  GridType &globalGrid = *globalGridPtr;
+  GridType &markedGrid = *markedGridPtr;
+
+  // the index sets and containers in use have to be updated by the refinement
+  globalGrid.leafIndexSet();
+  globalGrid.levelIndexSet( 0 );
+  markedGrid.leafIndexSet();
+  markedGrid.levelIndexSet( 0 );
+
+  Container globalData( globalGrid, 0 ), markedData( markedGrid, 0 );
+  fillMacroData( globalGrid, globalData );
+  fillMacroData( markedGrid, markedData );
+
+  globalGrid.globalRefine( refCount );
+
+  for( int count = 0; count < refCount; ++count )
+  {
+    const LeafIterator end = markedGrid.template leafend< 0, Interior_Partition >();
+    for( LeafIterator it = markedGrid.template leafbegin< 0, Interior_Partition >(); it != end; ++it )
+      markedGrid.mark( 1, *it );
+    markedGrid.preAdapt();
+    markedGrid.adapt();
+    markedGrid.postAdapt();
+  }
+
+  globalData.resize();
+  markedData.resize();
+
+  if( globalGrid.maxLevel() != markedGrid.maxLevel() )
+    DUNE_THROW( GridError, "globalRefine yields maxLevel " << globalGrid.maxLevel()
+                                                           << " instead of " << markedGrid.maxLevel() );
+  for( int codim = 0; codim <= GridType :: dimension; ++codim )
+  {
+    if( globalGrid.size( codim ) != markedGrid.size( codim ) )
+      DUNE_THROW( GridError, "globalRefine yields " << globalGrid.size( codim ) << " leaf entities of codimension "
+                                                    << codim << " instead of " << markedGrid.size( codim ) );
+    for( int level = 0; level <= globalGrid.maxLevel(); ++level )
+    {
+      if( globalGrid.size( level, codim ) != markedGrid.size( level, codim ) )
+        DUNE_THROW( GridError, "globalRefine yields " << globalGrid.size( level, codim ) << " entities of codimension "
+                                                      << codim << " on level " << level << " instead of "
+                                                      << markedGrid.size( level, codim ) );
+    }
+  }
+
+  checkLeafIndices< 0 >( globalGrid, "globalRefine" );
+  checkLeafIndices< GridType :: dimension >( globalGrid, "globalRefine" );
+  checkLeafIndices< 0 >( markedGrid, "adapt" );
+  checkLeafIndices< GridType :: dimension >( markedGrid, "adapt" );
+
+  if( globalData.size() != markedData.size() )
+    DUNE_THROW( GridError, "persistent container has size " << globalData.size() << " after globalRefine instead of "
+                                                            << markedData.size() );
+  checkMacroData( globalGrid, globalData, "globalRefine" );
+  checkMacroData( markedGrid, markedData, "adapt" );
+}
+
 int main (int argc , char **argv) {
 
   // this method calls MPI_Init, if MPI is enabled
@@ -707,9 +942,11 @@ int main (int argc , char **argv) {
 
         typedef ALUGrid<3,3, cube, nonconforming > GridType;
         //typedef ALUCubeGrid<3,3> GridType;
+        checkGlobalRefine< GridType >( filename, 2 );
         GridPtr<GridType> gridPtr(filename);
         GridType & grid = *gridPtr;
         grid.loadBalance();
+        checkRepartition( grid );
 
         checkCapabilities< false >( grid );
 
@@ -718,6 +955,7 @@ int main (int argc , char **argv) {
           checkALUSerial(grid,
                          (mysize == 1) ? 1 : 0,
                          (mysize == 1) ? display : false);
+          checkElementWalker(grid);
         }
 
         // perform parallel check only when more then one proc
@@ -740,9 +978,11 @@ int main (int argc , char **argv) {
 
         typedef ALUGrid<3,3, simplex, nonconforming > GridType;
         //typedef ALUSimplexGrid<3,3> GridType;
+        checkGlobalRefine< GridType >( filename, 2 );
         GridPtr<GridType> gridPtr(filename);
         GridType & grid = *gridPtr;
         grid.loadBalance();
+        checkRepartition( grid );
         checkCapabilities< false >( grid );
 
         {
@@ -750,6 +990,7 @@ int main (int argc , char **argv) {
           checkALUSerial(grid,
                          (mysize == 1) ? 1 : 0,
                          (mysize == 1) ? display : false);
+          checkElementWalker(grid);
         }
 
         // perform parallel check only when more then one proc
@@ -782,6 +1023,7 @@ int main (int argc , char **argv) {
           checkALUSerial(grid,
                          (mysize == 1) ? 1 : 0,
                          (mysize == 1) ? display : false);
+          checkElementWalker(grid);
         }
 
         // perform parallel check only when more then one proc
@@ -21,6 +21,7 @@
 #include <dune/grid/geometrygrid.hh>
 #include <dune/grid/geometrygrid/cachedcoordfunction.hh>
 #include <dune/grid/io/file/dgfparser/dgfgeogrid.hh>
+#include <dune/grid/utility/hostgridaccess.hh>
 
 #include "functions.hh"
 
@@ -71,6 +72,108 @@ typedef Dune::GeometryGrid< Grid, CoordFunction, __gnu_cxx::__pool_alloc<char> >
 #endif
 typedef Dune::GeometryGrid< Grid, CoordFunction, Dune::DebugAllocator<char> > GeometryGridWithDebugAllocator;
 
+// only Helix counts its batched evaluations
+template< class Function >
+bool evaluatedInBatches ( const Function &, std::size_t ) { return true; }
+
+bool evaluatedInBatches ( const Dune::Helix &, std::size_t before )
+{
+  return (Dune::Helix::batchedPoints() > before);
+}
+
+// the cache is built by batched evaluation; compare the cached vertex
+// coordinates with pointwise evaluation
+void checkBatchedCache ( const Grid &hostGrid )
+{
+  typedef Grid::LevelGridView LevelView;
+  typedef LevelView::Codim< Grid::dimension >::Partition< Dune::All_Partition >::Iterator VertexIterator;
+  typedef AnalyticalCoordFunction::RangeVector RangeVector;
+
+  AnalyticalCoordFunction coordFunction;
+  const std::size_t before = Dune::Helix::batchedPoints();
+  const Dune::CachedCoordFunction< Grid, AnalyticalCoordFunction > cached( hostGrid, coordFunction );
+  if( !evaluatedInBatches( coordFunction, before ) )
+    DUNE_THROW( Dune::Exception, "Cache was not built by batched evaluation." );
+
+  for( int level = 0; level <= hostGrid.maxLevel(); ++level )
+  {
+    const LevelView levelView = hostGrid.levelGridView( level );
+    const VertexIterator end = levelView.end< Grid::dimension, Dune::All_Partition >();
+    for( VertexIterator it = levelView.begin< Grid::dimension, Dune::All_Partition >(); it != end; ++it )
+    {
+      RangeVector y, z;
+      cached.evaluate( *it, 0, y );
+      coordFunction.evaluate( it->geometry().corner( 0 ), z );
+      if( (y - z).two_norm() > 1e-12 )
+        DUNE_THROW( Dune::Exception, "Cached corner " << y << " differs from pointwise evaluation " << z << "." );
+    }
+  }
+}
+
+// coordinate function whose image can be translated after the grid was set up
+class MovingCoordFunction
+  : public Dune::AnalyticalCoordFunction< double, AnalyticalCoordFunction::dimDomain, AnalyticalCoordFunction::dimRange, MovingCoordFunction >
+{
+  typedef MovingCoordFunction This;
+  typedef Dune::AnalyticalCoordFunction< double, AnalyticalCoordFunction::dimDomain, AnalyticalCoordFunction::dimRange, This > Base;
+
+public:
+  typedef Base::DomainVector DomainVector;
+  typedef Base::RangeVector RangeVector;
+
+  MovingCoordFunction () : shift_( 0.0 ) {}
+
+  void evaluate ( const DomainVector &x, RangeVector &y ) const
+  {
+    function_.evaluate( x, y );
+    y += shift_;
+  }
+
+  void move ( const RangeVector &shift ) { shift_ += shift; }
+
+private:
+  AnalyticalCoordFunction function_;
+  RangeVector shift_;
+};
+
+// after moving the coordinates and calling update(), the cached geometries
+// have to be recomputed
+void checkMovedGeometryCache ( Grid &hostGrid )
+{
+  typedef Dune::GeometryGrid< Grid, MovingCoordFunction > MovingGeometryGrid;
+  typedef MovingGeometryGrid::LeafGridView GridView;
+  typedef GridView::Codim< 0 >::Iterator Iterator;
+  typedef GridView::Codim< 0 >::Geometry Geometry;
+  typedef Dune::HostGridAccess< MovingGeometryGrid >::Codim< 0 >::HostEntity HostElement;
+  typedef MovingCoordFunction::RangeVector RangeVector;
+
+  MovingCoordFunction coordFunction;
+  MovingGeometryGrid geogrid( hostGrid, coordFunction );
+  geogrid.enableGeometryCache( true );
+
+  const GridView gridView = geogrid.leafGridView();
+  const Iterator end = gridView.end< 0 >();
+  for( Iterator it = gridView.begin< 0 >(); it != end; ++it )
+    it->geometry();
+
+  coordFunction.move( RangeVector( 0.5 ) );
+  geogrid.update();
+
+  for( Iterator it = gridView.begin< 0 >(); it != end; ++it )
+  {
+    const Geometry geometry = it->geometry();
+    const HostElement &hostElement = Dune::HostGridAccess< MovingGeometryGrid >::hostEntity( *it );
+    for( int i = 0; i < geometry.corners(); ++i )
+    {
+      RangeVector y;
+      coordFunction.evaluate( hostElement.geometry().corner( i ), y );
+      y -= geometry.corner( i );
+      if( y.two_norm() > 1e-12 )
+        DUNE_THROW( Dune::Exception, "Cached geometry not updated after moving the coordinates." );
+    }
+  }
+}
+
 template <class GeometryGridType>
 void test(const std::string& gridfile)
 {
@@ -80,6 +183,9 @@ void test(const std::string& gridfile)
   geogrid.globalRefine( 1 );
   geogrid.loadBalance();
 
+  std::cerr << "Checking batched evaluation..." << std::endl;
+  checkBatchedCache( geogrid.hostGrid() );
+
   std::cerr << "Checking grid..." << std::endl;
   gridcheck( geogrid );
 
@@ -104,6 +210,15 @@ void test(const std::string& gridfile)
   std::cerr << "Checking geometry lifetime..." << std::endl;
   checkGeometryLifetime( geogrid.leafGridView() );
 
+  std::cerr << "Checking cached geometry..." << std::endl;
+  geogrid.enableGeometryCache( true );
+  checkGeometry( geogrid.leafGridView() );
+  for( int i = 0; i <= geogrid.maxLevel(); ++i )
+    checkGeometry( geogrid.levelGridView( i ) );
+  checkGeometryLifetime( geogrid.leafGridView() );
+  geogrid.enableGeometryCache( false );
+  checkMovedGeometryCache( geogrid.hostGrid() );
+
   std::cerr << "Checking communication..." << std::endl;
   checkCommunication( geogrid, -1, std::cout );
   if( EnableLevelIntersectionIteratorCheck< Grid >::v )
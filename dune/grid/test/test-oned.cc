@@ -4,6 +4,9 @@
 
 #include <config.h>
 
+#include <algorithm>
+#include <cmath>
+#include <set>
 #include <vector>
 #include <memory>
 
@@ -13,6 +16,8 @@
 #include "checkgeometryinfather.cc"
 #include "checkintersectionit.cc"
 #include "checkadaptation.cc"
+#include "checkcommunicate.cc"
+#include "checkpartition.cc"
 
 using namespace Dune;
 
@@ -132,6 +137,66 @@ OneDGrid* testFactory()
   return grid;
 }
 
+// The leaf indices are updated incrementally during adaptation:
+// make sure they are consecutive and contains() agrees with the leaf iterators
+template <int codim>
+void checkLeafIndices(const OneDGrid& grid)
+{
+  typedef OneDGrid::LeafGridView::IndexSet IndexSet;
+  const IndexSet& indexSet = grid.leafIndexSet();
+
+  std::vector<bool> used(indexSet.size(codim), false);
+  typedef OneDGrid::Codim<codim>::LeafIterator LeafIterator;
+  for (LeafIterator it = grid.leafbegin<codim>(); it != grid.leafend<codim>(); ++it) {
+    const int index = indexSet.index(*it);
+    if (index < 0 || index >= indexSet.size(codim) || used[index])
+      DUNE_THROW(GridError, "Leaf index " << index << " of codim " << codim << " is invalid or used twice.");
+    used[index] = true;
+    if (!indexSet.contains(*it))
+      DUNE_THROW(GridError, "Leaf entity is not contained in the leaf index set.");
+  }
+  if (std::find(used.begin(), used.end(), false) != used.end())
+    DUNE_THROW(GridError, "Leaf indices of codim " << codim << " are not consecutive.");
+
+  // each leaf entity is contained exactly once in the hierarchy
+  int contained = 0;
+  typedef OneDGrid::Codim<codim>::LevelIterator LevelIterator;
+  for (int level = 0; level <= grid.maxLevel(); level++)
+    for (LevelIterator it = grid.lbegin<codim>(level); it != grid.lend<codim>(level); ++it)
+      if (indexSet.contains(*it))
+        contained++;
+  if (contained != indexSet.size(codim))
+    DUNE_THROW(GridError, "contains() of the leaf index set is true for " << contained
+               << " entities of codim " << codim << " instead of " << indexSet.size(codim) << ".");
+}
+
+void checkLeafIndices(OneDGrid& grid)
+{
+  checkLeafIndices<0>(grid);
+  checkLeafIndices<1>(grid);
+
+  // refine every other leaf element, then coarsen part of the new elements again
+  int count = 0;
+  for (OneDGrid::Codim<0>::LeafIterator it = grid.leafbegin<0>(); it != grid.leafend<0>(); ++it)
+    if (count++ % 2 == 0)
+      grid.mark(1, *it);
+  grid.preAdapt();
+  grid.adapt();
+  grid.postAdapt();
+  checkLeafIndices<0>(grid);
+  checkLeafIndices<1>(grid);
+
+  count = 0;
+  for (OneDGrid::Codim<0>::LeafIterator it = grid.leafbegin<0>(); it != grid.leafend<0>(); ++it)
+    if (it->level() > 0 && count++ % 4 < 2)
+      grid.mark(-1, *it);
+  grid.preAdapt();
+  grid.adapt();
+  grid.postAdapt();
+  checkLeafIndices<0>(grid);
+  checkLeafIndices<1>(grid);
+}
+
 void testOneDGrid(OneDGrid& grid)
 {
   // check macro grid
@@ -160,10 +225,156 @@ void testOneDGrid(OneDGrid& grid)
   checkIntersectionIterator(grid);
 
   checkAdaptation( grid );
+
+  checkLeafIndices( grid );
 }
 
-int main () try
+/** \brief Sends id, position and partition type of the entities to their copies
+
+    The receiving process checks that its copy has the same id and position,
+    and that no entity is owned by two processes.
+ */
+class IdPartitionHandle
+  : public CommDataHandleIF<IdPartitionHandle, double>
 {
+public:
+  explicit IdPartitionHandle (const OneDGrid& grid)
+    : idSet_(grid.globalIdSet()), errors_(0)
+  {}
+
+  bool contains (int dim, int codim) const { return true; }
+
+  bool fixedsize (int dim, int codim) const { return true; }
+
+  template<class EntityType>
+  size_t size (const EntityType& e) const { return 3; }
+
+  template<class MessageBuffer, class EntityType>
+  void gather (MessageBuffer& buff, const EntityType& e) const
+  {
+    buff.write(double(idSet_.id(e)));
+    buff.write(e.geometry().center()[0]);
+    buff.write(double(e.partitionType()));
+  }
+
+  template<class MessageBuffer, class EntityType>
+  void scatter (MessageBuffer& buff, const EntityType& e, size_t n)
+  {
+    double id, center, partitionType;
+    buff.read(id);
+    buff.read(center);
+    buff.read(partitionType);
+
+    if (id != double(idSet_.id(e)) || std::abs(center - e.geometry().center()[0]) > 1e-12)
+      ++errors_;
+
+    const bool ownedHere = (e.partitionType() == InteriorEntity);
+    const bool ownedThere = (PartitionType(int(partitionType)) == InteriorEntity);
+    if (ownedHere && ownedThere)
+      ++errors_;
+
+    if (ownedThere && EntityType::codimension == 0)
+      received_.insert(idSet_.id(e));
+  }
+
+  int errors () const { return errors_; }
+
+  //! Whether the element with the given id has received data from its owner
+  bool receivedFromOwner (OneDGrid::GlobalIdSet::IdType id) const { return received_.count(id) > 0; }
+
+private:
+  const OneDGrid::GlobalIdSet& idSet_;
+  int errors_;
+  std::set<OneDGrid::GlobalIdSet::IdType> received_;
+};
+
+/** \brief Check ids and partition types of a distributed grid by communicating with all copies */
+void checkDistributedIds(const OneDGrid& grid, int expectedLeafElements)
+{
+  typedef OneDGrid::LeafGridView GridView;
+  typedef GridView::Codim<0>::Iterator Iterator;
+
+  const GridView gridView = grid.leafGridView();
+
+  IdPartitionHandle handle(grid);
+  gridView.communicate(handle, All_All_Interface, ForwardCommunication);
+  if (handle.errors() > 0)
+    DUNE_THROW(GridError, handle.errors() << " entities disagree with their copies on id, position or owner");
+
+  // Each ghost element has to have a copy on a neighbor, each leaf element
+  // has to be owned by exactly one process
+  int interiorElements = 0;
+  std::set<OneDGrid::GlobalIdSet::IdType> interiorIds;
+  for (Iterator it = gridView.begin<0>(); it != gridView.end<0>(); ++it) {
+    if (it->partitionType() == GhostEntity && !handle.receivedFromOwner(grid.globalIdSet().id(*it)))
+      DUNE_THROW(GridError, "Ghost element without owner");
+    if (it->partitionType() == InteriorEntity) {
+      ++interiorElements;
+      interiorIds.insert(grid.globalIdSet().id(*it));
+    }
+  }
+  if (int(interiorIds.size()) != interiorElements)
+    DUNE_THROW(GridError, "Duplicate element ids");
+  if (grid.comm().sum(interiorElements) != expectedLeafElements)
+    DUNE_THROW(GridError, "Wrong number of interior leaf elements: " << grid.comm().sum(interiorElements)
+               << " instead of " << expectedLeafElements);
+}
+
+void testDistributedOneDGrid(Dune::MPIHelper& mpiHelper)
+{
+  // A uniform grid with four elements per process
+  Dune::OneDGrid grid(mpiHelper.getCommunicator(),
+                      4*mpiHelper.size(), // Number of elements
+                      -0.5,               // Left boundary
+                      2.3                 // Right boundary
+                      );
+
+  gridcheck(grid);
+
+  grid.globalRefine(1);
+  gridcheck(grid);
+
+  // check communication interface
+  checkCommunication(grid,-1,Dune::dvverb);
+  for (int l=0; l<=grid.maxLevel(); ++l)
+    checkCommunication(grid,l,Dune::dvverb);
+  checkPartitionType( grid.leafGridView() );
+
+  // Refine the interior elements of the first process twice more
+  for (int i=0; i<2; i++) {
+    typedef OneDGrid::Codim<0>::Partition<Dune::Interior_Partition>::LeafIterator Iterator;
+    if (mpiHelper.rank() == 0)
+      for (Iterator it = grid.leafbegin<0,Dune::Interior_Partition>(); it != grid.leafend<0,Dune::Interior_Partition>(); ++it)
+        grid.mark(1, *it);
+    grid.preAdapt();
+    grid.adapt();
+    grid.postAdapt();
+  }
+  gridcheck(grid);
+  checkCommunication(grid,-1,Dune::dvverb);
+
+  // The number of leaf elements does not change when moving elements
+  typedef OneDGrid::Codim<0>::Partition<Dune::Interior_Partition>::LeafIterator InteriorIterator;
+  int leafElements = 0;
+  for (InteriorIterator it = grid.leafbegin<0,Dune::Interior_Partition>(); it != grid.leafend<0,Dune::Interior_Partition>(); ++it)
+    ++leafElements;
+  leafElements = grid.comm().sum(leafElements);
+  checkDistributedIds(grid, leafElements);
+
+  // Move elements away from the first process
+  grid.loadBalance();
+  gridcheck(grid);
+  checkDistributedIds(grid, leafElements);
+  checkCommunication(grid,-1,Dune::dvverb);
+  for (int l=0; l<=grid.maxLevel(); ++l)
+    checkCommunication(grid,l,Dune::dvverb);
+  checkPartitionType( grid.leafGridView() );
+}
+
+int main (int argc, char** argv) try
+{
+  Dune::MPIHelper& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
   // Create a OneDGrid using the grid factory and test it
   std::auto_ptr<Dune::OneDGrid> factoryGrid(testFactory());
 
@@ -200,6 +411,8 @@ int main () try
 
   testOneDGrid(uniformGrid2);
 
+  // Test a OneDGrid distributed over all processes
+  testDistributedOneDGrid(mpiHelper);
 
   // everything okay
   return 0;
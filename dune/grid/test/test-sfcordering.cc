@@ -0,0 +1,287 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+ *  \brief check the insertion indices of grid factories that reorder the
+ *         macro elements along a Hilbert curve
+ *
+ *  The simplices of a triangulated cube are inserted in a known (shuffled)
+ *  order. After creating the grid with and without orderElementsAlongCurve(),
+ *  insertionIndex has to map each macro element and vertex back to the data
+ *  inserted for it. Moreover, neighboring elements have to be closer to each
+ *  other in the traversal order along the curve than in the shuffled order.
+ */
+
+#include <config.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/grid/common/gridfactory.hh>
+
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+#if HAVE_ALBERTA
+#include <dune/grid/albertagrid.hh>
+#include <dune/grid/albertagrid/gridfactory.hh>
+#endif
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#endif
+
+#ifndef ALBERTA_DIM
+#define ALBERTA_DIM 2
+#endif
+
+// Kuhn triangulation of the unit cube with n cells per direction, the
+// elements are shuffled to simulate the output of a mesh generator
+template< int dim >
+struct CubeTriangulation
+{
+  typedef Dune::FieldVector< double, dim > Vertex;
+  typedef std::vector< unsigned int > Element;
+
+  explicit CubeTriangulation ( int n )
+  {
+    int stride[ dim ];
+    int numVertices = 1;
+    for( int j = 0; j < dim; ++j )
+    {
+      stride[ j ] = numVertices;
+      numVertices *= n+1;
+    }
+
+    for( int v = 0; v < numVertices; ++v )
+    {
+      Vertex x;
+      for( int j = 0; j < dim; ++j )
+        x[ j ] = double( (v / stride[ j ]) % (n+1) ) / n;
+      vertices.push_back( x );
+    }
+
+    for( int v = 0; v < numVertices; ++v )
+    {
+      // only vertices with a cell in positive direction
+      bool lower = true;
+      for( int j = 0; j < dim; ++j )
+        lower &= ((v / stride[ j ]) % (n+1) < n);
+      if( !lower )
+        continue;
+
+      int permutation[ dim ];
+      for( int j = 0; j < dim; ++j )
+        permutation[ j ] = j;
+      do
+      {
+        Element element( dim+1 );
+        element[ 0 ] = v;
+        for( int j = 0; j < dim; ++j )
+          element[ j+1 ] = element[ j ] + stride[ permutation[ j ] ];
+
+        // make sure the simplex is positively oriented
+        Dune::FieldMatrix< double, dim, dim > jacobian;
+        for( int j = 0; j < dim; ++j )
+        {
+          jacobian[ j ] = vertices[ element[ j+1 ] ];
+          jacobian[ j ] -= vertices[ element[ 0 ] ];
+        }
+        if( jacobian.determinant() < 0 )
+          std::swap( element[ dim-1 ], element[ dim ] );
+        elements.push_back( element );
+      }
+      while( std::next_permutation( permutation, permutation + dim ) );
+    }
+
+    // shuffle the elements (using a simple, reproducible linear congruential generator)
+    unsigned long seed = 42;
+    for( std::size_t k = elements.size(); k > 1; --k )
+    {
+      seed = (seed * 1103515245ul + 12345ul) % 2147483648ul;
+      std::swap( elements[ k-1 ], elements[ seed % k ] );
+    }
+  }
+
+  Vertex center ( std::size_t k ) const
+  {
+    Vertex c( 0 );
+    for( int i = 0; i <= dim; ++i )
+      c += vertices[ elements[ k ][ i ] ];
+    c /= double( dim+1 );
+    return c;
+  }
+
+  std::vector< Vertex > vertices;
+  std::vector< Element > elements;
+};
+
+// mean distance in the traversal order of face neighbors in the macro grid
+template< class Grid, class Factory >
+double meanNeighborDistance ( const Grid &grid, const Factory &factory )
+{
+  // the macro grid has not been refined, so the leaf grid can be used
+  typedef typename Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator ElementIterator;
+  typedef typename GridView::IntersectionIterator IntersectionIterator;
+
+  const GridView gridView = grid.leafGridView();
+  const ElementIterator end = gridView.template end< 0 >();
+
+  std::vector< int > position( gridView.size( 0 ) );
+  int p = 0;
+  for( ElementIterator it = gridView.template begin< 0 >(); it != end; ++it, ++p )
+    position[ factory.insertionIndex( *it ) ] = p;
+
+  long sum = 0, count = 0;
+  for( ElementIterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    const int inside = position[ factory.insertionIndex( *it ) ];
+    const IntersectionIterator iend = gridView.iend( *it );
+    for( IntersectionIterator iit = gridView.ibegin( *it ); iit != iend; ++iit )
+    {
+      if( !iit->neighbor() )
+        continue;
+      sum += std::abs( position[ factory.insertionIndex( *iit->outside() ) ] - inside );
+      ++count;
+    }
+  }
+  return (count > 0 ? double( sum ) / double( count ) : 0.0);
+}
+
+// returns the mean neighbor distance in the traversal order of the macro grid
+template< class Grid >
+double checkInsertionIndices ( const std::string &name, bool ordered )
+{
+  const int dim = Grid::dimension;
+  typedef typename Grid::LevelGridView MacroView;
+  typedef typename MacroView::template Codim< 0 >::Iterator ElementIterator;
+  typedef typename MacroView::template Codim< dim >::Iterator VertexIterator;
+  typedef CubeTriangulation< dim > Triangulation;
+
+  std::cout << "Checking insertion indices for " << name
+            << (ordered ? " with Hilbert ordering" : " with insertion ordering") << std::endl;
+
+  const Triangulation triangulation( 4 );
+  const std::size_t numElements = triangulation.elements.size();
+  const std::size_t numVertices = triangulation.vertices.size();
+
+  Dune::GridFactory< Grid > factory;
+  if( ordered )
+    factory.orderElementsAlongCurve();
+  for( std::size_t i = 0; i < numVertices; ++i )
+    factory.insertVertex( triangulation.vertices[ i ] );
+  const Dune::GeometryType simplex( Dune::GeometryType::simplex, dim );
+  for( std::size_t k = 0; k < numElements; ++k )
+    factory.insertElement( simplex, triangulation.elements[ k ] );
+  Grid *grid = factory.createGrid();
+
+  const MacroView macroView = grid->levelGridView( 0 );
+  if( (std::size_t( macroView.size( 0 ) ) != numElements) || (std::size_t( macroView.size( dim ) ) != numVertices) )
+    DUNE_THROW( Dune::GridError, name << ": wrong number of macro entities" );
+
+  // each macro element has to have the vertices and center of the inserted element
+  std::vector< bool > found( numElements, false );
+  std::size_t position = 0, reordered = 0;
+  const ElementIterator end = macroView.template end< 0 >();
+  for( ElementIterator it = macroView.template begin< 0 >(); it != end; ++it, ++position )
+  {
+    const unsigned int k = factory.insertionIndex( *it );
+    if( (k >= numElements) || found[ k ] )
+      DUNE_THROW( Dune::GridError, name << ": invalid or duplicate element insertion index " << k );
+    found[ k ] = true;
+    if( k != position )
+      ++reordered;
+
+    std::vector< unsigned int > corners, inserted( triangulation.elements[ k ] );
+    for( int i = 0; i < it->template count< dim >(); ++i )
+      corners.push_back( factory.insertionIndex( *it->template subEntity< dim >( i ) ) );
+    std::sort( corners.begin(), corners.end() );
+    std::sort( inserted.begin(), inserted.end() );
+    if( corners != inserted )
+      DUNE_THROW( Dune::GridError, name << ": element " << k << " has wrong vertices" );
+
+    typename Triangulation::Vertex distance = it->geometry().center();
+    distance -= triangulation.center( k );
+    if( distance.two_norm() > 1e-8 )
+      DUNE_THROW( Dune::GridError, name << ": element " << k << " has a wrong center" );
+  }
+
+  // the shuffled elements have to be reordered along the curve
+  if( ordered && (reordered == 0) )
+    DUNE_THROW( Dune::GridError, name << ": elements were not reordered" );
+
+  // each vertex has to be located at the inserted position
+  const VertexIterator vend = macroView.template end< dim >();
+  for( VertexIterator it = macroView.template begin< dim >(); it != vend; ++it )
+  {
+    const unsigned int i = factory.insertionIndex( *it );
+    if( i >= numVertices )
+      DUNE_THROW( Dune::GridError, name << ": invalid vertex insertion index " << i );
+    typename Triangulation::Vertex distance = it->geometry().corner( 0 );
+    distance -= triangulation.vertices[ i ];
+    if( distance.two_norm() > 1e-8 )
+      DUNE_THROW( Dune::GridError, name << ": vertex " << i << " has a wrong position" );
+  }
+
+  const double distance = meanNeighborDistance( *grid, factory );
+  std::cout << "  mean distance of neighbors in traversal order: " << distance << std::endl;
+
+  Dune::GridFactory< Grid >::destroyGrid( grid );
+  return distance;
+}
+
+template< class Grid >
+void checkInsertionIndices ( const std::string &name )
+{
+  const double shuffled = checkInsertionIndices< Grid >( name, false );
+  const double ordered = checkInsertionIndices< Grid >( name, true );
+  if( ordered >= shuffled )
+    DUNE_THROW( Dune::GridError, name << ": ordering along the curve does not improve locality ("
+                                      << ordered << " >= " << shuffled << ")" );
+}
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  bool tested = false;
+
+#if HAVE_UG
+  checkInsertionIndices< Dune::UGGrid< 2 > >( "UGGrid< 2 >" );
+  checkInsertionIndices< Dune::UGGrid< 3 > >( "UGGrid< 3 >" );
+  tested = true;
+#endif
+
+#if HAVE_ALUGRID
+  checkInsertionIndices< Dune::ALUSimplexGrid< 3, 3 > >( "ALUSimplexGrid< 3, 3 >" );
+  tested = true;
+#endif
+
+#if HAVE_ALBERTA
+  checkInsertionIndices< Dune::AlbertaGrid< ALBERTA_DIM, ALBERTA_DIM > >( "AlbertaGrid" );
+  tested = true;
+#endif
+
+  return (tested ? 0 : 77);
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
+catch( ... )
+{
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
@@ -232,6 +232,57 @@ void generalTests(bool greenClosure)
 
 }
 
+/** \brief Refine a grid with a small heap past the size of the heap
+ *
+ * If UG uses its own heap, its heap test has to stop the refinement before
+ * the grid is damaged.  If UG uses the system heap, the refinement has to
+ * go on beyond the initial heap size.
+ *
+ * \param local  mark every second leaf element instead of all of them, so
+ *               the closure has to refine the neighbors as well
+ */
+void checkHeapExhaustion(bool local)
+{
+  std::cout << "Testing " << (local ? "local" : "global")
+            << " refinement beyond the heap size." << std::endl;
+  typedef Dune::UGGrid<2> GridType;
+  typedef GridType::Codim<0>::LeafIterator LeafIterator;
+  GridType smallHeapGrid;
+
+  // the heap is allocated when the grid factory creates the grid
+  GridType::setDefaultHeapSize(1);
+  makeHalfCircleQuad(smallHeapGrid, false, false);
+  GridType::setDefaultHeapSize(500);
+
+  const std::size_t initialHeapSize = smallHeapGrid.heapSize();
+  bool exhausted = false;
+  for (int i=0; i<40 && !exhausted && smallHeapGrid.heapUsed() <= initialHeapSize; i++) {
+    const GridType::LeafIndexSet& indexSet = smallHeapGrid.leafIndexSet();
+    for (LeafIterator it = smallHeapGrid.leafbegin<0>(); it != smallHeapGrid.leafend<0>(); ++it)
+      if (!local || indexSet.index(*it) % 2 == 0)
+        smallHeapGrid.mark(1, *it);
+    try {
+      smallHeapGrid.preAdapt();
+      smallHeapGrid.adapt();
+    } catch (Dune::GridError& e) {
+      std::cout << e << std::endl;
+      exhausted = true;
+
+      // remove the marks of the refinement that did not take place
+      for (LeafIterator it = smallHeapGrid.leafbegin<0>(); it != smallHeapGrid.leafend<0>(); ++it)
+        smallHeapGrid.mark(0, *it);
+    }
+    smallHeapGrid.postAdapt();
+  }
+
+  smallHeapGrid.printMemoryUsage(std::cout);
+  if (!exhausted && smallHeapGrid.heapUsed() <= initialHeapSize)
+    DUNE_THROW(Dune::GridError, "Refinement neither went beyond the heap size nor was stopped by UG!");
+
+  // the grid must still be usable after the failed or the grown refinement
+  gridcheck(smallHeapGrid);
+}
+
 int main (int argc , char **argv) try
 {
   // use MPI helper to initialize MPI
@@ -362,6 +413,13 @@ int main (int argc , char **argv) try
     }
   }
 
+  // ////////////////////////////////////////////////////////////////////////
+  //   Check refining beyond the size of UG's heap
+  // ////////////////////////////////////////////////////////////////////////
+
+  checkHeapExhaustion(false);
+  checkHeapExhaustion(true);
+
   return 0;
 }
 catch (Dune::Exception& e) {
@@ -4,8 +4,15 @@
 
 #include <config.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <vector>
 
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/grid/common/datahandleif.hh>
 #include <dune/grid/yaspgrid.hh>
 
 #include "gridcheck.cc"
@@ -17,6 +24,206 @@
 
 int rank;
 
+// records the cells visited by YaspGrid::forEachCell
+template <int dim>
+struct CellRecorder
+{
+  typedef Dune::FieldVector<double,dim> fTupel;
+  typedef Dune::FieldVector<int,dim> iTupel;
+
+  template <class Coord, class Center>
+  void operator() (int index, const Coord& coord, const Center& center)
+  {
+    indices.push_back(index);
+    iTupel c;
+    for (int i=0; i<dim; i++) c[i] = coord[i];
+    coords.push_back(c);
+    centers.push_back(center);
+  }
+
+  std::vector<int> indices;
+  std::vector<iTupel> coords;
+  std::vector<fTupel> centers;
+};
+
+// compare the structured loop with the level iterator
+template <class Grid, Dune::PartitionIteratorType pitype>
+void check_foreachcell (const Grid& grid)
+{
+  const int dim = Grid::dimension;
+  typedef typename Grid::LevelGridView GridView;
+  typedef typename GridView::template Codim<0>::template Partition<pitype>::Iterator Iterator;
+
+  for (int l=0; l<=grid.maxLevel(); ++l)
+  {
+    const GridView gv = grid.levelGridView(l);
+    const CellRecorder<dim> rec = grid.forEachCell(l,pitype,CellRecorder<dim>());
+
+    std::size_t n = 0;
+    const Iterator end = gv.template end<0,pitype>();
+    for (Iterator it = gv.template begin<0,pitype>(); it != end; ++it, ++n)
+    {
+      if (n >= rec.indices.size())
+        DUNE_THROW(Dune::GridError, "forEachCell visits too few cells");
+      if (rec.indices[n] != gv.indexSet().index(*it))
+        DUNE_THROW(Dune::GridError, "forEachCell yields wrong index");
+      // consecutive indices in the innermost loop belong to neighbors in direction 0
+      if (n > 0 && rec.indices[n] == rec.indices[n-1]+1 && rec.coords[n][0] != rec.coords[n-1][0]+1)
+        DUNE_THROW(Dune::GridError, "forEachCell yields wrong coordinate");
+      Dune::FieldVector<double,dim> diff = it->geometry().center();
+      diff -= rec.centers[n];
+      if (diff.two_norm() > 1e-12)
+        DUNE_THROW(Dune::GridError, "forEachCell yields wrong center");
+    }
+    if (n != rec.indices.size())
+      DUNE_THROW(Dune::GridError, "forEachCell visits too many cells");
+  }
+}
+
+template <class Grid>
+void check_foreachcell (const Grid& grid)
+{
+  check_foreachcell<Grid,Dune::Interior_Partition>(grid);
+  check_foreachcell<Grid,Dune::InteriorBorder_Partition>(grid);
+  check_foreachcell<Grid,Dune::Overlap_Partition>(grid);
+  check_foreachcell<Grid,Dune::All_Partition>(grid);
+  check_foreachcell<Grid,Dune::Ghost_Partition>(grid);
+}
+
+// communicates the centers of the entities of one codimension and compares
+// them with the centers of the receiving entities (non-periodic grids only)
+template <class GridView>
+class CenterDataHandle
+  : public Dune::CommDataHandleIF<CenterDataHandle<GridView>, double>
+{
+public:
+  CenterDataHandle (const GridView& gv, int codim, std::vector<int>& received)
+    : gv_(gv), codim_(codim), received_(received), errors_(0)
+  {}
+
+  bool contains (int dim, int codim) const { return (codim == codim_); }
+  bool fixedsize (int dim, int codim) const { return true; }
+
+  template <class Entity>
+  std::size_t size (const Entity& e) const
+  {
+    return Entity::Geometry::dimensionworld;
+  }
+
+  template <class Buffer, class Entity>
+  void gather (Buffer& buff, const Entity& e) const
+  {
+    const typename Entity::Geometry::GlobalCoordinate center = e.geometry().center();
+    for (int j=0; j<Entity::Geometry::dimensionworld; j++)
+      buff.write(center[j]);
+  }
+
+  template <class Buffer, class Entity>
+  void scatter (Buffer& buff, const Entity& e, std::size_t n)
+  {
+    const typename Entity::Geometry::GlobalCoordinate center = e.geometry().center();
+    double distance = 0;
+    for (int j=0; j<Entity::Geometry::dimensionworld; j++)
+    {
+      double x;
+      buff.read(x);
+      distance = std::max(distance, std::abs(x - center[j]));
+    }
+    if (distance > 1e-8)
+      ++errors_;
+    ++received_[gv_.indexSet().index(e)];
+  }
+
+  int errors () const { return errors_; }
+
+private:
+  const GridView& gv_;
+  int codim_;
+  std::vector<int>& received_;
+  int errors_;
+};
+
+// check indices, ids and communication of the faces and edges of a grid view
+template <int codim, class GridView>
+void check_subentities (const GridView& gv)
+{
+  const int dim = GridView::dimension;
+  typedef typename GridView::template Codim<0>::Iterator ElementIterator;
+  typedef typename GridView::template Codim<codim>::Iterator Iterator;
+  typedef typename GridView::template Codim<codim>::EntityPointer EntityPointer;
+  typedef typename GridView::Grid::GlobalIdSet GlobalIdSet;
+  typedef typename GridView::IndexSet IndexSet;
+
+  const IndexSet& indexSet = gv.indexSet();
+  const GlobalIdSet& idSet = gv.grid().globalIdSet();
+  const int size = indexSet.size(codim);
+
+  // the iterated entities have to be numbered consecutively
+  std::vector<int> count(size, 0);
+  const Iterator end = gv.template end<codim>();
+  for (Iterator it = gv.template begin<codim>(); it != end; ++it)
+  {
+    const int index = indexSet.index(*it);
+    if (index < 0 || index >= size)
+      DUNE_THROW(Dune::GridError, "codim " << codim << " entity has invalid index " << index);
+    ++count[index];
+  }
+  for (int k=0; k<size; k++)
+    if (count[k] != 1)
+      DUNE_THROW(Dune::GridError, "codim " << codim << " index " << k << " is used " << count[k] << " times");
+
+  // subentities have to match the entities obtained via index and id
+  const ElementIterator eend = gv.template end<0>();
+  for (ElementIterator it = gv.template begin<0>(); it != eend; ++it)
+  {
+    const Dune::ReferenceElement<double,dim>& refElem = Dune::ReferenceElements<double,dim>::general(it->type());
+    for (int i=0; i<it->template count<codim>(); i++)
+    {
+      const EntityPointer ep = it->template subEntity<codim>(i);
+      if (indexSet.index(*ep) != indexSet.subIndex(*it,i,codim))
+        DUNE_THROW(Dune::GridError, "index and subIndex differ for codim " << codim);
+      if (idSet.id(*ep) != idSet.subId(*it,i,codim))
+        DUNE_THROW(Dune::GridError, "id and subId differ for codim " << codim);
+      Dune::FieldVector<double,dim> diff = ep->geometry().center();
+      diff -= it->geometry().global(refElem.position(i,codim));
+      if (diff.two_norm() > 1e-8)
+        DUNE_THROW(Dune::GridError, "subentity " << i << " of codim " << codim << " is misplaced");
+    }
+  }
+
+  // communicate the centers; shared entities have to receive matching data
+  std::vector<int> received(size, 0);
+  CenterDataHandle<GridView> handle(gv, codim, received);
+  gv.communicate(handle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+  if (handle.errors() > 0)
+    DUNE_THROW(Dune::GridError, handle.errors() << " codim " << codim << " entities received data of other entities");
+  if (gv.comm().size() > 1)
+  {
+    for (Iterator it = gv.template begin<codim>(); it != end; ++it)
+      if (it->partitionType() == Dune::BorderEntity && received[indexSet.index(*it)] == 0)
+        DUNE_THROW(Dune::GridError, "codim " << codim << " border entity did not receive data");
+  }
+}
+
+// run check_subentities for the codimensions 1, ..., dim-1 on all views
+template <class Grid, int codim, bool done = (codim >= Grid::dimension)>
+struct CheckFacesAndEdges
+{
+  static void apply (const Grid& grid)
+  {
+    check_subentities<codim>(grid.leafGridView());
+    for (int l=0; l<=grid.maxLevel(); ++l)
+      check_subentities<codim>(grid.levelGridView(l));
+    CheckFacesAndEdges<Grid,codim+1>::apply(grid);
+  }
+};
+
+template <class Grid, int codim>
+struct CheckFacesAndEdges<Grid,codim,true>
+{
+  static void apply (const Grid& grid) {}
+};
+
 template <int dim>
 void check_yasp(bool p0=false) {
   typedef Dune::FieldVector<double,dim> fTupel;
@@ -50,6 +257,10 @@ void check_yasp(bool p0=false) {
   for(int l=0; l<=grid.maxLevel(); ++l)
     checkCommunication(grid,l,Dune::dvverb);
 
+  // check faces and edges (the comparison of centers needs a non-periodic grid)
+  if (!p0)
+    CheckFacesAndEdges<Dune::YaspGrid<dim>,1>::apply(grid);
+
   // check geometry lifetime
   checkGeometryLifetime( grid.leafGridView() );
   // check the method geometryInFather()
@@ -59,11 +270,53 @@ void check_yasp(bool p0=false) {
   // check grid adaptation interface
   checkAdaptRefinement(grid);
   checkPartitionType( grid.leafGridView() );
+  check_foreachcell(grid);
 
   // test operator<<
   std::cout << grid << std::endl;
 }
 
+template <int dim>
+void check_yasp_tensor(bool p0=false) {
+  std::cout << std::endl << "YaspGrid<" << dim << "> with tensor product coordinates";
+  if (p0) std::cout << " periodic\n";
+  std::cout << std::endl << std::endl;
+
+  // graded coordinates: cell size grows geometrically
+  Dune::array<std::vector<double>,dim> coords;
+  for (int i=0; i<dim; i++)
+  {
+    const int n = (i==0) ? 6 : 2;
+    coords[i].resize(n+1);
+    coords[i][0] = -1.0;
+    for (int k=1; k<=n; k++)
+      coords[i][k] = coords[i][k-1] + 0.1*std::pow(1.5,k);
+  }
+  std::bitset<dim> p;
+  p[0] = p0;
+  int overlap = 1;
+
+#if HAVE_MPI
+  Dune::YaspGrid<dim> grid(MPI_COMM_WORLD,coords,p,overlap);
+#else
+  Dune::YaspGrid<dim> grid(coords,p,overlap);
+#endif
+
+  gridcheck(grid);
+
+  grid.globalRefine(2);
+
+  gridcheck(grid);
+
+  checkCommunication(grid,-1,Dune::dvverb);
+  if (!p0)
+    CheckFacesAndEdges<Dune::YaspGrid<dim>,1>::apply(grid);
+  checkGeometryInFather(grid);
+  checkIntersectionIterator(grid);
+  checkPartitionType( grid.leafGridView() );
+  check_foreachcell(grid);
+}
+
 int main (int argc , char **argv) {
   try {
 #if HAVE_MPI
@@ -82,6 +335,10 @@ int main (int argc , char **argv) {
     //check_yasp<3>(true);
     //check_yasp<4>();
 
+    check_yasp_tensor<1>();
+    check_yasp_tensor<2>();
+    check_yasp_tensor<3>();
+
   } catch (Dune::Exception &e) {
     std::cerr << e << std::endl;
     return 1;
@@ -8,6 +8,9 @@
  * \brief The UGGrid class
  */
 
+#include <cstddef>
+#include <ostream>
+
 #include <dune/common/classname.hh>
 #include <dune/common/parallel/collectivecommunication.hh>
 #include <dune/common/exceptions.hh>
@@ -456,7 +459,14 @@ namespace Dune {
        adaption, here always returns true */
     bool preAdapt();
 
-    //! Triggers the grid refinement process
+    /** \brief Triggers the grid refinement process
+     *
+     * UG allocates the new entities from a heap of fixed size.  UG checks
+     * whether the heap suffices before it modifies the grid; if it does not,
+     * a GridError is thrown.  If UG has been built with
+     * <tt>--enable-system-heap</tt>, the entities are allocated from the
+     * system heap and the refinement is not limited by the heap size.
+     */
     bool adapt();
 
     /** \brief Clean up refinement markers */
@@ -804,11 +814,33 @@ namespace Dune {
      * UGGrid keeps an internal heap to allocate memory from, which must be
      * specified on grid creation (at the latest).  This sets the default heap
      * size, which is used when no heap size is given to the constructor.
+     * The size of the heap of an existing grid is fixed for its lifetime;
+     * changing the default only affects grids created afterwards.
      */
     static void setDefaultHeapSize(unsigned size) {
       heapSize_ = size;
     }
 
+    /** \brief Size of UG's heap for this grid in bytes
+     *
+     * The heap is allocated when the grid is created and keeps this size
+     * for the lifetime of the grid.
+     */
+    std::size_t heapSize() const;
+
+    /** \brief Number of bytes currently used in UG's heap for this grid */
+    std::size_t heapUsed() const;
+
+    /** \brief Print the memory usage of this grid
+     *
+     * Prints the size and usage of UG's heap, and for each level the
+     * number of elements, nodes and edges together with the memory they
+     * occupy.  Nodes and edges have a fixed size in UG; the memory of the
+     * elements (which includes their vectors and boundary data) is
+     * estimated from the rest of the heap usage.
+     */
+    void printMemoryUsage(std::ostream& out) const;
+
     /** \brief Sets a vertex to a new position
 
        Changing a vertex' position changes its position on all grid levels!*/
@@ -3,6 +3,7 @@
 
 #include <config.h>
 
+#include <iomanip>
 #include <set>
 
 #include <dune/grid/uggrid.hh>
@@ -343,8 +344,8 @@ bool Dune::UGGrid < dim >::adapt()
   // I don't really know what this means
   int seq = UG_NS<dim>::GM_REFINE_PARALLEL;
 
-  // I don't really know what this means either
-  int mgtest = UG_NS<dim>::GM_REFINE_NOHEAPTEST;
+  // Let UG check whether its heap suffices before modifying the grid
+  int mgtest = UG_NS<dim>::GM_REFINE_HEAPTEST;
 
   int rv = AdaptMultiGrid(multigrid_,mode,seq,mgtest);
 
@@ -361,6 +362,53 @@ bool Dune::UGGrid < dim >::adapt()
   return someElementHasBeenMarkedForRefinement_;
 }
 
+template <int dim>
+std::size_t Dune::UGGrid <dim>::heapSize() const
+{
+  assert(multigrid_);
+  return UG::HeapSize(multigrid_->theHeap);
+}
+
+template <int dim>
+std::size_t Dune::UGGrid <dim>::heapUsed() const
+{
+  assert(multigrid_);
+  return UG::HeapUsed(multigrid_->theHeap);
+}
+
+template <int dim>
+void Dune::UGGrid <dim>::printMemoryUsage(std::ostream& out) const
+{
+  const std::size_t used = heapUsed();
+  out << "UGGrid<" << dim << "> '" << name_ << "': " << used << " of " << heapSize()
+      << " bytes of UG's heap used" << std::endl;
+
+  // Nodes and edges have a fixed size; attribute the rest to the elements
+  std::vector<std::size_t> elements(maxLevel()+1), nodes(maxLevel()+1), edges(maxLevel()+1);
+  std::size_t numElements = 0;
+  std::size_t fixedBytes = 0;
+  for (int i=0; i<=maxLevel(); i++) {
+    elements[i] = size(i,0);
+    nodes[i]    = size(i,dim);
+    edges[i]    = size(i,dim-1);
+    numElements += elements[i];
+    fixedBytes += nodes[i]*sizeof(typename UG_NS<dim>::Node) + edges[i]*sizeof(typename UG_NS<dim>::Edge);
+  }
+  const double bytesPerElement = (numElements > 0 && used > fixedBytes)
+                                 ? double(used - fixedBytes) / numElements : 0.0;
+
+  out << std::setw(6) << "level"
+      << std::setw(12) << "elements" << std::setw(14) << "bytes"
+      << std::setw(12) << "nodes" << std::setw(14) << "bytes"
+      << std::setw(12) << "edges" << std::setw(14) << "bytes" << std::endl;
+  for (int i=0; i<=maxLevel(); i++)
+    out << std::setw(6) << i
+        << std::setw(12) << elements[i] << std::setw(14) << std::size_t(elements[i]*bytesPerElement)
+        << std::setw(12) << nodes[i] << std::setw(14) << nodes[i]*sizeof(typename UG_NS<dim>::Node)
+        << std::setw(12) << edges[i] << std::setw(14) << edges[i]*sizeof(typename UG_NS<dim>::Edge)
+        << std::endl;
+}
+
 template <int dim>
 void Dune::UGGrid <dim>::postAdapt()
 {
@@ -5,6 +5,8 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <dune/grid/utility/spacefillingcurve.hh>
+
 #include <dune/grid/uggrid/uggridfactory.hh>
 #include "boundaryextractor.hh"
 
@@ -75,6 +77,8 @@ GridFactory()
 
   factoryOwnsGrid_ = true;
 
+  curveOrdering_ = false;
+
   createBegin();
 }
 
@@ -86,6 +90,8 @@ GridFactory(UGGrid<dimworld>* grid)
 
   factoryOwnsGrid_ = false;
 
+  curveOrdering_ = false;
+
   createBegin();
 }
 
@@ -251,6 +257,10 @@ createGrid()
   elementTypes_.resize(numElementTypes);
   MPIHelper::getCollectiveCommunication().broadcast(&elementTypes_[0], elementTypes_.size(), 0);
 
+  // Reorder the elements along a space-filling curve
+  if (curveOrdering_)
+    sortElementsAlongCurve();
+
   // ///////////////////////////////////////////
   //   Extract grid boundary segments
   // ///////////////////////////////////////////
@@ -602,6 +612,7 @@ createBegin()
   elementTypes_.resize(0);
   elementVertices_.resize(0);
   vertexPositions_.resize(0);
+  ordering_.resize(0);
 
   // //////////////////////////////////////////////////////////
   //   Delete the UG domain, if it exists
@@ -610,6 +621,37 @@ createBegin()
   UG_NS<dimworld>::RemoveDomain(domainName.c_str());
 }
 
+template <int dimworld>
+void Dune::GridFactory<Dune::UGGrid<dimworld> >::
+sortElementsAlongCurve()
+{
+  const size_t numElements = elementTypes_.size();
+
+  // Offsets of the elements in elementVertices_ and their barycenters
+  std::vector<size_t> offset(numElements+1, 0);
+  std::vector<FieldVector<double, dimworld> > centers(numElements, FieldVector<double, dimworld>(0));
+  for (size_t i=0; i<numElements; i++) {
+    offset[i+1] = offset[i] + elementTypes_[i];
+    for (size_t j=offset[i]; j<offset[i+1]; j++)
+      centers[i] += vertexPositions_[elementVertices_[j]];
+    centers[i] /= double(elementTypes_[i]);
+  }
+
+  sortSpaceFillingCurve(SpaceFillingCurve<double, dimworld>::hilbert, centers, ordering_);
+
+  // Permute the element buffers
+  std::vector<unsigned char> elementTypes(numElements);
+  std::vector<unsigned int> elementVertices;
+  elementVertices.reserve(elementVertices_.size());
+  for (size_t i=0; i<numElements; i++) {
+    const unsigned int k = ordering_[i];
+    elementTypes[i] = elementTypes_[k];
+    elementVertices.insert(elementVertices.end(), elementVertices_.begin()+offset[k], elementVertices_.begin()+offset[k+1]);
+  }
+  elementTypes_.swap(elementTypes);
+  elementVertices_.swap(elementVertices);
+}
+
 
 
 
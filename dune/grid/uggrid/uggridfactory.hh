@@ -210,6 +210,23 @@ namespace Dune {
                                const shared_ptr<BoundarySegment<dimworld> > &boundarySegment);
 
 
+    /** \brief Sort the coarse grid elements along a Hilbert curve on grid creation
+
+       If enabled, createGrid() inserts the elements into UG in the order of a
+       Hilbert curve through their barycenters.  Neighboring elements then get
+       close indices, which improves the cache efficiency of loops over the grid.
+       The method insertionIndex() still returns the position of an element in
+       the insertion sequence.
+
+       \note In parallel, this method has to be called on all processes.
+
+       \param enable True to enable the reordering
+     */
+    void orderElementsAlongCurve(bool enable = true)
+    {
+      curveOrdering_ = enable;
+    }
+
     /** \brief Finalize grid creation and hand over the grid
 
        The receiver takes responsibility of the memory allocated for the grid
@@ -226,12 +243,15 @@ namespace Dune {
 
     /** \brief Return the number of the element in the order of insertion into the factory
      *
-     * For UGGrid elements this number is the same as the element level index
+     * For UGGrid elements this number is the same as the element level index,
+     * unless the elements have been reordered (see orderElementsAlongCurve())
      */
     virtual unsigned int
     insertionIndex ( const typename Codim< 0 >::Entity &entity ) const
     {
-      return UG_NS<dimension>::levelIndex(grid_->getRealImplementation(entity).target_);
+      const unsigned int index = UG_NS<dimension>::levelIndex(grid_->getRealImplementation(entity).target_);
+      assert(ordering_.empty() || index < ordering_.size());
+      return (ordering_.empty()) ? index : ordering_[index];
     }
 
     /** \brief Return the number of the vertex in the order of insertion into the factory
@@ -249,6 +269,9 @@ namespace Dune {
     // Initialize the grid structure in UG
     void createBegin();
 
+    // Permute the buffered elements along a Hilbert curve
+    void sortElementsAlongCurve();
+
     // Pointer to the grid being built
     UGGrid<dimworld>* grid_;
 
@@ -270,6 +293,12 @@ namespace Dune {
     /** \brief Buffer the vertices until createend() is called */
     std::vector<FieldVector<double, dimworld> > vertexPositions_;
 
+    /** \brief True if the elements are reordered along a Hilbert curve */
+    bool curveOrdering_;
+
+    /** \brief Insertion index of each coarse grid element, if they have been reordered */
+    std::vector<unsigned int> ordering_;
+
   };
 
 }
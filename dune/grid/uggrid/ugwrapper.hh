@@ -320,6 +320,8 @@ namespace Dune {
 
     enum {GM_REFINE_NOHEAPTEST = UG_NAMESPACE ::GM_REFINE_NOHEAPTEST};
 
+    enum {GM_REFINE_HEAPTEST = UG_NAMESPACE ::GM_REFINE_HEAPTEST};
+
     /** \brief Control word entries */
     enum {NEWEL_CE      = UG_NAMESPACE ::NEWEL_CE,
           COARSEN_CE    = UG_NAMESPACE ::COARSEN_CE,
@@ -0,0 +1,324 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_ELEMENTCOLORING_HH
+#define DUNE_GRID_UTILITY_ELEMENTCOLORING_HH
+
+/** \file
+    \brief Conflict-free partitioning of the elements of a grid view for
+           thread-parallel assembly
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/common/capabilities.hh>
+
+namespace Dune
+{
+
+  /** \brief split the elements of a grid view into sets that can be
+   *         processed concurrently without write conflicts on vertices
+   *
+   * The elements are organized in phases, which are processed one after
+   * another. Each phase consists of blocks of elements. Elements from
+   * different blocks of the same phase never share a vertex, so the blocks
+   * of one phase can be processed by different threads without
+   * synchronization on vertex (or element) data.
+   *
+   * Two strategies are available:
+   * - greedyColoring: Each element gets the smallest color not used by an
+   *   element sharing a vertex with it. Each color forms a phase, split
+   *   into blocks of consecutive elements.
+   * - separatedChunks: The elements are split (in iteration order) into
+   *   contiguous chunks. Elements sharing a vertex with an element of
+   *   another chunk form a separator. The first phase consists of the
+   *   chunks without their separator elements, the second phase of the
+   *   separator. Consecutive elements keep their order, which is usually
+   *   more cache friendly than a coloring.
+   *
+   * The elements are stored as entity seeds. The partition is computed
+   * once and not tied to the state of the grid (the grid interface provides
+   * no sequence number to detect changes). As with the mappers, update()
+   * has to be called manually after the grid has changed.
+   *
+   * \tparam GridView  type of the grid view
+   */
+  template< class GridView >
+  class ElementColoring
+  {
+    typedef ElementColoring< GridView > This;
+
+  public:
+    //! type of the grid
+    typedef typename GridView::Grid Grid;
+
+    //! dimension of the grid
+    static const int dimension = GridView::dimension;
+
+    //! type of the elements
+    typedef typename GridView::template Codim< 0 >::Entity Element;
+
+    //! type of the entity seeds of the elements
+    typedef typename Grid::template Codim< 0 >::EntitySeed EntitySeed;
+
+    //! a block of elements, processed by a single thread
+    typedef std::vector< EntitySeed > Block;
+
+    //! strategy used to split the elements
+    enum Strategy { greedyColoring, separatedChunks };
+
+  private:
+    typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+
+  public:
+    /** \brief construct the element partition of a grid view
+     *
+     * \param gridView   the grid view
+     * \param strategy   strategy used to split the elements
+     * \param numBlocks  (maximal) number of blocks per phase, defaults to
+     *                   the number of threads
+     */
+    explicit ElementColoring ( const GridView &gridView,
+                               Strategy strategy = greedyColoring,
+                               int numBlocks = defaultNumBlocks() )
+      : gridView_( gridView ),
+        strategy_( strategy ),
+        numBlocks_( numBlocks ),
+        size_( 0 )
+    {
+      if( numBlocks_ <= 0 )
+        DUNE_THROW( RangeError, "ElementColoring: number of blocks must be positive." );
+      update();
+    }
+
+    //! return the strategy used to split the elements
+    Strategy strategy () const { return strategy_; }
+
+    //! return the number of elements
+    int size () const { return size_; }
+
+    //! return the number of phases
+    int phases () const { return phases_.size(); }
+
+    //! return the number of blocks of a phase
+    int blocks ( int phase ) const
+    {
+      assert( (phase >= 0) && (phase < phases()) );
+      return phases_[ phase ].size();
+    }
+
+    //! return a block of a phase
+    const Block &block ( int phase, int index ) const
+    {
+      assert( (index >= 0) && (index < blocks( phase )) );
+      return phases_[ phase ][ index ];
+    }
+
+    /** \brief call f( element ) for all elements
+     *
+     * The phases are processed one after another. If compiled with OpenMP
+     * and Capabilities::viewThreadSafe is true for the grid, the blocks of
+     * each phase are distributed among the threads. Hence, f may be called
+     * concurrently for elements not sharing a vertex and must be thread
+     * safe in this case. Otherwise, all blocks are processed sequentially,
+     * because obtaining entities from their seeds is not thread safe.
+     *
+     * \returns the functor f
+     */
+    template< class F >
+    F forEach ( F f ) const
+    {
+      return forEach( f, Capabilities::viewThreadSafe< Grid >::v );
+    }
+
+    /** \brief call f( element ) for all elements, explicitly choosing
+     *         whether the blocks are processed by multiple threads
+     *
+     * Capabilities::viewThreadSafe is false for most grids, although
+     * obtaining entities from their seeds is thread safe for some of them
+     * (e.g., YaspGrid). Passing threaded = true distributes the blocks of
+     * each phase among the OpenMP threads regardless of the capability;
+     * the caller is responsible for the thread safety of the grid and f.
+     * Without OpenMP, the blocks are always processed sequentially.
+     *
+     * \returns the functor f
+     */
+    template< class F >
+    F forEach ( F f, bool threaded ) const
+    {
+      const Grid &grid = gridView_.grid();
+      assert( size_ == gridView_.size( 0 ) );
+      const int numPhases = phases();
+      for( int phase = 0; phase < numPhases; ++phase )
+      {
+        const int numBlocks = blocks( phase );
+#ifdef _OPENMP
+#pragma omp parallel for schedule( dynamic ) if( threaded )
+#endif
+        for( int b = 0; b < numBlocks; ++b )
+        {
+          const Block &seeds = phases_[ phase ][ b ];
+          const typename Block::const_iterator end = seeds.end();
+          for( typename Block::const_iterator it = seeds.begin(); it != end; ++it )
+            f( *grid.entityPointer( *it ) );
+        }
+      }
+      return f;
+    }
+
+    //! recompute the partition, has to be called after the grid has changed
+    void update ()
+    {
+      typedef typename GridView::IndexSet IndexSet;
+      const IndexSet &indexSet = gridView_.indexSet();
+
+      // collect the elements and their vertices (in iteration order)
+      std::vector< EntitySeed > seeds;
+      std::vector< int > elementOffset( 1, 0 ), elementVertices;
+      const Iterator end = gridView_.template end< 0 >();
+      for( Iterator it = gridView_.template begin< 0 >(); it != end; ++it )
+      {
+        const Element &element = *it;
+        seeds.push_back( element.seed() );
+        const int numVertices = element.template count< dimension >();
+        for( int i = 0; i < numVertices; ++i )
+          elementVertices.push_back( indexSet.subIndex( element, i, dimension ) );
+        elementOffset.push_back( elementVertices.size() );
+      }
+      size_ = seeds.size();
+
+      // invert the element-vertex relation
+      std::vector< int > vertexOffset( indexSet.size( dimension )+1, 0 );
+      for( std::size_t k = 0; k < elementVertices.size(); ++k )
+        ++vertexOffset[ elementVertices[ k ]+1 ];
+      for( std::size_t v = 1; v < vertexOffset.size(); ++v )
+        vertexOffset[ v ] += vertexOffset[ v-1 ];
+      std::vector< int > vertexElements( elementVertices.size() );
+      {
+        std::vector< int > pos( vertexOffset.begin(), vertexOffset.end()-1 );
+        for( int e = 0; e < size_; ++e )
+        {
+          for( int k = elementOffset[ e ]; k < elementOffset[ e+1 ]; ++k )
+            vertexElements[ pos[ elementVertices[ k ] ]++ ] = e;
+        }
+      }
+
+      std::vector< std::vector< int > > sets;
+      if( strategy_ == greedyColoring )
+      {
+        std::vector< int > color( size_, -1 );
+        std::vector< int > usedBy;
+        for( int e = 0; e < size_; ++e )
+        {
+          // mark the colors of all neighbors
+          for( int k = elementOffset[ e ]; k < elementOffset[ e+1 ]; ++k )
+          {
+            const int v = elementVertices[ k ];
+            for( int l = vertexOffset[ v ]; l < vertexOffset[ v+1 ]; ++l )
+            {
+              const int c = color[ vertexElements[ l ] ];
+              if( c >= 0 )
+                usedBy[ c ] = e;
+            }
+          }
+
+          // choose the smallest unused color
+          int c = 0;
+          while( (c < int( usedBy.size() )) && (usedBy[ c ] == e) )
+            ++c;
+          if( c == int( usedBy.size() ) )
+          {
+            usedBy.push_back( -1 );
+            sets.push_back( std::vector< int >() );
+          }
+          color[ e ] = c;
+          sets[ c ].push_back( e );
+        }
+        setupPhases( seeds, sets, numBlocks_ );
+      }
+      else
+      {
+        const int numChunks = std::max( std::min( numBlocks_, size_ ), 1 );
+        std::vector< int > chunk( size_ );
+        for( int e = 0; e < size_; ++e )
+          chunk[ e ] = int( (long( e ) * numChunks) / size_ );
+
+        // interior elements of the chunks followed by the separator
+        sets.resize( numChunks+1 );
+        for( int e = 0; e < size_; ++e )
+        {
+          bool separator = false;
+          for( int k = elementOffset[ e ]; !separator && (k < elementOffset[ e+1 ]); ++k )
+          {
+            const int v = elementVertices[ k ];
+            for( int l = vertexOffset[ v ]; l < vertexOffset[ v+1 ]; ++l )
+              separator |= (chunk[ vertexElements[ l ] ] != chunk[ e ]);
+          }
+          sets[ separator ? numChunks : chunk[ e ] ].push_back( e );
+        }
+
+        phases_.clear();
+        phases_.resize( 2 );
+        for( int c = 0; c < numChunks; ++c )
+          phases_[ 0 ].push_back( seedsOf( seeds, sets[ c ] ) );
+        phases_[ 1 ].push_back( seedsOf( seeds, sets[ numChunks ] ) );
+      }
+    }
+
+  private:
+    static int defaultNumBlocks ()
+    {
+#ifdef _OPENMP
+      return omp_get_max_threads();
+#else
+      return 1;
+#endif
+    }
+
+    static Block seedsOf ( const std::vector< EntitySeed > &seeds, const std::vector< int > &elements )
+    {
+      Block block;
+      block.reserve( elements.size() );
+      for( std::size_t k = 0; k < elements.size(); ++k )
+        block.push_back( seeds[ elements[ k ] ] );
+      return block;
+    }
+
+    // split each color into blocks of consecutive elements
+    void setupPhases ( const std::vector< EntitySeed > &seeds,
+                       const std::vector< std::vector< int > > &colors, int numBlocks )
+    {
+      phases_.clear();
+      phases_.resize( colors.size() );
+      for( std::size_t c = 0; c < colors.size(); ++c )
+      {
+        const std::vector< int > &elements = colors[ c ];
+        const int size = elements.size();
+        const int n = std::max( std::min( numBlocks, size ), 1 );
+        for( int b = 0; b < n; ++b )
+        {
+          const std::vector< int > part( elements.begin() + (long( size ) * b) / n,
+                                         elements.begin() + (long( size ) * (b+1)) / n );
+          phases_[ c ].push_back( seedsOf( seeds, part ) );
+        }
+      }
+    }
+
+    GridView gridView_;
+    Strategy strategy_;
+    int numBlocks_;
+    int size_;
+    std::vector< std::vector< Block > > phases_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_UTILITY_ELEMENTCOLORING_HH
@@ -0,0 +1,159 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_ENTITYSEEDVECTOR_HH
+#define DUNE_GRID_UTILITY_ENTITYSEEDVECTOR_HH
+
+/** \file
+    \brief Random access to the entities of a grid view
+ */
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/common/gridenums.hh>
+
+namespace Dune
+{
+
+  /** \brief random access to the entities of a grid view
+   *
+   * Iterating over a grid view is forward only. This class stores the seeds
+   * of all entities of one codimension (in iteration order) together with
+   * their index in the index set of the grid view in contiguous arrays. The
+   * entities can then be accessed by their position, visited in any order
+   * and split into ranges, e.g., for distributing them among threads.
+   *
+   * The grid interface provides no compact seed type, so the full seeds of
+   * the grid are stored. operator[] obtains the entity from its seed by
+   * Grid::entityPointer, so no entity pointers are kept alive between
+   * accesses.
+   *
+   * The vector is compiled lazily: after update() has been called (which
+   * has to be done whenever the grid has changed), it is rebuilt on the
+   * next access. As this access modifies the object, compile() should be
+   * called explicitly before the vector is shared among threads. Even then,
+   * obtaining the entities from several threads is only safe if
+   * Capabilities::viewThreadSafe holds for the grid. In debug builds, an
+   * access to a vector whose grid view has changed its size since the
+   * vector was compiled (i.e., update() was forgotten after adaptation)
+   * fails an assertion.
+   *
+   * \tparam GridView  type of the grid view
+   * \tparam codim     codimension of the entities
+   * \tparam pitype    partition of the entities
+   */
+  template< class GridView, int codim = 0, PartitionIteratorType pitype = All_Partition >
+  class EntitySeedVector
+  {
+    typedef EntitySeedVector< GridView, codim, pitype > This;
+
+  public:
+    //! type of the grid
+    typedef typename GridView::Grid Grid;
+
+    //! type of the entities
+    typedef typename GridView::template Codim< codim >::Entity Entity;
+
+    //! type of the entity pointers returned by operator[]
+    typedef typename Grid::template Codim< codim >::EntityPointer EntityPointer;
+
+    //! type of the entity seeds
+    typedef typename Grid::template Codim< codim >::EntitySeed EntitySeed;
+
+    //! type of the indices
+    typedef typename GridView::IndexSet::IndexType IndexType;
+
+  private:
+    typedef typename GridView::template Codim< codim >::template Partition< pitype >::Iterator Iterator;
+
+  public:
+    explicit EntitySeedVector ( const GridView &gridView )
+      : gridView_( gridView ),
+        compiled_( false ),
+        gridViewSize_( 0 )
+    {}
+
+    //! mark the vector outdated, it is rebuilt on the next access
+    void update () { compiled_ = false; }
+
+    //! rebuild the vector, if necessary
+    void compile () const
+    {
+      if( compiled_ )
+        return;
+
+      seeds_.clear();
+      indices_.clear();
+      const typename GridView::IndexSet &indexSet = gridView_.indexSet();
+      const Iterator end = gridView_.template end< codim, pitype >();
+      for( Iterator it = gridView_.template begin< codim, pitype >(); it != end; ++it )
+      {
+        seeds_.push_back( it->seed() );
+        indices_.push_back( indexSet.index( *it ) );
+      }
+      gridViewSize_ = gridView_.size( codim );
+      compiled_ = true;
+    }
+
+    //! return the number of entities
+    int size () const
+    {
+      compile();
+      return seeds_.size();
+    }
+
+    //! obtain the i-th entity from its seed
+    EntityPointer operator[] ( int i ) const
+    {
+      return gridView_.grid().entityPointer( seed( i ) );
+    }
+
+    //! return the seed of the i-th entity
+    const EntitySeed &seed ( int i ) const
+    {
+      compile();
+      assert( (i >= 0) && (i < int( seeds_.size() )) );
+      assert( gridView_.size( codim ) == gridViewSize_ );
+      return seeds_[ i ];
+    }
+
+    //! return the index of the i-th entity (in the index set of the grid view)
+    IndexType index ( int i ) const
+    {
+      compile();
+      assert( (i >= 0) && (i < int( indices_.size() )) );
+      assert( gridView_.size( codim ) == gridViewSize_ );
+      return indices_[ i ];
+    }
+
+    /** \brief split the entities into numParts contiguous ranges
+     *
+     * \returns the half-open range [first, second) of positions
+     *          belonging to the given part
+     */
+    std::pair< int, int > range ( int part, int numParts ) const
+    {
+      if( (numParts <= 0) || (part < 0) || (part >= numParts) )
+        DUNE_THROW( RangeError, "EntitySeedVector: invalid part " << part << " of " << numParts << "." );
+      const long n = size();
+      return std::make_pair( int( (n * part) / numParts ), int( (n * (part+1)) / numParts ) );
+    }
+
+    //! return the grid view
+    const GridView &gridView () const { return gridView_; }
+
+  private:
+    GridView gridView_;
+    mutable bool compiled_;
+    mutable std::vector< EntitySeed > seeds_;
+    mutable std::vector< IndexType > indices_;
+    // size of the grid view when the vector was compiled, to detect a missing update()
+    mutable int gridViewSize_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_UTILITY_ENTITYSEEDVECTOR_HH
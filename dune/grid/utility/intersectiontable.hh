@@ -0,0 +1,226 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_INTERSECTIONTABLE_HH
+#define DUNE_GRID_UTILITY_INTERSECTIONTABLE_HH
+
+/** \file
+    \brief Precomputed table of the intersections of a grid view
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/affinegeometry.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+namespace Dune
+{
+
+  /** \brief table of the intersections of a grid view, each stored once
+   *
+   * The intersection iterators compute neighbor relations and geometries
+   * on the fly, and each intersection between two elements is visited
+   * twice, once from each side. This table stores every intersection of
+   * the grid view once in a contiguous array, together with the data
+   * usually needed to assemble face terms:
+   * - the indices of the inside and outside elements and the local numbers
+   *   of the intersection in both reference elements,
+   * - the geometries of the intersection in the reference elements of the
+   *   inside and outside element,
+   * - center, volume, integration element and unit outer normal.
+   *
+   * The position of an intersection within the table can serve as an index
+   * of the intersection. It is valid until the table is rebuilt.
+   *
+   * An intersection between two elements of the grid view is stored with
+   * the element of smaller index as inside element. This also holds for
+   * nonconforming grid views, where an element may have several neighbors
+   * across one face; each part of the face is stored once. Intersections
+   * without neighbor in the grid view (domain and process boundaries) are
+   * stored from their only element.
+   *
+   * \note The table is a snapshot. After the grid has been modified, call
+   *       update() before using it again.
+   * \note The integration element and the normal are evaluated at the
+   *       center of the intersection, so they are exact for affine
+   *       intersections only.
+   *
+   * \tparam GV  type of the grid view
+   */
+  template< class GV >
+  class IntersectionTable
+  {
+  public:
+    //! type of the grid view
+    typedef GV GridView;
+
+    //! dimension of the grid
+    static const int dimension = GridView::dimension;
+    //! dimension of the world
+    static const int dimensionworld = GridView::Grid::dimensionworld;
+
+    //! type of coordinates
+    typedef typename GridView::ctype ctype;
+    //! type of the element indices
+    typedef typename GridView::IndexSet::IndexType IndexType;
+
+    //! type of global coordinates
+    typedef FieldVector< ctype, dimensionworld > GlobalCoordinate;
+
+    //! geometry of an intersection in the reference element of an element
+    typedef AffineGeometry< ctype, dimension-1, dimension > LocalGeometry;
+
+    //! data stored for each intersection
+    struct Face
+    {
+      Face ( const LocalGeometry &geoInInside, const LocalGeometry &geoInOutside )
+        : geometryInInside( geoInInside ), geometryInOutside( geoInOutside )
+      {}
+
+      //! index of the inside element
+      IndexType inside;
+      //! index of the outside element (only valid if neighbor is true)
+      IndexType outside;
+      //! local number of the intersection in the inside element
+      int indexInInside;
+      //! local number of the intersection in the outside element (only valid if neighbor is true)
+      int indexInOutside;
+
+      //! true if the outside element belongs to the grid view
+      bool neighbor;
+      //! true if the intersection is on the domain boundary
+      bool boundary;
+      //! true if the intersection is a full face of both elements
+      bool conforming;
+      //! index of the boundary segment (only valid if boundary is true)
+      std::size_t boundarySegmentIndex;
+
+      //! geometry type of the intersection
+      GeometryType type;
+      //! geometry in the reference element of the inside element
+      LocalGeometry geometryInInside;
+      //! geometry in the reference element of the outside element (only valid if neighbor is true)
+      LocalGeometry geometryInOutside;
+
+      //! center of the intersection
+      GlobalCoordinate center;
+      //! volume of the intersection
+      ctype volume;
+      //! integration element in the center of the intersection
+      ctype integrationElement;
+      //! unit outer normal (with respect to the inside element) in the center
+      GlobalCoordinate unitOuterNormal;
+    };
+
+    //! iterator over the intersections
+    typedef typename std::vector< Face >::const_iterator Iterator;
+
+    /** \brief build the table for a grid view
+     *
+     * \param[in]  gridView  grid view whose intersections are stored
+     */
+    explicit IntersectionTable ( const GridView &gridView )
+      : gridView_( gridView )
+    {
+      update();
+    }
+
+    //! rebuild the table, e.g., after the grid has been adapted
+    void update ()
+    {
+      typedef typename GridView::template Codim< 0 >::Iterator ElementIterator;
+      typedef typename GridView::IntersectionIterator IntersectionIterator;
+      typedef typename GridView::Intersection Intersection;
+
+      const typename GridView::IndexSet &indexSet = gridView_.indexSet();
+
+      faces_.clear();
+      faces_.reserve( gridView_.size( 0 ) * dimension );
+
+      const ElementIterator end = gridView_.template end< 0 >();
+      for( ElementIterator it = gridView_.template begin< 0 >(); it != end; ++it )
+      {
+        const IndexType inside = indexSet.index( *it );
+
+        const IntersectionIterator iend = gridView_.iend( *it );
+        for( IntersectionIterator iit = gridView_.ibegin( *it ); iit != iend; ++iit )
+        {
+          const Intersection &intersection = *iit;
+
+          // store intersections between two elements from the element of smaller index
+          IndexType outside = inside;
+          if( intersection.neighbor() )
+          {
+            outside = indexSet.index( *intersection.outside() );
+            if( outside < inside )
+              continue;
+          }
+
+          const LocalGeometry geoInInside = localGeometry( intersection.geometryInInside() );
+          faces_.push_back( Face( geoInInside, (intersection.neighbor() ? localGeometry( intersection.geometryInOutside() ) : geoInInside) ) );
+          Face &face = faces_.back();
+
+          face.inside = inside;
+          face.outside = outside;
+          face.indexInInside = intersection.indexInInside();
+          face.indexInOutside = (intersection.neighbor() ? intersection.indexInOutside() : -1);
+
+          face.neighbor = intersection.neighbor();
+          face.boundary = intersection.boundary();
+          face.conforming = intersection.conforming();
+          face.boundarySegmentIndex = (intersection.boundary() ? intersection.boundarySegmentIndex() : 0);
+
+          const typename Intersection::Geometry geometry = intersection.geometry();
+          const FieldVector< ctype, dimension-1 > xCenter = referenceCenter( geometry.type() );
+          face.type = geometry.type();
+          face.center = geometry.center();
+          face.volume = geometry.volume();
+          face.integrationElement = geometry.integrationElement( xCenter );
+          face.unitOuterNormal = intersection.unitOuterNormal( xCenter );
+        }
+      }
+    }
+
+    //! number of intersections in the table
+    std::size_t size () const { return faces_.size(); }
+
+    //! access an intersection by its index in the table
+    const Face &operator[] ( std::size_t i ) const { return faces_[ i ]; }
+
+    //! iterator to the first intersection
+    Iterator begin () const { return faces_.begin(); }
+    //! iterator behind the last intersection
+    Iterator end () const { return faces_.end(); }
+
+    //! grid view the table was built for
+    const GridView &gridView () const { return gridView_; }
+
+  private:
+    template< class Geometry >
+    static LocalGeometry localGeometry ( const Geometry &geometry )
+    {
+      if( !geometry.affine() )
+        DUNE_THROW( NotImplemented, "IntersectionTable requires affine local geometries of the intersections." );
+
+      std::vector< FieldVector< ctype, dimension > > corners( geometry.corners() );
+      for( int i = 0; i < geometry.corners(); ++i )
+        corners[ i ] = geometry.corner( i );
+      return LocalGeometry( geometry.type(), corners );
+    }
+
+    static FieldVector< ctype, dimension-1 > referenceCenter ( const GeometryType &type )
+    {
+      return ReferenceElements< ctype, dimension-1 >::general( type ).position( 0, 0 );
+    }
+
+    GridView gridView_;
+    std::vector< Face > faces_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_UTILITY_INTERSECTIONTABLE_HH
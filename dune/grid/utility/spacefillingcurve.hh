@@ -0,0 +1,239 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_SPACEFILLINGCURVE_HH
+#define DUNE_GRID_UTILITY_SPACEFILLINGCURVE_HH
+
+/** \file
+    \brief Morton and Hilbert space-filling curves on a bounding box
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+namespace Dune
+{
+
+  /** \brief Map points of a bounding box to their position along a space-filling curve
+   *
+   * The bounding box is subdivided into \f$2^b\f$ intervals per direction,
+   * where \f$b\f$ is the largest number of bits such that the index of each
+   * of the resulting cells fits into an Index. The index of a point is the
+   * position of the cell containing it along the curve. Points outside the
+   * bounding box are mapped to the nearest cell.
+   *
+   * Two curves are available:
+   * - Morton (Z-order): the bits of the cell coordinates are interleaved.
+   *   Cheap to evaluate, but consecutive cells are not always neighbors.
+   * - Hilbert: consecutive cells are always face neighbors, which yields
+   *   more compact segments of the curve (computed by Skilling's algorithm,
+   *   AIP Conf. Proc. 707, 2004).
+   *
+   * \tparam ct  type of the coordinates
+   * \tparam dim dimension of the points
+   */
+  template< class ct, int dim >
+  class SpaceFillingCurve
+  {
+  public:
+    //! type of the curve
+    enum Type { morton, hilbert };
+
+    //! type of the index along the curve
+    typedef unsigned long Index;
+
+    //! type of the points
+    typedef FieldVector< ct, dim > Coordinate;
+
+    /** \brief construct the curve on a bounding box
+     *
+     * \param type   type of the curve
+     * \param lower  lower left corner of the bounding box
+     * \param upper  upper right corner of the bounding box
+     */
+    SpaceFillingCurve ( Type type, const Coordinate &lower, const Coordinate &upper )
+      : type_( type ), lower_( lower ),
+        bits_( std::min( int( std::numeric_limits< Index >::digits ) / dim,
+                         int( std::numeric_limits< double >::digits ) - 1 ) )
+    {
+      const double cells = std::ldexp( 1.0, bits_ );
+      for( int i = 0; i < dim; ++i )
+        scale_[ i ] = (upper[ i ] > lower[ i ]) ? cells / (upper[ i ] - lower[ i ]) : 0.0;
+    }
+
+    //! return the type of the curve
+    Type type () const { return type_; }
+
+    //! return the number of bits per direction
+    int bits () const { return bits_; }
+
+    //! return the position of x along the curve
+    Index index ( const Coordinate &x ) const
+    {
+      const Index maxCell = ((Index( 1 ) << (bits_-1)) - 1) * 2 + 1;
+      Index cell[ dim ];
+      for( int i = 0; i < dim; ++i )
+      {
+        const double t = std::max( (x[ i ] - lower_[ i ]) * scale_[ i ], 0.0 );
+        cell[ i ] = std::min( Index( t ), maxCell );
+      }
+
+      if( type_ == hilbert )
+        hilbertTranspose( cell );
+
+      // interleave the bits, most significant first
+      Index index = 0;
+      for( int b = bits_-1; b >= 0; --b )
+        for( int i = 0; i < dim; ++i )
+          index = (index << 1) | ((cell[ i ] >> b) & 1);
+      return index;
+    }
+
+    //! compare two points by their position along the curve
+    bool operator() ( const Coordinate &a, const Coordinate &b ) const
+    {
+      return index( a ) < index( b );
+    }
+
+  private:
+    // transform cell coordinates into the transposed Hilbert index
+    void hilbertTranspose ( Index (&x)[ dim ] ) const
+    {
+      const Index m = Index( 1 ) << (bits_-1);
+
+      // inverse undo of the excess work
+      for( Index q = m; q > 1; q >>= 1 )
+      {
+        const Index p = q-1;
+        for( int i = 0; i < dim; ++i )
+        {
+          if( x[ i ] & q )
+            x[ 0 ] ^= p;
+          else
+          {
+            const Index t = (x[ 0 ] ^ x[ i ]) & p;
+            x[ 0 ] ^= t;
+            x[ i ] ^= t;
+          }
+        }
+      }
+
+      // Gray encode
+      for( int i = 1; i < dim; ++i )
+        x[ i ] ^= x[ i-1 ];
+      Index t = 0;
+      for( Index q = m; q > 1; q >>= 1 )
+      {
+        if( x[ dim-1 ] & q )
+          t ^= q-1;
+      }
+      for( int i = 0; i < dim; ++i )
+        x[ i ] ^= t;
+    }
+
+    Type type_;
+    Coordinate lower_;
+    FieldVector< double, dim > scale_;
+    int bits_;
+  };
+
+
+
+  /** \brief split weighted points into contiguous segments of a space-filling curve
+   *
+   * The points are sorted along the curve, which is then cut into
+   * numParts segments of (approximately) equal weight. A point belongs to
+   * the segment containing the midpoint of its weight interval.
+   *
+   * \param[in]  curve     the space-filling curve
+   * \param[in]  points    the points to distribute
+   * \param[in]  weights   nonnegative weight of each point
+   * \param[in]  numParts  number of segments
+   * \param[out] part      segment (0, ..., numParts-1) of each point
+   */
+  template< class ct, int dim >
+  inline void partitionSpaceFillingCurve ( const SpaceFillingCurve< ct, dim > &curve,
+                                           const std::vector< FieldVector< ct, dim > > &points,
+                                           const std::vector< double > &weights,
+                                           int numParts,
+                                           std::vector< int > &part )
+  {
+    typedef typename SpaceFillingCurve< ct, dim >::Index Index;
+
+    const std::size_t size = points.size();
+    if( weights.size() != size )
+      DUNE_THROW( RangeError, "partitionSpaceFillingCurve: number of weights does not match number of points." );
+    if( numParts <= 0 )
+      DUNE_THROW( RangeError, "partitionSpaceFillingCurve: number of parts must be positive." );
+
+    std::vector< std::pair< Index, std::size_t > > order( size );
+    double total = 0.0;
+    for( std::size_t k = 0; k < size; ++k )
+    {
+      order[ k ] = std::make_pair( curve.index( points[ k ] ), k );
+      total += weights[ k ];
+    }
+    std::sort( order.begin(), order.end() );
+
+    part.resize( size );
+    double prefix = 0.0;
+    for( std::size_t j = 0; j < size; ++j )
+    {
+      const std::size_t k = order[ j ].second;
+      const double mid = prefix + 0.5*weights[ k ];
+      prefix += weights[ k ];
+      const int p = (total > 0.0) ? int( mid * numParts / total ) : int( (j * numParts) / size );
+      part[ k ] = std::min( std::max( p, 0 ), numParts-1 );
+    }
+  }
+
+
+
+  /** \brief sort points along a space-filling curve through their bounding box
+   *
+   * Points in the same cell of the curve keep their relative order.
+   *
+   * \param[in]  type      type of the space-filling curve
+   * \param[in]  points    the points to sort
+   * \param[out] ordering  ordering[ j ] is the index of the j-th point along
+   *                       the curve
+   */
+  template< class ct, int dim, class Index >
+  inline void sortSpaceFillingCurve ( typename SpaceFillingCurve< ct, dim >::Type type,
+                                      const std::vector< FieldVector< ct, dim > > &points,
+                                      std::vector< Index > &ordering )
+  {
+    typedef SpaceFillingCurve< ct, dim > Curve;
+
+    const std::size_t size = points.size();
+    FieldVector< ct, dim > lower( 0 ), upper( 0 );
+    if( size > 0 )
+      lower = upper = points[ 0 ];
+    for( std::size_t k = 1; k < size; ++k )
+    {
+      for( int i = 0; i < dim; ++i )
+      {
+        lower[ i ] = std::min( lower[ i ], points[ k ][ i ] );
+        upper[ i ] = std::max( upper[ i ], points[ k ][ i ] );
+      }
+    }
+
+    const Curve curve( type, lower, upper );
+    std::vector< std::pair< typename Curve::Index, std::size_t > > order( size );
+    for( std::size_t k = 0; k < size; ++k )
+      order[ k ] = std::make_pair( curve.index( points[ k ] ), k );
+    std::sort( order.begin(), order.end() );
+
+    ordering.resize( size );
+    for( std::size_t j = 0; j < size; ++j )
+      ordering[ j ] = Index( order[ j ].second );
+  }
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_UTILITY_SPACEFILLINGCURVE_HH
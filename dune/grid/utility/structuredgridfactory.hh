@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdlib>
+#include <vector>
 
 #include <dune/common/array.hh>
 #include <dune/common/classname.hh>
@@ -17,7 +18,9 @@
 #include <dune/common/fvector.hh>
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/shared_ptr.hh>
+#include <dune/common/typetraits.hh>
 
+#include <dune/grid/common/capabilities.hh>
 #include <dune/grid/common/gridfactory.hh>
 #include <dune/grid/yaspgrid.hh>
 #include <dune/grid/sgrid.hh>
@@ -120,6 +123,255 @@ namespace Dune {
       return unitOffsets;
     }
 
+    /** \brief Compute the block of elements generated by one process
+
+        The elements are split into a Cartesian arrangement of blocks, one
+        per process. The prime factors of the number of processes are
+        assigned (largest first) to the direction with the most elements per
+        block. The block of process rank consists of the elements with
+        begin[i] <= index[i] < end[i].
+     */
+    static void computeBlock(const array<unsigned int,dim>& elements, int rank, int size,
+                             array<unsigned int,dim>& begin, array<unsigned int,dim>& end)
+    {
+      std::vector<int> factors;
+      for (int n=size, p=2; n>1; )
+      {
+        if (n % p == 0)
+        {
+          factors.push_back(p);
+          n /= p;
+        }
+        else
+          p++;
+      }
+
+      array<unsigned int,dim> blocks;
+      std::fill(blocks.begin(), blocks.end(), 1u);
+      for (int k=int(factors.size())-1; k>=0; k--)
+      {
+        int j = 0;
+        for (int i=1; i<dim; i++)
+          if (double(elements[i])/blocks[i] > double(elements[j])/blocks[j])
+            j = i;
+        blocks[j] *= factors[k];
+      }
+
+      for (int i=0; i<dim; i++)
+      {
+        const std::size_t b = rank % blocks[i];
+        rank /= blocks[i];
+        begin[i] = (elements[i]*b)/blocks[i];
+        end[i] = (elements[i]*(b+1))/blocks[i];
+      }
+    }
+
+    /** \brief Insert the vertices of a block of elements into a distributed factory
+
+        Every vertex is inserted with its lexicographic index in the global
+        structured grid.
+     */
+    static void insertBlockVertices(GridFactory<GridType>& factory,
+                                    const FieldVector<ctype,dimworld>& lowerLeft,
+                                    const FieldVector<ctype,dimworld>& upperRight,
+                                    const array<unsigned int,dim>& elements,
+                                    const array<unsigned int,dim>& begin,
+                                    const array<unsigned int,dim>& end)
+    {
+      array<unsigned int,dim> vertices, globalVertices;
+      for (int i=0; i<dim; i++)
+      {
+        vertices[i] = end[i]-begin[i]+1;
+        globalVertices[i] = elements[i]+1;
+      }
+      array<unsigned int, dim> globalOffsets = computeUnitOffsets(globalVertices);
+
+      MultiIndex index(vertices);
+      size_t numVertices = index.cycle();
+
+      for (size_t i=0; i<numVertices; i++, ++index) {
+
+        FieldVector<double,dimworld> pos(0);
+        size_t globalId = 0;
+        for (int j=0; j<dimworld; j++)
+        {
+          pos[j] = lowerLeft[j] + (begin[j]+index[j]) * (upperRight[j]-lowerLeft[j])/elements[j];
+          globalId += (begin[j]+index[j]) * size_t(globalOffsets[j]);
+        }
+
+        factory.insertVertex(pos, globalId);
+
+      }
+    }
+
+    static shared_ptr<GridType> createDistributedCubeGrid(const FieldVector<ctype,dimworld>& lowerLeft,
+                                                          const FieldVector<ctype,dimworld>& upperRight,
+                                                          const array<unsigned int,dim>& elements,
+                                                          const false_type&)
+    {
+      return createCubeGrid(lowerLeft, upperRight, elements);
+    }
+
+    static shared_ptr<GridType> createDistributedCubeGrid(const FieldVector<ctype,dimworld>& lowerLeft,
+                                                          const FieldVector<ctype,dimworld>& upperRight,
+                                                          const array<unsigned int,dim>& elements,
+                                                          const true_type&)
+    {
+      // The grid factory
+      GridFactory<GridType> factory;
+
+      const int rank = MPIHelper::getCollectiveCommunication().rank();
+      const int size = MPIHelper::getCollectiveCommunication().size();
+
+      array<unsigned int,dim> begin, end, blockElements;
+      computeBlock(elements, rank, size, begin, end);
+      for (int i=0; i<dim; i++)
+        blockElements[i] = end[i]-begin[i];
+
+      MultiIndex index(blockElements);
+      size_t numElements = index.cycle();
+
+      if (numElements > 0)
+      {
+        insertBlockVertices(factory, lowerLeft, upperRight, elements, begin, end);
+
+        array<unsigned int,dim> vertices = blockElements;
+        for (int i=0; i<dim; i++)
+          vertices[i]++;
+        array<unsigned int, dim> unitOffsets = computeUnitOffsets(vertices);
+
+        unsigned int nCorners = 1<<dim;
+        std::vector<unsigned int> cornersTemplate(nCorners,0);
+        for (size_t i=0; i<nCorners; i++)
+          for (int j=0; j<dim; j++)
+            if ( i & (1<<j) )
+              cornersTemplate[i] += unitOffsets[j];
+
+        for (size_t i=0; i<numElements; i++, ++index) {
+
+          unsigned int base = 0;
+          for (int j=0; j<dim; j++)
+            base += index[j] * unitOffsets[j];
+
+          std::vector<unsigned int> corners = cornersTemplate;
+          for (size_t j=0; j<corners.size(); j++)
+            corners[j] += base;
+
+          factory.insertElement
+            (GeometryType(GeometryType::cube, dim), corners);
+
+          // faces 2j and 2j+1 are the lower and upper faces in direction j
+          for (int j=0; j<dim; j++)
+          {
+            if ((index[j] == 0) && (begin[j] > 0))
+              factory.insertProcessBorder(i, 2*j);
+            if ((index[j]+1 == blockElements[j]) && (end[j] < elements[j]))
+              factory.insertProcessBorder(i, 2*j+1);
+          }
+
+        }
+      }
+
+      return shared_ptr<GridType>(factory.createGrid());
+    }
+
+    static shared_ptr<GridType> createDistributedSimplexGrid(const FieldVector<ctype,dimworld>& lowerLeft,
+                                                             const FieldVector<ctype,dimworld>& upperRight,
+                                                             const array<unsigned int,dim>& elements,
+                                                             const false_type&)
+    {
+      return createSimplexGrid(lowerLeft, upperRight, elements);
+    }
+
+    static shared_ptr<GridType> createDistributedSimplexGrid(const FieldVector<ctype,dimworld>& lowerLeft,
+                                                             const FieldVector<ctype,dimworld>& upperRight,
+                                                             const array<unsigned int,dim>& elements,
+                                                             const true_type&)
+    {
+      // The grid factory
+      GridFactory<GridType> factory;
+
+      const int rank = MPIHelper::getCollectiveCommunication().rank();
+      const int size = MPIHelper::getCollectiveCommunication().size();
+
+      array<unsigned int,dim> begin, end, blockElements;
+      computeBlock(elements, rank, size, begin, end);
+      for (int i=0; i<dim; i++)
+        blockElements[i] = end[i]-begin[i];
+
+      MultiIndex elementsIndex(blockElements);
+      size_t cycle = elementsIndex.cycle();
+
+      if (cycle > 0)
+      {
+        insertBlockVertices(factory, lowerLeft, upperRight, elements, begin, end);
+
+        array<unsigned int,dim> vertices = blockElements;
+        for (int i=0; i<dim; i++)
+          vertices[i]++;
+        array<unsigned int, dim> unitOffsets = computeUnitOffsets(vertices);
+
+        unsigned int element = 0;
+        for (size_t i=0; i<cycle; ++elementsIndex, i++) {
+
+          unsigned int base = 0;
+          for (int j=0; j<dim; j++)
+            base += elementsIndex[j] * unitOffsets[j];
+
+          std::vector<unsigned int> permutation(dim);
+          for (int j=0; j<dim; j++)
+            permutation[j] = j;
+
+          do {
+
+            // Make a simplex and remember the position of its corners in the block
+            std::vector<unsigned int> corners(dim+1);
+            std::vector<array<unsigned int,dim> > position(dim+1);
+            corners[0] = base;
+            for (int j=0; j<dim; j++)
+              position[0][j] = elementsIndex[j];
+
+            for (int j=0; j<dim; j++)
+            {
+              corners[j+1] = corners[j] + unitOffsets[permutation[j]];
+              position[j+1] = position[j];
+              position[j+1][permutation[j]]++;
+            }
+
+            factory.insertElement
+              (GeometryType(GeometryType::simplex, dim),
+              corners);
+
+            // face f is opposite to corner dim-f; it is a process border
+            // if all its corners lie on an inner side of the block
+            for (int f=0; f<=dim; f++)
+            {
+              for (int j=0; j<dim; j++)
+              {
+                bool lower = (begin[j] > 0), upper = (end[j] < elements[j]);
+                for (int k=0; k<=dim; k++)
+                {
+                  if (k == dim-f)
+                    continue;
+                  lower &= (position[k][j] == 0);
+                  upper &= (position[k][j] == blockElements[j]);
+                }
+                if (lower || upper)
+                  factory.insertProcessBorder(element, f);
+              }
+            }
+
+            element++;
+
+          } while (std::next_permutation(permutation.begin(),
+                                         permutation.end()));
+
+        }
+      }
+
+      return shared_ptr<GridType>(factory.createGrid());
+    }
+
   public:
 
     /** \brief Create a structured cube grid
@@ -262,6 +514,45 @@ namespace Dune {
       return shared_ptr<GridType>(factory.createGrid());
     }
 
+    /** \brief Create a structured cube grid distributed over all processes
+
+        Each process generates only its own block of elements and hands it to
+        the grid factory, so that no process ever holds the entire coarse grid.
+        The overlap or ghost elements are set up by the grid from the process
+        borders of the blocks.
+
+        This requires a grid factory accepting a distributed coarse grid (see
+        Capabilities::hasDistributedGridFactory). For other grids, the grid is
+        created on rank 0 as by createCubeGrid.
+
+        \note UGGrid is not supported: its grid factory needs the whole coarse
+              grid on rank 0, so call loadBalance() on the returned grid.
+
+        \param lowerLeft Lower left corner of the grid
+        \param upperRight Upper right corner of the grid
+        \param elements Number of elements in each coordinate direction
+     */
+    static shared_ptr<GridType> createDistributedCubeGrid(const FieldVector<ctype,dimworld>& lowerLeft,
+                                                          const FieldVector<ctype,dimworld>& upperRight,
+                                                          const array<unsigned int,dim>& elements)
+    {
+      integral_constant<bool, Capabilities::hasDistributedGridFactory<GridType>::v> distributed;
+      return createDistributedCubeGrid(lowerLeft, upperRight, elements, distributed);
+    }
+
+    /** \brief Create a structured simplex grid distributed over all processes
+
+        The simplex counterpart of createDistributedCubeGrid, using the same
+        triangulation as createSimplexGrid.
+     */
+    static shared_ptr<GridType> createDistributedSimplexGrid(const FieldVector<ctype,dimworld>& lowerLeft,
+                                                             const FieldVector<ctype,dimworld>& upperRight,
+                                                             const array<unsigned int,dim>& elements)
+    {
+      integral_constant<bool, Capabilities::hasDistributedGridFactory<GridType>::v> distributed;
+      return createDistributedSimplexGrid(lowerLeft, upperRight, elements, distributed);
+    }
+
   };
 
   /** \brief Specialization of the StructuredGridFactory for YaspGrid
@@ -308,6 +599,18 @@ namespace Dune {
                              std::bitset<dim>(false), 0));
     }
 
+    /** \brief Create a structured cube grid distributed over all processes
+
+        YaspGrid is always distributed, so this is the same as createCubeGrid.
+     */
+    static shared_ptr<GridType>
+    createDistributedCubeGrid(const FieldVector<ctype,dimworld>& lowerLeft,
+                              const FieldVector<ctype,dimworld>& upperRight,
+                              const array<unsigned int,dim>& elements)
+    {
+      return createCubeGrid(lowerLeft, upperRight, elements);
+    }
+
     /** \brief Create a structured simplex grid
 
         \note Simplices are not supported in YaspGrid, so this functions
@@ -0,0 +1,161 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+/** \file
+    \brief A unit test for the distributed construction of the StructuredGridFactory
+
+    Run it on more than one process (see mpidistributedstructuredgridfactorytest)
+    to check the process borders inserted for each block.
+ */
+
+#include <config.h>
+
+#include <iostream>
+
+#include <dune/common/parallel/mpihelper.hh>
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#endif
+
+#include <dune/grid/utility/structuredgridfactory.hh>
+#include <dune/grid/test/gridcheck.cc>
+
+using namespace Dune;
+
+// count the interior elements of a distributed grid on all processes
+template <class GridType>
+int globalInteriorSize(const GridType& grid)
+{
+  typedef typename GridType::LeafGridView GridView;
+  typedef typename GridView::template Codim<0>::template Partition<Interior_Partition>::Iterator Iterator;
+
+  const GridView gridView = grid.leafGridView();
+  int size = 0;
+  const Iterator end = gridView.template end<0,Interior_Partition>();
+  for (Iterator it = gridView.template begin<0,Interior_Partition>(); it != end; ++it)
+    size++;
+  return grid.comm().sum(size);
+}
+
+// count the faces of interior elements shared with another process on all processes
+template <class GridType>
+int globalProcessBorderSize(const GridType& grid)
+{
+  typedef typename GridType::LeafGridView GridView;
+  typedef typename GridView::template Codim<0>::template Partition<Interior_Partition>::Iterator Iterator;
+  typedef typename GridView::IntersectionIterator IntersectionIterator;
+
+  const GridView gridView = grid.leafGridView();
+  int size = 0;
+  const Iterator end = gridView.template end<0,Interior_Partition>();
+  for (Iterator it = gridView.template begin<0,Interior_Partition>(); it != end; ++it)
+  {
+    const IntersectionIterator iend = gridView.iend(*it);
+    for (IntersectionIterator iit = gridView.ibegin(*it); iit != iend; ++iit)
+    {
+      if (iit->boundary())
+        continue;
+      if (!iit->neighbor() || (iit->outside()->partitionType() != InteriorEntity))
+        size++;
+    }
+  }
+  return grid.comm().sum(size);
+}
+
+// Check a grid created from elements[0] x elements[1] x elements[2] cubes,
+// each of which is split into elementsPerCube elements with facesPerCubeFace
+// faces on each side of the cube.  On two processes, the blocks are split
+// in the direction with the most elements, which has to be direction 0.
+template <class GridType>
+void checkDistributedGrid(const GridType& grid, const array<unsigned int,3>& elements,
+                          int elementsPerCube, int facesPerCubeFace)
+{
+  const int numElements = elementsPerCube * elements[0] * elements[1] * elements[2];
+  const int interiorSize = globalInteriorSize(grid);
+  if (interiorSize != numElements)
+    DUNE_THROW(GridError, "distributed grid has " << interiorSize << " interior elements instead of "
+                                                  << numElements);
+
+  const int size = grid.comm().size();
+  if (grid.comm().min(grid.leafGridView().size(0)) == 0)
+    DUNE_THROW(GridError, "distributed grid has a process without elements");
+
+  const int borderSize = globalProcessBorderSize(grid);
+  const int expectedBorderSize = 2 * facesPerCubeFace * elements[1] * elements[2];
+  if ((size == 1) && (borderSize != 0))
+    DUNE_THROW(GridError, "sequential grid has " << borderSize << " process border faces");
+  if ((size == 2) && (borderSize != expectedBorderSize))
+    DUNE_THROW(GridError, "distributed grid has " << borderSize << " process border faces instead of "
+                                                  << expectedBorderSize);
+  if ((size > 2) && (borderSize == 0))
+    DUNE_THROW(GridError, "distributed grid has no process borders");
+
+  gridcheck(grid);
+}
+
+
+int main (int argc , char **argv)
+try {
+
+  // this method calls MPI_Init, if MPI is enabled
+  MPIHelper & mpihelper = MPIHelper::instance(argc,argv);
+
+  array<unsigned int,3> elements3d;
+  elements3d.fill(4);
+  elements3d[0] = 6;
+
+  // Test distributed creation of 3d grids, each process inserts its own block
+#if HAVE_ALUGRID
+  {
+    typedef ALUGrid<3,3,cube,nonconforming> ALUHexahedralGridType;
+    shared_ptr<ALUHexahedralGridType> aluHexahedralGrid
+      = StructuredGridFactory<ALUHexahedralGridType>::createDistributedCubeGrid(FieldVector<double,3>(0),
+                                                                                FieldVector<double,3>(1),
+                                                                                elements3d);
+    checkDistributedGrid(*aluHexahedralGrid, elements3d, 1, 1);
+
+    // each square face of the Kuhn triangulation is split into 2 triangles
+    typedef ALUGrid<3,3,simplex,nonconforming> ALUTetrahedralGridType;
+    shared_ptr<ALUTetrahedralGridType> aluTetrahedralGrid
+      = StructuredGridFactory<ALUTetrahedralGridType>::createDistributedSimplexGrid(FieldVector<double,3>(0),
+                                                                                    FieldVector<double,3>(1),
+                                                                                    elements3d);
+    checkDistributedGrid(*aluTetrahedralGrid, elements3d, 6, 2);
+  }
+#else
+  std::cout << "WARNING: distributed creation of 3d grids not tested because ALUGrid is not available!" << std::endl;
+#endif
+
+  // UGGrid has no distributed grid factory, the grid is created on rank 0
+  // and has to be distributed by loadBalance
+#if HAVE_UG
+#ifndef ModelP
+  if (mpihelper.size() == 1)
+#endif
+  {
+    typedef UGGrid<3> HexahedralGridType;
+    shared_ptr<HexahedralGridType> hexahedralGrid
+      = StructuredGridFactory<HexahedralGridType>::createDistributedCubeGrid(FieldVector<double,3>(0),
+                                                                             FieldVector<double,3>(1),
+                                                                             elements3d);
+    hexahedralGrid->loadBalance();
+
+    const int interiorSize = globalInteriorSize(*hexahedralGrid);
+    if (interiorSize != int(elements3d[0]*elements3d[1]*elements3d[2]))
+      DUNE_THROW(GridError, "UGGrid has " << interiorSize << " interior elements after loadBalance");
+    gridcheck(*hexahedralGrid);
+  }
+#endif
+
+  return 0;
+
+}
+catch (Exception &e) {
+  std::cerr << e << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Generic exception!" << std::endl;
+  return 2;
+}
@@ -0,0 +1,213 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the ElementColoring class
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include "../elementcoloring.hh"
+#include "testgrids.hh"
+
+// count how often each element is visited
+template< class IndexSet >
+struct CountVisits
+{
+  CountVisits ( const IndexSet &indexSet, std::vector< int > &visits )
+    : indexSet_( &indexSet ), visits_( &visits )
+  {}
+
+  template< class Element >
+  void operator() ( const Element &element ) const
+  {
+    ++(*visits_)[ indexSet_->index( element ) ];
+  }
+
+private:
+  const IndexSet *indexSet_;
+  std::vector< int > *visits_;
+};
+
+// detect whether two threads work on elements sharing a vertex at the same time
+template< class IndexSet >
+struct DetectConflicts
+{
+  static const int dimension = IndexSet::dimension;
+
+  DetectConflicts ( const IndexSet &indexSet, std::vector< int > &busy,
+                    std::vector< int > &threadUsed, int &conflicts )
+    : indexSet_( &indexSet ), busy_( &busy ), threadUsed_( &threadUsed ), conflicts_( &conflicts )
+  {}
+
+  template< class Element >
+  void operator() ( const Element &element ) const
+  {
+    const int numVertices = element.template count< dimension >();
+    for( int i = 0; i < numVertices; ++i )
+    {
+      int &busy = (*busy_)[ indexSet_->subIndex( element, i, dimension ) ];
+      int before;
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+      before = busy++;
+      if( before != 0 )
+      {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++(*conflicts_);
+      }
+    }
+
+    // keep the vertices busy for a while, like an assembler would
+    double work = 0.0;
+    for( int k = 0; k < 1000; ++k )
+      work += element.geometry().center()[ 0 ];
+    if( work < 0.0 )
+      DUNE_THROW( Dune::Exception, "Element has a negative center" );
+
+    for( int i = 0; i < numVertices; ++i )
+    {
+      int &busy = (*busy_)[ indexSet_->subIndex( element, i, dimension ) ];
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      --busy;
+    }
+
+#ifdef _OPENMP
+    (*threadUsed_)[ omp_get_thread_num() ] = 1;
+#else
+    (*threadUsed_)[ 0 ] = 1;
+#endif
+  }
+
+private:
+  const IndexSet *indexSet_;
+  std::vector< int > *busy_;
+  std::vector< int > *threadUsed_;
+  int *conflicts_;
+};
+
+// elements of different blocks of one phase must not share a vertex,
+// each element has to be contained in exactly one block
+template< class GridView >
+void checkColoring ( const GridView &gridView, const Dune::ElementColoring< GridView > &coloring )
+{
+  typedef Dune::ElementColoring< GridView > Coloring;
+  typedef typename Coloring::Block Block;
+  const int dim = GridView::dimension;
+
+  const typename GridView::IndexSet &indexSet = gridView.indexSet();
+  const typename GridView::Grid &grid = gridView.grid();
+
+  std::vector< int > count( indexSet.size( 0 ), 0 );
+  for( int phase = 0; phase < coloring.phases(); ++phase )
+  {
+    std::vector< int > vertexBlock( indexSet.size( dim ), -1 );
+    for( int b = 0; b < coloring.blocks( phase ); ++b )
+    {
+      const Block &block = coloring.block( phase, b );
+      for( typename Block::const_iterator it = block.begin(); it != block.end(); ++it )
+      {
+        const typename GridView::template Codim< 0 >::EntityPointer ep = grid.entityPointer( *it );
+        ++count[ indexSet.index( *ep ) ];
+        for( int i = 0; i < ep->template count< dim >(); ++i )
+        {
+          int &owner = vertexBlock[ indexSet.subIndex( *ep, i, dim ) ];
+          if( (owner >= 0) && (owner != b) )
+            DUNE_THROW( Dune::Exception, "Blocks " << owner << " and " << b << " of phase " << phase << " share a vertex" );
+          owner = b;
+        }
+      }
+    }
+  }
+
+  for( std::size_t k = 0; k < count.size(); ++k )
+  {
+    if( count[ k ] != 1 )
+      DUNE_THROW( Dune::Exception, "Element " << k << " is contained " << count[ k ] << " times" );
+  }
+
+  std::vector< int > visits( indexSet.size( 0 ), 0 );
+  coloring.forEach( CountVisits< typename GridView::IndexSet >( indexSet, visits ) );
+  for( std::size_t k = 0; k < visits.size(); ++k )
+  {
+    if( visits[ k ] != 1 )
+      DUNE_THROW( Dune::Exception, "forEach visits element " << k << " " << visits[ k ] << " times" );
+  }
+
+  // YaspGrid entities can be obtained from seeds concurrently, so force the
+  // threaded path and make sure no two threads touch the same vertex
+#ifdef _OPENMP
+  const int numThreads = omp_get_max_threads();
+#else
+  const int numThreads = 1;
+#endif
+  std::vector< int > busy( indexSet.size( dim ), 0 ), threadUsed( numThreads, 0 );
+  int conflicts = 0;
+  coloring.forEach( DetectConflicts< typename GridView::IndexSet >( indexSet, busy, threadUsed, conflicts ), true );
+  if( conflicts > 0 )
+    DUNE_THROW( Dune::Exception, "forEach worked on " << conflicts << " shared vertices concurrently" );
+  const int threadsUsed = std::count( threadUsed.begin(), threadUsed.end(), 1 );
+  std::cout << "forEach used " << threadsUsed << " of " << numThreads << " threads" << std::endl;
+}
+
+template< int dim >
+void testColoring ()
+{
+  typedef Dune::YaspGrid< dim > Grid;
+  typedef typename Grid::LeafGridView GridView;
+  typedef Dune::ElementColoring< GridView > Coloring;
+
+  Dune::shared_ptr< Grid > grid = createUnitCubeGrid< Grid >( 8 );
+  const GridView gridView = grid->leafGridView();
+
+  const Coloring coloring( gridView, Coloring::greedyColoring, 4 );
+  // on a structured grid, the greedy coloring needs 2^dim colors
+  if( coloring.phases() != (1 << dim) )
+    DUNE_THROW( Dune::Exception, "Greedy coloring uses " << coloring.phases() << " colors" );
+  checkColoring( gridView, coloring );
+
+  const Coloring chunks( gridView, Coloring::separatedChunks, 4 );
+  if( chunks.phases() != 2 )
+    DUNE_THROW( Dune::Exception, "Separated chunks use " << chunks.phases() << " phases" );
+  checkColoring( gridView, chunks );
+
+  grid->globalRefine( 1 );
+  Coloring refined( grid->leafGridView(), Coloring::separatedChunks, 3 );
+  checkColoring( grid->leafGridView(), refined );
+}
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  testColoring< 2 >();
+  testColoring< 3 >();
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
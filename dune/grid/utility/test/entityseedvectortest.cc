@@ -0,0 +1,114 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the EntitySeedVector class
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#endif
+
+#include "../entityseedvector.hh"
+#include "testgrids.hh"
+
+// the seed vector has to reproduce the iteration order and the indices
+template< class SeedVector >
+void checkSeedVector ( const SeedVector &seeds )
+{
+  typedef typename SeedVector::Grid::LeafGridView GridView;
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+
+  const GridView &gridView = seeds.gridView();
+  if( seeds.size() != int( gridView.indexSet().size( 0 ) ) )
+    DUNE_THROW( Dune::Exception, "EntitySeedVector has wrong size: " << seeds.size() );
+
+  int i = 0;
+  const Iterator end = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != end; ++it, ++i )
+  {
+    if( seeds[ i ] != it )
+      DUNE_THROW( Dune::Exception, "Entity " << i << " does not match the iterator" );
+    if( gridView.grid().entityPointer( seeds.seed( i ) ) != it )
+      DUNE_THROW( Dune::Exception, "Seed " << i << " does not match the iterator" );
+    if( seeds.index( i ) != gridView.indexSet().index( *it ) )
+      DUNE_THROW( Dune::Exception, "Entity " << i << " has a wrong index" );
+  }
+
+  // the ranges have to cover all positions
+  const int numParts = 3;
+  int next = 0;
+  for( int part = 0; part < numParts; ++part )
+  {
+    const std::pair< int, int > range = seeds.range( part, numParts );
+    if( range.first != next )
+      DUNE_THROW( Dune::Exception, "Ranges are not contiguous" );
+    next = range.second;
+  }
+  if( next != seeds.size() )
+    DUNE_THROW( Dune::Exception, "Ranges do not cover all entities" );
+}
+
+template< class Grid >
+void checkGrid ( Grid &grid )
+{
+  typedef typename Grid::LeafGridView GridView;
+
+  Dune::EntitySeedVector< GridView > seeds( grid.leafGridView() );
+  checkSeedVector( seeds );
+
+  // after adaptation, update() has to rebuild the vector
+  grid.globalRefine( 1 );
+  seeds.update();
+  checkSeedVector( seeds );
+}
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  {
+    typedef Dune::YaspGrid< 2 > Grid;
+    Dune::shared_ptr< Grid > grid = createUnitCubeGrid< Grid >( 4 );
+    checkGrid( *grid );
+  }
+
+  // unstructured grids, whose entities are obtained from the seeds by the grid
+#if HAVE_UG
+  {
+    typedef Dune::UGGrid< 2 > Grid;
+    Dune::shared_ptr< Grid > grid = createShuffledSimplexGrid< Grid >( 4 );
+    checkGrid( *grid );
+  }
+#endif
+#if HAVE_ALUGRID
+  {
+    typedef Dune::ALUGrid< 3, 3, Dune::simplex, Dune::nonconforming > Grid;
+    Dune::shared_ptr< Grid > grid = createShuffledSimplexGrid< Grid >( 2 );
+    checkGrid( *grid );
+  }
+#endif
+
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
@@ -0,0 +1,190 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the IntersectionTable
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#endif
+
+#include "../intersectiontable.hh"
+#include "testgrids.hh"
+
+// each intersection has to be stored exactly once, with the data of the
+// intersection iterator, and the faces of each element have to be closed
+template< class GridView >
+void checkTable ( const Dune::IntersectionTable< GridView > &table, const GridView &gridView )
+{
+  typedef Dune::IntersectionTable< GridView > Table;
+  typedef typename GridView::template Codim< 0 >::Iterator ElementIterator;
+  typedef typename GridView::IntersectionIterator IntersectionIterator;
+  typedef typename Table::GlobalCoordinate GlobalCoordinate;
+  const int dim = GridView::dimension;
+
+  const typename GridView::IndexSet &indexSet = gridView.indexSet();
+
+  // count the intersections seen from both sides once
+  std::size_t count = 0;
+  const ElementIterator end = gridView.template end< 0 >();
+  for( ElementIterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    const IntersectionIterator iend = gridView.iend( *it );
+    for( IntersectionIterator iit = gridView.ibegin( *it ); iit != iend; ++iit )
+    {
+      if( !iit->neighbor() || (indexSet.index( *it ) < indexSet.index( *iit->outside() )) )
+        ++count;
+    }
+  }
+  if( table.size() != count )
+    DUNE_THROW( Dune::Exception, "Table contains " << table.size() << " intersections instead of " << count << "." );
+
+  // the outer normals of the faces of each element have to sum up to zero
+  std::vector< GlobalCoordinate > normalSum( indexSet.size( 0 ), GlobalCoordinate( 0 ) );
+  std::vector< bool > closed( indexSet.size( 0 ), true );
+  for( typename Table::Iterator fit = table.begin(); fit != table.end(); ++fit )
+  {
+    if( fit->neighbor && !(fit->inside < fit->outside) )
+      DUNE_THROW( Dune::Exception, "Intersection not stored from the element of smaller index." );
+    const double referenceVolume = Dune::ReferenceElements< double, dim-1 >::general( fit->type ).volume();
+    if( std::abs( fit->volume - fit->integrationElement * referenceVolume ) > 1e-8 )
+      DUNE_THROW( Dune::Exception, "Volume and integration element do not match." );
+    if( std::abs( fit->unitOuterNormal.two_norm() - 1.0 ) > 1e-8 )
+      DUNE_THROW( Dune::Exception, "Outer normal does not have unit length." );
+
+    // elements at process borders have faces without neighbor in the grid view
+    if( !fit->neighbor && !fit->boundary )
+      closed[ fit->inside ] = false;
+
+    normalSum[ fit->inside ].axpy( fit->volume, fit->unitOuterNormal );
+    if( fit->neighbor )
+      normalSum[ fit->outside ].axpy( -fit->volume, fit->unitOuterNormal );
+  }
+
+  for( ElementIterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    const int index = indexSet.index( *it );
+    if( closed[ index ] && (normalSum[ index ].two_norm() > 1e-8) )
+      DUNE_THROW( Dune::Exception, "Faces of element " << index << " are not closed." );
+
+    // the geometry in the inside element has to map onto the face
+    const IntersectionIterator iend = gridView.iend( *it );
+    for( IntersectionIterator iit = gridView.ibegin( *it ); iit != iend; ++iit )
+    {
+      const GlobalCoordinate center = iit->geometry().center();
+      bool found = false;
+      for( typename Table::Iterator fit = table.begin(); !found && (fit != table.end()); ++fit )
+      {
+        if( (fit->inside != indexSet.index( *it )) || (fit->indexInInside != iit->indexInInside()) )
+          continue;
+        GlobalCoordinate diff = it->geometry().global( fit->geometryInInside.center() );
+        diff -= center;
+        found = (diff.two_norm() < 1e-8);
+      }
+      if( !found && !(iit->neighbor() && (indexSet.index( *iit->outside() ) < indexSet.index( *it ))) )
+        DUNE_THROW( Dune::Exception, "Intersection of element " << indexSet.index( *it ) << " not found in table." );
+    }
+  }
+
+  std::cout << "intersection table of " << indexSet.size( 0 ) << " elements contains "
+            << table.size() << " intersections (dimension " << dim << ")" << std::endl;
+}
+
+// number of intersections in the table that are not conforming
+template< class GridView >
+std::size_t nonconformingSize ( const Dune::IntersectionTable< GridView > &table )
+{
+  typedef Dune::IntersectionTable< GridView > Table;
+  std::size_t count = 0;
+  for( typename Table::Iterator fit = table.begin(); fit != table.end(); ++fit )
+  {
+    if( !fit->conforming )
+      ++count;
+  }
+  return count;
+}
+
+template< class Grid >
+void checkGrid ( Grid &grid, bool nonconforming = false )
+{
+  typedef typename Grid::LeafGridView GridView;
+  const GridView gridView = grid.leafGridView();
+
+  Dune::IntersectionTable< GridView > table( gridView );
+  checkTable( table, gridView );
+  if( nonconforming && (nonconformingSize( table ) == 0) )
+    DUNE_THROW( Dune::Exception, "Table of a nonconforming grid view contains no nonconforming intersections." );
+
+  // the table has to follow the grid
+  grid.globalRefine( 1 );
+  table.update();
+  checkTable( table, gridView );
+}
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  const int dim = 2;
+
+  {
+    typedef Dune::YaspGrid< dim > Grid;
+    Dune::shared_ptr< Grid > grid = createUnitCubeGrid< Grid >( 4 );
+    checkGrid( *grid );
+  }
+
+#if HAVE_UG
+  {
+    // local refinement without closure yields a nonconforming leaf grid view
+    typedef Dune::UGGrid< dim > Grid;
+    Dune::shared_ptr< Grid > grid = createUnitCubeGrid< Grid >( 4 );
+    grid->setClosureType( Grid::NONE );
+    grid->mark( 1, *grid->leafbegin< 0 >() );
+    grid->preAdapt();
+    grid->adapt();
+    grid->postAdapt();
+    checkGrid( *grid, true );
+  }
+#endif
+
+#if HAVE_ALUGRID
+  {
+    // ALUGrid refines without closure, so the refined element has hanging nodes
+    typedef Dune::ALUGrid< 3, 3, Dune::cube, Dune::nonconforming > Grid;
+    Dune::shared_ptr< Grid > grid = createUnitCubeGrid< Grid >( 2 );
+    grid->mark( 1, *grid->leafbegin< 0 >() );
+    grid->preAdapt();
+    grid->adapt();
+    grid->postAdapt();
+    checkGrid( *grid, true );
+  }
+#endif
+
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
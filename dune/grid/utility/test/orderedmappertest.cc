@@ -0,0 +1,180 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the OrderedMultipleCodimMultipleGeomTypeMapper
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#if HAVE_UG
+#include <dune/grid/uggrid.hh>
+#endif
+#if HAVE_ALUGRID
+#include <dune/grid/alugrid.hh>
+#endif
+#include <dune/grid/common/mcmgmapper.hh>
+
+#include "../orderedmapper.hh"
+#include "testgrids.hh"
+
+// the mapper has to be a bijection onto 0, ..., size-1 with the same domain
+// as the host mapper, consistent for entities and subentities; returns the
+// bandwidth of the mapper and of the host mapper
+template< class Mapper, class HostMapper, class Layout, class GridView >
+std::pair< int, int > checkMapper ( const Mapper &mapper, const HostMapper &hostMapper, Layout layout, const GridView &gridView )
+{
+  typedef typename GridView::template Codim< 0 >::Iterator Iterator;
+  const int dim = GridView::dimension;
+
+  if( mapper.size() != hostMapper.size() )
+    DUNE_THROW( Dune::Exception, "Mapper has wrong size: " << mapper.size() );
+
+  std::vector< int > host( mapper.size(), -1 );
+  int bandwidth = 0, hostBandwidth = 0;
+  const Iterator end = gridView.template end< 0 >();
+  for( Iterator it = gridView.template begin< 0 >(); it != end; ++it )
+  {
+    const Dune::ReferenceElement< double, dim > &refElement
+      = Dune::ReferenceElements< double, dim >::general( it->type() );
+
+    std::vector< int > indices, hostIndices;
+    for( int codim = 0; codim <= dim; ++codim )
+    {
+      for( int i = 0; i < refElement.size( codim ); ++i )
+      {
+        int index, hostIndex;
+        const bool contained = mapper.contains( *it, i, codim, index );
+        if( contained != layout.contains( refElement.type( i, codim ) ) )
+          DUNE_THROW( Dune::Exception, "Mapper::contains() does not agree with the layout" );
+        if( !contained )
+          continue;
+        hostIndex = hostMapper.map( *it, i, codim );
+        if( (index < 0) || (index >= mapper.size()) )
+          DUNE_THROW( Dune::Exception, "Index out of range: " << index );
+        if( (host[ index ] >= 0) && (host[ index ] != hostIndex) )
+          DUNE_THROW( Dune::Exception, "Index " << index << " is used for two entities" );
+        host[ index ] = hostIndex;
+        indices.push_back( index );
+        hostIndices.push_back( hostIndex );
+      }
+    }
+
+    int index;
+    if( mapper.contains( *it, index ) && (index != mapper.map( *it, 0, 0 )) )
+      DUNE_THROW( Dune::Exception, "Element index does not match its subentity index" );
+
+    if( indices.empty() )
+      continue;
+    bandwidth = std::max( bandwidth, *std::max_element( indices.begin(), indices.end() )
+                          - *std::min_element( indices.begin(), indices.end() ) );
+    hostBandwidth = std::max( hostBandwidth, *std::max_element( hostIndices.begin(), hostIndices.end() )
+                              - *std::min_element( hostIndices.begin(), hostIndices.end() ) );
+  }
+
+  if( std::count( host.begin(), host.end(), -1 ) > 0 )
+    DUNE_THROW( Dune::Exception, "Mapper is not surjective" );
+
+  std::cout << "bandwidth: " << bandwidth << " (host mapper: " << hostBandwidth << ")" << std::endl;
+  return std::make_pair( bandwidth, hostBandwidth );
+}
+
+template< class GridView, template< int > class Layout >
+void checkOrderings ( const GridView &gridView )
+{
+  typedef Dune::MultipleCodimMultipleGeomTypeMapper< GridView, Layout > HostMapper;
+  typedef Dune::OrderedMultipleCodimMultipleGeomTypeMapper< GridView, Layout > Mapper;
+
+  const HostMapper hostMapper( gridView );
+  const Mapper rcmMapper( gridView, Mapper::reverseCuthillMcKee );
+  checkMapper( rcmMapper, hostMapper, Layout< GridView::dimension >(), gridView );
+  const Mapper hilbertMapper( gridView, Mapper::hilbertCurve );
+  checkMapper( hilbertMapper, hostMapper, Layout< GridView::dimension >(), gridView );
+}
+
+// the macro grid was inserted in a shuffled order, so the reverse
+// Cuthill-McKee ordering has to reduce the bandwidth of the host mapper
+template< class GridView, template< int > class Layout >
+void checkBandwidthReduction ( const GridView &gridView )
+{
+  typedef Dune::MultipleCodimMultipleGeomTypeMapper< GridView, Layout > HostMapper;
+  typedef Dune::OrderedMultipleCodimMultipleGeomTypeMapper< GridView, Layout > Mapper;
+
+  const HostMapper hostMapper( gridView );
+  const Mapper rcmMapper( gridView, Mapper::reverseCuthillMcKee );
+  const std::pair< int, int > bandwidth
+    = checkMapper( rcmMapper, hostMapper, Layout< GridView::dimension >(), gridView );
+  if( bandwidth.first >= bandwidth.second )
+    DUNE_THROW( Dune::Exception, "Reverse Cuthill-McKee ordering has bandwidth " << bandwidth.first
+                                 << ", host mapper has " << bandwidth.second );
+}
+
+template< int dim >
+struct MCMGAllLayout
+{
+  bool contains ( Dune::GeometryType gt ) const { return true; }
+};
+
+int main ( int argc, char **argv )
+try
+{
+  Dune::MPIHelper::instance( argc, argv );
+
+  const int dim = 2;
+  typedef Dune::YaspGrid< dim > Grid;
+  typedef Grid::LeafGridView GridView;
+
+  Dune::shared_ptr< Grid > grid = createUnitCubeGrid< Grid >( 8 );
+  const GridView gridView = grid->leafGridView();
+
+  checkOrderings< GridView, Dune::MCMGVertexLayout >( gridView );
+  checkOrderings< GridView, Dune::MCMGElementLayout >( gridView );
+  checkOrderings< GridView, MCMGAllLayout >( gridView );
+
+  // the mapper has to follow the grid
+  Dune::OrderedMultipleCodimMultipleGeomTypeMapper< GridView, Dune::MCMGVertexLayout > mapper( gridView );
+  grid->globalRefine( 1 );
+  mapper.update();
+  checkMapper( mapper, Dune::MultipleCodimMultipleGeomTypeMapper< GridView, Dune::MCMGVertexLayout >( gridView ),
+               Dune::MCMGVertexLayout< dim >(), gridView );
+
+  // unstructured grids numbering the macro grid in insertion order
+#if HAVE_UG
+  {
+    typedef Dune::UGGrid< 2 > UnstructuredGrid;
+    Dune::shared_ptr< UnstructuredGrid > unstructuredGrid = createShuffledSimplexGrid< UnstructuredGrid >( 8 );
+    checkOrderings< UnstructuredGrid::LeafGridView, Dune::MCMGVertexLayout >( unstructuredGrid->leafGridView() );
+    checkBandwidthReduction< UnstructuredGrid::LeafGridView, Dune::MCMGVertexLayout >( unstructuredGrid->leafGridView() );
+    checkBandwidthReduction< UnstructuredGrid::LeafGridView, MCMGAllLayout >( unstructuredGrid->leafGridView() );
+  }
+#endif
+#if HAVE_ALUGRID
+  {
+    typedef Dune::ALUGrid< 3, 3, Dune::simplex, Dune::nonconforming > UnstructuredGrid;
+    Dune::shared_ptr< UnstructuredGrid > unstructuredGrid = createShuffledSimplexGrid< UnstructuredGrid >( 4 );
+    checkOrderings< UnstructuredGrid::LeafGridView, Dune::MCMGVertexLayout >( unstructuredGrid->leafGridView() );
+    checkBandwidthReduction< UnstructuredGrid::LeafGridView, Dune::MCMGVertexLayout >( unstructuredGrid->leafGridView() );
+    checkBandwidthReduction< UnstructuredGrid::LeafGridView, MCMGAllLayout >( unstructuredGrid->leafGridView() );
+  }
+#endif
+
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
@@ -0,0 +1,115 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+/** \file
+    \brief A unit test for the SpaceFillingCurve class
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include "../spacefillingcurve.hh"
+
+// enumerate the cell centers of a uniform grid with n^dim cells along the curve
+template< int dim >
+std::map< unsigned long, Dune::FieldVector< int, dim > >
+sortCells ( const Dune::SpaceFillingCurve< double, dim > &curve, int n )
+{
+  std::map< unsigned long, Dune::FieldVector< int, dim > > cells;
+  Dune::FieldVector< int, dim > cell( 0 );
+  while( true )
+  {
+    Dune::FieldVector< double, dim > center;
+    for( int i = 0; i < dim; ++i )
+      center[ i ] = (cell[ i ] + 0.5) / n;
+    if( !cells.insert( std::make_pair( curve.index( center ), cell ) ).second )
+      DUNE_THROW( Dune::Exception, "Two cells have the same index" );
+
+    int i = 0;
+    for( ; (i < dim) && (++cell[ i ] == n); ++i )
+      cell[ i ] = 0;
+    if( i == dim )
+      return cells;
+  }
+}
+
+// consecutive cells along the Hilbert curve have to be face neighbors
+template< int dim >
+void testHilbert ( int n )
+{
+  typedef Dune::SpaceFillingCurve< double, dim > Curve;
+  const Curve curve( Curve::hilbert, typename Curve::Coordinate( 0.0 ), typename Curve::Coordinate( 1.0 ) );
+
+  typedef typename std::map< unsigned long, Dune::FieldVector< int, dim > >::const_iterator Iterator;
+  const std::map< unsigned long, Dune::FieldVector< int, dim > > cells = sortCells( curve, n );
+  Iterator prev = cells.begin();
+  for( Iterator it = ++cells.begin(); it != cells.end(); prev = it++ )
+  {
+    int distance = 0;
+    for( int i = 0; i < dim; ++i )
+      distance += std::abs( it->second[ i ] - prev->second[ i ] );
+    if( distance != 1 )
+      DUNE_THROW( Dune::Exception, "Hilbert curve connects cells that are not neighbors" );
+  }
+}
+
+// the segments of a weighted Morton curve have to be balanced
+void testPartition ()
+{
+  typedef Dune::SpaceFillingCurve< double, 3 > Curve;
+  const Curve curve( Curve::morton, Curve::Coordinate( 0.0 ), Curve::Coordinate( 1.0 ) );
+
+  const int n = 8, numParts = 4;
+  std::vector< Curve::Coordinate > points;
+  std::vector< double > weights;
+  for( int k = 0; k < n*n*n; ++k )
+  {
+    Curve::Coordinate x;
+    x[ 0 ] = (k % n + 0.5) / n;
+    x[ 1 ] = ((k / n) % n + 0.5) / n;
+    x[ 2 ] = (k / (n*n) + 0.5) / n;
+    points.push_back( x );
+    weights.push_back( x[ 0 ] < 0.5 ? 20.0 : 1.0 );
+  }
+
+  std::vector< int > part;
+  Dune::partitionSpaceFillingCurve( curve, points, weights, numParts, part );
+
+  std::vector< double > load( numParts, 0.0 );
+  double total = 0.0;
+  for( std::size_t k = 0; k < points.size(); ++k )
+  {
+    load[ part[ k ] ] += weights[ k ];
+    total += weights[ k ];
+  }
+  for( int p = 0; p < numParts; ++p )
+  {
+    if( std::abs( load[ p ] - total / numParts ) > 20.0 )
+      DUNE_THROW( Dune::Exception, "Partition " << p << " has load " << load[ p ]
+                                                << ", expected " << total / numParts );
+  }
+}
+
+int main ()
+try
+{
+  testHilbert< 1 >( 16 );
+  testHilbert< 2 >( 16 );
+  testHilbert< 3 >( 8 );
+  testPartition();
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
@@ -20,7 +20,6 @@
 
 using namespace Dune;
 
-
 int main (int argc , char **argv)
 try {
 
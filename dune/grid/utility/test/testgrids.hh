@@ -0,0 +1,124 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_UTILITY_TEST_TESTGRIDS_HH
+#define DUNE_GRID_UTILITY_TEST_TESTGRIDS_HH
+
+/** \file
+    \brief Grids of the unit cube shared by the tests of the grid utilities
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/shared_ptr.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/grid/common/gridfactory.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+// structured cube grid of the unit cube with n elements in each direction
+template< class Grid >
+Dune::shared_ptr< Grid > createUnitCubeGrid ( unsigned int n )
+{
+  const int dim = Grid::dimension;
+  Dune::array< unsigned int, dim > elements;
+  std::fill( elements.begin(), elements.end(), n );
+  return Dune::StructuredGridFactory< Grid >::createCubeGrid( Dune::FieldVector< double, dim >( 0.0 ),
+                                                             Dune::FieldVector< double, dim >( 1.0 ),
+                                                             elements );
+}
+
+// reproducible random permutation of 0, ..., size-1 (linear congruential generator)
+inline std::vector< unsigned int > shuffledSequence ( std::size_t size, unsigned long seed )
+{
+  std::vector< unsigned int > sequence( size );
+  for( std::size_t i = 0; i < size; ++i )
+    sequence[ i ] = i;
+  for( std::size_t k = size; k > 1; --k )
+  {
+    seed = (seed * 1103515245ul + 12345ul) % 2147483648ul;
+    std::swap( sequence[ k-1 ], sequence[ seed % k ] );
+  }
+  return sequence;
+}
+
+/* Kuhn triangulation of the unit cube with n cells in each direction. The
+ * vertices and elements are inserted into the grid factory in a shuffled
+ * order to simulate the output of a mesh generator, so the index sets of
+ * grids numbering the macro grid in insertion order have no locality.
+ */
+template< class Grid >
+Dune::shared_ptr< Grid > createShuffledSimplexGrid ( unsigned int n )
+{
+  const int dim = Grid::dimension;
+  typedef Dune::FieldVector< double, dim > Vertex;
+
+  int stride[ dim ];
+  unsigned int numVertices = 1;
+  for( int j = 0; j < dim; ++j )
+  {
+    stride[ j ] = numVertices;
+    numVertices *= n+1;
+  }
+
+  // position of vertex v in the insertion order
+  const std::vector< unsigned int > vertexOrder = shuffledSequence( numVertices, 4711 );
+  std::vector< Vertex > vertices( numVertices );
+  for( unsigned int v = 0; v < numVertices; ++v )
+  {
+    for( int j = 0; j < dim; ++j )
+      vertices[ vertexOrder[ v ] ][ j ] = double( (v / stride[ j ]) % (n+1) ) / n;
+  }
+
+  std::vector< std::vector< unsigned int > > elements;
+  for( unsigned int v = 0; v < numVertices; ++v )
+  {
+    // only vertices with a cell in positive direction
+    bool lower = true;
+    for( int j = 0; j < dim; ++j )
+      lower &= ((v / stride[ j ]) % (n+1) < n);
+    if( !lower )
+      continue;
+
+    int permutation[ dim ];
+    for( int j = 0; j < dim; ++j )
+      permutation[ j ] = j;
+    do
+    {
+      std::vector< unsigned int > corners( dim+1 );
+      corners[ 0 ] = v;
+      for( int j = 0; j < dim; ++j )
+        corners[ j+1 ] = corners[ j ] + stride[ permutation[ j ] ];
+      for( int i = 0; i <= dim; ++i )
+        corners[ i ] = vertexOrder[ corners[ i ] ];
+
+      // make sure the simplex is positively oriented
+      Dune::FieldMatrix< double, dim, dim > jacobian;
+      for( int j = 0; j < dim; ++j )
+      {
+        jacobian[ j ] = vertices[ corners[ j+1 ] ];
+        jacobian[ j ] -= vertices[ corners[ 0 ] ];
+      }
+      if( jacobian.determinant() < 0 )
+        std::swap( corners[ dim-1 ], corners[ dim ] );
+      elements.push_back( corners );
+    }
+    while( std::next_permutation( permutation, permutation + dim ) );
+  }
+
+  Dune::GridFactory< Grid > factory;
+  for( unsigned int i = 0; i < numVertices; ++i )
+    factory.insertVertex( vertices[ i ] );
+  const std::vector< unsigned int > elementOrder = shuffledSequence( elements.size(), 42 );
+  const Dune::GeometryType simplex( Dune::GeometryType::simplex, dim );
+  for( std::size_t k = 0; k < elements.size(); ++k )
+    factory.insertElement( simplex, elements[ elementOrder[ k ] ] );
+  return Dune::shared_ptr< Grid >( factory.createGrid() );
+}
+
+#endif // #ifndef DUNE_GRID_UTILITY_TEST_TESTGRIDS_HH
@@ -143,7 +143,9 @@ namespace Dune {
     {
       if (data.contains(dim,codim))
       {
-        DUNE_THROW(GridError, "interface communication not implemented");
+        if (codim != 1 && codim != dim-1)
+          DUNE_THROW(GridError, "interface communication not implemented");
+        g.template communicateCodim<DataHandle,codim>(data,iftype,dir,level);
       }
       YaspCommunicateMeta<dim,codim-1>::comm(g,data,iftype,dir,level);
     }
@@ -178,8 +180,8 @@ namespace Dune {
      \ingroup YaspGrid
 
      YaspGrid stands for yet another structured parallel grid.
-     It implements the dune grid interface for structured grids with codim 0
-     and dim, with arbitrary overlap (including zero),
+     It implements the dune grid interface for structured grids with codim 0,
+     1, dim-1 and dim, with arbitrary overlap (including zero),
      periodic boundaries and fast implementation allowing on-the-fly computations.
 
      \tparam dim The dimension of the grid and its surrounding world
@@ -206,6 +208,54 @@ namespace Dune {
       int distance;
     };
 
+    /** \brief The grids of all faces or edges with one orientation
+     *
+     * Faces (codim 1) and edges (codim dim-1) are not stored as a single grid.
+     * Instead, there is one grid for each orientation which behaves like the
+     * cell grid in the directions in which the entity is extended and like the
+     * vertex grid in all other directions.
+     */
+    struct YGridComponent {
+      /** \brief directions in which the entities are extended */
+      std::bitset<dim> shift;
+
+      /** \brief index of the first entity of this orientation */
+      int offset;
+
+      SubYGrid<dim,ctype> overlapfront;    // all our entities of this orientation
+      SubYGrid<dim,ctype> overlap;         // subgrid containing only overlap
+      SubYGrid<dim,ctype> interiorborder;  // subgrid containing only interior and border
+      SubYGrid<dim,ctype> interior;        // subgrid containing only interior
+
+      std::deque<Intersection> send_overlapfront_overlapfront; // each intersection is a subgrid of overlapfront
+      std::deque<Intersection> recv_overlapfront_overlapfront; // each intersection is a subgrid of overlapfront
+
+      std::deque<Intersection> send_overlap_overlapfront; // each intersection is a subgrid of overlapfront
+      std::deque<Intersection> recv_overlapfront_overlap; // each intersection is a subgrid of overlapfront
+
+      std::deque<Intersection> send_interiorborder_interiorborder; // each intersection is a subgrid of overlapfront
+      std::deque<Intersection> recv_interiorborder_interiorborder; // each intersection is a subgrid of overlapfront
+
+      std::deque<Intersection> send_interiorborder_overlapfront; // each intersection is a subgrid of overlapfront
+      std::deque<Intersection> recv_overlapfront_interiorborder; // each intersection is a subgrid of overlapfront
+
+      /** \brief The subgrid containing the entities of a partition */
+      const SubYGrid<dim,ctype>& grid (PartitionIteratorType pitype) const
+      {
+        switch (pitype)
+        {
+        case Interior_Partition :
+          return interior;
+        case InteriorBorder_Partition :
+          return interiorborder;
+        case Overlap_Partition :
+          return overlap;
+        default :
+          return overlapfront;
+        }
+      }
+    };
+
     /** \brief A single grid level within a YaspGrid
      */
     struct YGridLevel {
@@ -246,6 +296,9 @@ namespace Dune {
       std::deque<Intersection> send_vertex_interiorborder_overlapfront; // each intersection is a subgrid of overlapfront
       std::deque<Intersection> recv_vertex_overlapfront_interiorborder; // each intersection is a subgrid of overlapfront
 
+      // face (codim 1) and edge (codim dim-1) data, one component per orientation
+      std::vector<YGridComponent> components[dim+1]; // indexed by codim, empty for codim 0 and dim
+
       // general
       YaspGrid<dim>* mg;  // each grid level knows its multigrid
       int overlap;           // in mesh cells on this level
@@ -305,8 +358,10 @@ namespace Dune {
      * \param o_interior  origin of interior (non-overlapping) cell decomposition
      * \param s_interior  size of interior cell decomposition
      * \param overlap     to be used on this grid level
+     * \param coords      tensor product coordinates on this grid level (null for an equidistant grid)
      */
-    YGridLevel makelevel (int level, fTupel L, iTupel s, std::bitset<dim> periodic, iTupel o_interior, iTupel s_interior, int overlap)
+    YGridLevel makelevel (int level, fTupel L, iTupel s, std::bitset<dim> periodic, iTupel o_interior, iTupel s_interior, int overlap,
+                          const shared_ptr<const YTensorCoordinates<dim,ctype> >& coords = shared_ptr<const YTensorCoordinates<dim,ctype> >())
     {
       // first, lets allocate a new structure
       YGridLevel g;
@@ -349,6 +404,11 @@ namespace Dune {
       for (int i=0; i<dim; i++) offset[i] = o_interior[i]-o_overlap[i];
       g.cell_interior = SubYGrid<dim,ctype>(o_interior,s_interior,offset,s_overlap,h,r);
 
+      // attach tensor product coordinates (if any) before computing the intersections
+      g.cell_global.coordinates(coords);
+      g.cell_overlap.coordinates(coords);
+      g.cell_interior.coordinates(coords);
+
       // compute cell intersections
       intersections(g.cell_overlap,g.cell_overlap,g.cell_global.size(),g.send_cell_overlap_overlap,g.recv_cell_overlap_overlap);
       intersections(g.cell_interior,g.cell_overlap,g.cell_global.size(),g.send_cell_interior_overlap,g.recv_cell_overlap_interior);
@@ -428,6 +488,13 @@ namespace Dune {
       }
       g.vertex_interior = SubYGrid<dim,ctype>(o_vertex_interior,s_vertex_interior,offset,s_vertex_overlapfront,h,r);
 
+      // attach tensor product coordinates (if any) before computing the intersections
+      g.vertex_global.coordinates(coords);
+      g.vertex_overlapfront.coordinates(coords);
+      g.vertex_overlap.coordinates(coords);
+      g.vertex_interiorborder.coordinates(coords);
+      g.vertex_interior.coordinates(coords);
+
       // compute vertex intersections
       intersections(g.vertex_overlapfront,g.vertex_overlapfront,g.cell_global.size(),
                     g.send_vertex_overlapfront_overlapfront,g.recv_vertex_overlapfront_overlapfront);
@@ -438,10 +505,96 @@ namespace Dune {
       intersections(g.vertex_interiorborder,g.vertex_overlapfront,g.cell_global.size(),
                     g.send_vertex_interiorborder_overlapfront,g.recv_vertex_overlapfront_interiorborder);
 
+      // the face grids, ordered by the direction normal to the face
+      if (dim>1)
+      {
+        int offset = 0;
+        for (int i=0; i<dim; i++)
+        {
+          std::bitset<dim> shift;
+          shift.set();
+          shift[i] = false;
+          g.components[1].push_back(makecomponent(g,shift,offset));
+          offset += g.components[1].back().overlapfront.totalsize();
+        }
+      }
+
+      // the edge grids, ordered by decreasing direction of the edge
+      // (this is the numbering used by the subentity indices of the cells)
+      if (dim>2)
+      {
+        int offset = 0;
+        for (int i=dim-1; i>=0; i--)
+        {
+          std::bitset<dim> shift;
+          shift[i] = true;
+          g.components[dim-1].push_back(makecomponent(g,shift,offset));
+          offset += g.components[dim-1].back().overlapfront.totalsize();
+        }
+      }
+
       // return the whole thing
       return g;
     }
 
+    /** \brief Make the grids of all faces or edges with one orientation
+     *
+     * The grids are assembled direction by direction: in the directions in
+     * which the entities are extended they coincide with the cell grids, in all
+     * other directions with the vertex grids. Hence the partition types are
+     * determined exactly as for cells and vertices.
+     *
+     * \param g       the grid level, cell and vertex grids must already be set up
+     * \param shift   the directions in which the entities are extended
+     * \param offset  index of the first entity of this orientation
+     */
+    YGridComponent makecomponent (const YGridLevel& g, const std::bitset<dim>& shift, int offset)
+    {
+      YGridComponent c;
+      c.shift = shift;
+      c.offset = offset;
+
+      const SubYGrid<dim,ctype>* cellgrids[4] = { &g.cell_overlap, &g.cell_overlap, &g.cell_interior, &g.cell_interior };
+      const SubYGrid<dim,ctype>* vertexgrids[4] = { &g.vertex_overlapfront, &g.vertex_overlap,
+                                                    &g.vertex_interiorborder, &g.vertex_interior };
+      SubYGrid<dim,ctype>* grids[4] = { &c.overlapfront, &c.overlap, &c.interiorborder, &c.interior };
+
+      fTupel h = g.cell_global.meshsize();
+      fTupel r;
+      iTupel supersize;
+      for (int i=0; i<dim; i++)
+      {
+        r[i] = shift[i] ? 0.5*h[i] : 0.0;
+        supersize[i] = shift[i] ? g.cell_overlap.size(i) : g.vertex_overlapfront.size(i);
+      }
+
+      for (int j=0; j<4; j++)
+      {
+        iTupel o, s, ofs;
+        for (int i=0; i<dim; i++)
+        {
+          const SubYGrid<dim,ctype>& source = shift[i] ? *cellgrids[j] : *vertexgrids[j];
+          o[i] = source.origin(i);
+          s[i] = source.size(i);
+          ofs[i] = source.offset(i);
+        }
+        *grids[j] = SubYGrid<dim,ctype>(o,s,ofs,supersize,h,r);
+        grids[j]->coordinates(g.cell_overlap.coordinates());
+      }
+
+      // compute intersections
+      intersections(c.overlapfront,c.overlapfront,g.cell_global.size(),
+                    c.send_overlapfront_overlapfront,c.recv_overlapfront_overlapfront);
+      intersections(c.overlap,c.overlapfront,g.cell_global.size(),
+                    c.send_overlap_overlapfront,c.recv_overlapfront_overlap);
+      intersections(c.interiorborder,c.interiorborder,g.cell_global.size(),
+                    c.send_interiorborder_interiorborder,c.recv_interiorborder_interiorborder);
+      intersections(c.interiorborder,c.overlapfront,g.cell_global.size(),
+                    c.send_interiorborder_overlapfront,c.recv_overlapfront_interiorborder);
+
+      return c;
+    }
+
 
     struct mpifriendly_ygrid {
       mpifriendly_ygrid ()
@@ -629,6 +782,8 @@ namespace Dune {
     //! shorthand for some data types
     typedef typename SubYGrid<dim,ctype>::TransformingSubIterator TSI;
     typedef typename std::deque<Intersection>::const_iterator ISIT;
+    typedef std::pair<int,const Intersection*> ComponentIntersection; // intersection and the orientation it belongs to
+    typedef typename std::vector<ComponentIntersection>::const_iterator CISIT;
 
     //! The constructor of the old MultiYGrid class
     void MultiYGridSetup (
@@ -655,7 +810,7 @@ namespace Dune {
       iTupel s_interior(s);
 #endif
       // add level
-      _levels[0] = makelevel(0,L,s,periodic,o_interior,s_interior,overlap);
+      _levels[0] = makelevel(0,L,s,periodic,o_interior,s_interior,overlap,_coords);
     }
 
     //! The constructor of the old MultiYGrid class
@@ -684,7 +839,7 @@ namespace Dune {
 #endif
 
       // add level
-      _levels[0] = makelevel(0,L,_s,periodic,o_interior,s_interior,overlap);
+      _levels[0] = makelevel(0,L,_s,periodic,o_interior,s_interior,overlap,_coords);
     }
 
     /*! Constructor
@@ -862,10 +1017,88 @@ namespace Dune {
       init();
     }
 
+    /*! Constructor for a tensor product YaspGrid
+
+       The grid is given by the vertex coordinates in each direction, which
+       need not be equidistant. The geometries remain axis-aligned, i.e., the
+       grid is still Cartesian.
+
+       @param comm MPI communicator where this mesh is distributed to
+       @param coords strictly increasing vertex coordinates in each direction
+       @param periodic tells if direction is periodic or not
+       @param overlap size of overlap on coarsest grid (same in all directions)
+       @param lb pointer to an overloaded YLoadBalance instance
+     */
+    YaspGrid (Dune::MPIHelper::MPICommunicator comm,
+              const Dune::array<std::vector<ctype>, dim>& coords,
+              std::bitset<dim> periodic,
+              int overlap,
+              const YLoadBalance<dim>* lb = defaultLoadbalancer())
+#if HAVE_MPI
+      : ccobj(comm),
+        _torus(comm,tag,tensorsize(coords),lb),
+#else
+      : _torus(tag,tensorsize(coords),lb),
+#endif
+        leafIndexSet_(*this),
+        _coords(make_shared<YTensorCoordinates<dim,ctype> >(coords)),
+        keep_ovlp(true), adaptRefCount(0), adaptActive(false)
+    {
+      MultiYGridSetup(tensorextent(*_coords),tensorsize(coords),periodic,overlap,lb);
+
+      init();
+    }
+
+    /*! Constructor for a sequential tensor product YaspGrid
+
+       Sequential here means that the whole grid is living on one process even if your program is running
+       in parallel.
+       @param coords strictly increasing vertex coordinates in each direction
+       @param periodic tells if direction is periodic or not
+       @param overlap size of overlap on coarsest grid (same in all directions)
+       @param lb pointer to an overloaded YLoadBalance instance
+     */
+    YaspGrid (const Dune::array<std::vector<ctype>, dim>& coords,
+              std::bitset<dim> periodic = std::bitset<dim>(),
+              int overlap = 0,
+              const YLoadBalance<dim>* lb = defaultLoadbalancer())
+#if HAVE_MPI
+      : ccobj(MPI_COMM_SELF),
+        _torus(MPI_COMM_SELF,tag,tensorsize(coords),lb),
+#else
+      : _torus(tag,tensorsize(coords),lb),
+#endif
+        leafIndexSet_(*this),
+        _coords(make_shared<YTensorCoordinates<dim,ctype> >(coords)),
+        keep_ovlp(true), adaptRefCount(0), adaptActive(false)
+    {
+      MultiYGridSetup(tensorextent(*_coords),tensorsize(coords),periodic,overlap,lb);
+
+      init();
+    }
+
   private:
     // do not copy this class
     YaspGrid(const YaspGrid&);
 
+    // number of cells per direction of a tensor product grid
+    static Dune::array<int,dim> tensorsize (const Dune::array<std::vector<ctype>, dim>& coords)
+    {
+      Dune::array<int,dim> s;
+      for (int i=0; i<dim; i++)
+        s[i] = coords[i].size()-1;
+      return s;
+    }
+
+    // extension of a tensor product grid
+    static fTupel tensorextent (const YTensorCoordinates<dim,ctype>& coords)
+    {
+      fTupel L;
+      for (int i=0; i<dim; i++)
+        L[i] = coords.extent(i);
+      return L;
+    }
+
   public:
 
     /*! Return maximum level defined in this grid. Levels are numbered
@@ -918,8 +1151,13 @@ namespace Dune {
         for (int i=0; i<dim; i++)
           s_interior[i] = 2*cg.cell_interior.size(i);
 
+        // refine tensor product coordinates by bisection
+        shared_ptr<const YTensorCoordinates<dim,ctype> > coords;
+        if (cg.cell_global.coordinates())
+          coords = make_shared<YTensorCoordinates<dim,ctype> >(cg.cell_global.coordinates()->refine());
+
         // add level
-        _levels.push_back( makelevel(_levels.size(),_LL,s,_periodic,o_interior,s_interior,overlap) );
+        _levels.push_back( makelevel(_levels.size(),_LL,s,_periodic,o_interior,s_interior,overlap,coords) );
 
         setsizes();
         indexsets.push_back( make_shared<YaspIndexSet<const YaspGrid<dim>, false > >(*this,maxLevel()) );
@@ -1043,6 +1281,102 @@ namespace Dune {
       return levelend<cd,All_Partition>(maxLevel());
     }
 
+    /** \brief Loop over the cells of a level without constructing entities
+     *
+     * This is the structured counterpart of the level iterator for codim 0.
+     * The cells are visited by nested loops in the same order as by the
+     * iterator, with the innermost loop running in direction 0, where
+     * consecutive cells have consecutive indices. For each cell
+     *
+     * \code
+     * f(index, coord, center);
+     * \endcode
+     *
+     * is called with the index of the cell in the level index set, its
+     * coordinate in the global cell grid (an iTupel) and the position of its
+     * center (an fTupel). The arguments are only valid during the call.
+     *
+     * \param level   the grid level
+     * \param pitype  the partition to loop over
+     * \param f       the function object to call for each cell
+     * \returns f, like std::for_each
+     */
+    template<class F>
+    F forEachCell (int level, PartitionIteratorType pitype, F f) const
+    {
+      if (level<0 || level>maxLevel()) DUNE_THROW(RangeError, "level out of range");
+      YGridLevelIterator g = begin(level);
+      if (pitype==Ghost_Partition)
+        return f;
+      const SubYGrid<dim,ctype>& grid = (pitype<=InteriorBorder_Partition) ? g->cell_interior : g->cell_overlap;
+      if (grid.empty())
+        return f;
+
+      // the cell centers in each direction
+      fTupel h = grid.meshsize();
+      std::vector<ctype> centers[dim];
+      for (int i=0; i<dim; i++)
+      {
+        centers[i].resize(grid.size(i));
+        for (int k=0; k<grid.size(i); k++)
+        {
+          const int c = grid.origin(i)+k;
+          if (grid.coordinates())
+          {
+            const ctype lower = grid.coordinates()->coordinate(i,c);
+            const ctype upper = grid.coordinates()->coordinate(i,c+1);
+            centers[i][k] = lower+grid.shift(i)/h[i]*(upper-lower);
+          }
+          else
+            centers[i][k] = c*h[i]+grid.shift(i);
+        }
+      }
+
+      // the index increments in the enclosing grid
+      iTupel increment;
+      increment[0] = 1;
+      for (int i=1; i<dim; i++)
+        increment[i] = increment[i-1]*grid.supersize(i-1);
+      int index = 0;
+      for (int i=0; i<dim; i++)
+        index += grid.offset(i)*increment[i];
+
+      iTupel coord = grid.origin();
+      fTupel center;
+      for (int i=0; i<dim; i++)
+        center[i] = centers[i][0];
+
+      const int n = grid.size(0);
+      const int origin = grid.origin(0);
+      while (true)
+      {
+        // the innermost loop has unit stride
+        for (int k=0; k<n; k++)
+        {
+          coord[0] = origin+k;
+          center[0] = centers[0][k];
+          f(index+k,coord,center);
+        }
+
+        // move on in the outer directions
+        int i=1;
+        for ( ; i<dim; i++)
+        {
+          if (++coord[i] < grid.origin(i)+grid.size(i))
+          {
+            index += increment[i];
+            center[i] = centers[i][coord[i]-grid.origin(i)];
+            break;
+          }
+          index -= (grid.size(i)-1)*increment[i];
+          coord[i] = grid.origin(i);
+          center[i] = centers[i][0];
+        }
+        if (i==dim)
+          return f;
+      }
+    }
+
     // \brief obtain EntityPointer from EntitySeed. */
     template <typename Seed>
     typename Traits::template Codim<Seed::codimension>::EntityPointer
@@ -1059,7 +1393,15 @@ namespace Dune {
         return YaspEntityPointer<codim,GridImp>(this,g,
                                                 TSI(g->vertex_overlap, this->getRealImplementation(seed).coord()));
       default :
-        DUNE_THROW(GridError, "YaspEntityPointer: codim not implemented");
+        {
+          const int component = this->getRealImplementation(seed).component();
+          if (component >= int(g->components[codim].size()))
+            DUNE_THROW(GridError, "YaspEntityPointer: codim not implemented");
+          return YaspEntityPointer<codim,GridImp>(this,g,
+                                                  TSI(g->components[codim][component].overlapfront,
+                                                      this->getRealImplementation(seed).coord()),
+                                                  component);
+        }
       }
     }
 
@@ -1158,6 +1500,12 @@ namespace Dune {
       // find send/recv lists or throw error
       const std::deque<Intersection>* sendlist=0;
       const std::deque<Intersection>* recvlist=0;
+
+      // faces and edges have one pair of lists per orientation, all of them are
+      // collected together with the number of the orientation they belong to
+      std::vector<ComponentIntersection> sends;
+      std::vector<ComponentIntersection> recvs;
+
       if (codim==0) // the elements
       {
         if (iftype==InteriorBorder_InteriorBorder_Interface)
@@ -1172,6 +1520,8 @@ namespace Dune {
           sendlist = &g->send_cell_overlap_overlap;
           recvlist = &g->recv_cell_overlap_overlap;
         }
+        appendintersections(0,sendlist,sends);
+        appendintersections(0,recvlist,recvs);
       }
       if (codim==dim) // the vertices
       {
@@ -1196,36 +1546,65 @@ namespace Dune {
           sendlist = &g->send_vertex_overlapfront_overlapfront;
           recvlist = &g->recv_vertex_overlapfront_overlapfront;
         }
+        appendintersections(0,sendlist,sends);
+        appendintersections(0,recvlist,recvs);
+      }
+      if (codim>0 && codim<dim) // faces and edges, the same interfaces as for vertices
+      {
+        const std::vector<YGridComponent>& components = g->components[codim];
+        for (int c=0; c<int(components.size()); ++c)
+        {
+          if (iftype==InteriorBorder_InteriorBorder_Interface)
+          {
+            sendlist = &components[c].send_interiorborder_interiorborder;
+            recvlist = &components[c].recv_interiorborder_interiorborder;
+          }
+          if (iftype==InteriorBorder_All_Interface)
+          {
+            sendlist = &components[c].send_interiorborder_overlapfront;
+            recvlist = &components[c].recv_overlapfront_interiorborder;
+          }
+          if (iftype==Overlap_OverlapFront_Interface || iftype==Overlap_All_Interface)
+          {
+            sendlist = &components[c].send_overlap_overlapfront;
+            recvlist = &components[c].recv_overlapfront_overlap;
+          }
+          if (iftype==All_All_Interface)
+          {
+            sendlist = &components[c].send_overlapfront_overlapfront;
+            recvlist = &components[c].recv_overlapfront_overlapfront;
+          }
+          appendintersections(c,sendlist,sends);
+          appendintersections(c,recvlist,recvs);
+        }
       }
 
       // change communication direction?
       if (dir==BackwardCommunication)
-        std::swap(sendlist,recvlist);
+        std::swap(sends,recvs);
 
       int cnt;
 
       // Size computation (requires communication if variable size)
-      std::vector<int> send_size(sendlist->size(),-1);    // map rank to total number of objects (of type DataType) to be sent
-      std::vector<int> recv_size(recvlist->size(),-1);    // map rank to total number of objects (of type DataType) to be recvd
-      std::vector<size_t*> send_sizes(sendlist->size(),static_cast<size_t*>(0)); // map rank to array giving number of objects per entity to be sent
-      std::vector<size_t*> recv_sizes(recvlist->size(),static_cast<size_t*>(0)); // map rank to array giving number of objects per entity to be recvd
+      std::vector<int> send_size(sends.size(),-1);    // map rank to total number of objects (of type DataType) to be sent
+      std::vector<int> recv_size(recvs.size(),-1);    // map rank to total number of objects (of type DataType) to be recvd
+      std::vector<size_t*> send_sizes(sends.size(),static_cast<size_t*>(0)); // map rank to array giving number of objects per entity to be sent
+      std::vector<size_t*> recv_sizes(recvs.size(),static_cast<size_t*>(0)); // map rank to array giving number of objects per entity to be recvd
       if (data.fixedsize(dim,codim))
       {
         // fixed size: just take a dummy entity, size can be computed without communication
         cnt=0;
-        for (ISIT is=sendlist->begin(); is!=sendlist->end(); ++is)
+        for (CISIT is=sends.begin(); is!=sends.end(); ++is)
         {
-          typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-          it(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubbegin()));
-          send_size[cnt] = is->grid.totalsize() * data.size(*it);
+          YaspEntityPointer<codim,GridImp> it(this,g,is->second->grid.tsubbegin(),is->first);
+          send_size[cnt] = is->second->grid.totalsize() * data.size(it.dereference());
           cnt++;
         }
         cnt=0;
-        for (ISIT is=recvlist->begin(); is!=recvlist->end(); ++is)
+        for (CISIT is=recvs.begin(); is!=recvs.end(); ++is)
         {
-          typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-          it(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubbegin()));
-          recv_size[cnt] = is->grid.totalsize() * data.size(*it);
+          YaspEntityPointer<codim,GridImp> it(this,g,is->second->grid.tsubbegin(),is->first);
+          recv_size[cnt] = is->second->grid.totalsize() * data.size(it.dereference());
           cnt++;
         }
       }
@@ -1233,21 +1612,19 @@ namespace Dune {
       {
         // variable size case: sender side determines the size
         cnt=0;
-        for (ISIT is=sendlist->begin(); is!=sendlist->end(); ++is)
+        for (CISIT is=sends.begin(); is!=sends.end(); ++is)
         {
           // allocate send buffer for sizes per entitiy
-          size_t *buf = new size_t[is->grid.totalsize()];
+          size_t *buf = new size_t[is->second->grid.totalsize()];
           send_sizes[cnt] = buf;
 
           // loop over entities and ask for size
           int i=0; size_t n=0;
-          typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-          it(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubbegin()));
-          typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-          tsubend(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubend()));
-          for ( ; it!=tsubend; ++it)
+          YaspEntityPointer<codim,GridImp> it(this,g,is->second->grid.tsubbegin(),is->first);
+          const TSI tsubend = is->second->grid.tsubend();
+          for ( ; it.transformingsubiterator()!=tsubend; ++it.transformingsubiterator())
           {
-            buf[i] = data.size(*it);
+            buf[i] = data.size(it.dereference());
             n += buf[i];
             i++;
           }
@@ -1256,20 +1633,20 @@ namespace Dune {
           send_size[cnt] = n;
 
           // hand over send request to torus class
-          torus().send(is->rank,buf,is->grid.totalsize()*sizeof(size_t));
+          torus().send(is->second->rank,buf,is->second->grid.totalsize()*sizeof(size_t));
           cnt++;
         }
 
         // allocate recv buffers for sizes and store receive request
         cnt=0;
-        for (ISIT is=recvlist->begin(); is!=recvlist->end(); ++is)
+        for (CISIT is=recvs.begin(); is!=recvs.end(); ++is)
         {
           // allocate recv buffer
-          size_t *buf = new size_t[is->grid.totalsize()];
+          size_t *buf = new size_t[is->second->grid.totalsize()];
           recv_sizes[cnt] = buf;
 
           // hand over recv request to torus class
-          torus().recv(is->rank,buf,is->grid.totalsize()*sizeof(size_t));
+          torus().recv(is->second->rank,buf,is->second->grid.totalsize()*sizeof(size_t));
           cnt++;
         }
 
@@ -1278,7 +1655,7 @@ namespace Dune {
 
         // release send size buffers
         cnt=0;
-        for (ISIT is=sendlist->begin(); is!=sendlist->end(); ++is)
+        for (CISIT is=sends.begin(); is!=sends.end(); ++is)
         {
           delete[] send_sizes[cnt];
           send_sizes[cnt] = 0;
@@ -1287,14 +1664,14 @@ namespace Dune {
 
         // process receive size buffers
         cnt=0;
-        for (ISIT is=recvlist->begin(); is!=recvlist->end(); ++is)
+        for (CISIT is=recvs.begin(); is!=recvs.end(); ++is)
         {
           // get recv buffer
           size_t *buf = recv_sizes[cnt];
 
           // compute total size
           size_t n=0;
-          for (int i=0; i<is->grid.totalsize(); ++i)
+          for (int i=0; i<is->second->grid.totalsize(); ++i)
             n += buf[i];
 
           // ... and store it
@@ -1305,45 +1682,43 @@ namespace Dune {
 
 
       // allocate & fill the send buffers & store send request
-      std::vector<DataType*> sends(sendlist->size(), static_cast<DataType*>(0)); // store pointers to send buffers
+      std::vector<DataType*> sendbuffers(sends.size(), static_cast<DataType*>(0)); // store pointers to send buffers
       cnt=0;
-      for (ISIT is=sendlist->begin(); is!=sendlist->end(); ++is)
+      for (CISIT is=sends.begin(); is!=sends.end(); ++is)
       {
         // allocate send buffer
         DataType *buf = new DataType[send_size[cnt]];
 
         // remember send buffer
-        sends[cnt] = buf;
+        sendbuffers[cnt] = buf;
 
         // make a message buffer
         MessageBuffer<DataType> mb(buf);
 
-        // fill send buffer; iterate over cells in intersection
-        typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-        it(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubbegin()));
-        typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-        tsubend(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubend()));
-        for ( ; it!=tsubend; ++it)
-          data.gather(mb,*it);
+        // fill send buffer; iterate over entities in intersection
+        YaspEntityPointer<codim,GridImp> it(this,g,is->second->grid.tsubbegin(),is->first);
+        const TSI tsubend = is->second->grid.tsubend();
+        for ( ; it.transformingsubiterator()!=tsubend; ++it.transformingsubiterator())
+          data.gather(mb,it.dereference());
 
         // hand over send request to torus class
-        torus().send(is->rank,buf,send_size[cnt]*sizeof(DataType));
+        torus().send(is->second->rank,buf,send_size[cnt]*sizeof(DataType));
         cnt++;
       }
 
       // allocate recv buffers and store receive request
-      std::vector<DataType*> recvs(recvlist->size(),static_cast<DataType*>(0)); // store pointers to send buffers
+      std::vector<DataType*> recvbuffers(recvs.size(),static_cast<DataType*>(0)); // store pointers to send buffers
       cnt=0;
-      for (ISIT is=recvlist->begin(); is!=recvlist->end(); ++is)
+      for (CISIT is=recvs.begin(); is!=recvs.end(); ++is)
       {
         // allocate recv buffer
         DataType *buf = new DataType[recv_size[cnt]];
 
         // remember recv buffer
-        recvs[cnt] = buf;
+        recvbuffers[cnt] = buf;
 
         // hand over recv request to torus class
-        torus().recv(is->rank,buf,recv_size[cnt]*sizeof(DataType));
+        torus().recv(is->second->rank,buf,recv_size[cnt]*sizeof(DataType));
         cnt++;
       }
 
@@ -1352,44 +1727,38 @@ namespace Dune {
 
       // release send buffers
       cnt=0;
-      for (ISIT is=sendlist->begin(); is!=sendlist->end(); ++is)
+      for (CISIT is=sends.begin(); is!=sends.end(); ++is)
       {
-        delete[] sends[cnt];
-        sends[cnt] = 0;
+        delete[] sendbuffers[cnt];
+        sendbuffers[cnt] = 0;
         cnt++;
       }
 
       // process receive buffers and delete them
       cnt=0;
-      for (ISIT is=recvlist->begin(); is!=recvlist->end(); ++is)
+      for (CISIT is=recvs.begin(); is!=recvs.end(); ++is)
       {
         // get recv buffer
-        DataType *buf = recvs[cnt];
+        DataType *buf = recvbuffers[cnt];
 
         // make a message buffer
         MessageBuffer<DataType> mb(buf);
 
-        // copy data from receive buffer; iterate over cells in intersection
+        // copy data from receive buffer; iterate over entities in intersection
+        YaspEntityPointer<codim,GridImp> it(this,g,is->second->grid.tsubbegin(),is->first);
+        const TSI tsubend = is->second->grid.tsubend();
         if (data.fixedsize(dim,codim))
         {
-          typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-          it(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubbegin()));
-          size_t n=data.size(*it);
-          typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-          tsubend(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubend()));
-          for ( ; it!=tsubend; ++it)
-            data.scatter(mb,*it,n);
+          size_t n=data.size(it.dereference());
+          for ( ; it.transformingsubiterator()!=tsubend; ++it.transformingsubiterator())
+            data.scatter(mb,it.dereference(),n);
         }
         else
         {
           int i=0;
           size_t *sbuf = recv_sizes[cnt];
-          typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-          it(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubbegin()));
-          typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
-          tsubend(YaspLevelIterator<codim,All_Partition,GridImp>(this,g,is->grid.tsubend()));
-          for ( ; it!=tsubend; ++it)
-            data.scatter(mb,*it,sbuf[i++]);
+          for ( ; it.transformingsubiterator()!=tsubend; ++it.transformingsubiterator())
+            data.scatter(mb,it.dereference(),sbuf[i++]);
           delete[] sbuf;
         }
 
@@ -1490,6 +1859,16 @@ namespace Dune {
       mutable int j;
     };
 
+    //! append all intersections of a list together with the number of the orientation they belong to
+    static void appendintersections (int component, const std::deque<Intersection>* list,
+                                     std::vector<ComponentIntersection>& result)
+    {
+      if (!list)
+        return;
+      for (ISIT is=list->begin(); is!=list->end(); ++is)
+        result.push_back(ComponentIntersection(component,&(*is)));
+    }
+
     void setsizes ()
     {
       for (YGridLevelIterator g=begin(); g!=end(); ++g)
@@ -1538,12 +1917,14 @@ namespace Dune {
     template<int cd, PartitionIteratorType pitype>
     YaspLevelIterator<cd,pitype,GridImp> levelbegin (int level) const
     {
-      dune_static_assert( cd == dim || cd == 0 ,
-                          "YaspGrid only supports Entities with codim=dim and codim=0");
+      dune_static_assert( cd == dim || cd == 0 || cd == 1 || cd == dim-1,
+                          "YaspGrid only supports Entities with codim=0, 1, dim-1 and dim");
       YGridLevelIterator g = begin(level);
       if (level<0 || level>maxLevel()) DUNE_THROW(RangeError, "level out of range");
       if (pitype==Ghost_Partition)
         return levelend <cd, pitype> (level);
+      if (cd>0 && cd<dim)   // the faces and edges, start with the first orientation
+        return YaspLevelIterator<cd,pitype,GridImp>(this,g,g->components[cd].front().grid(pitype).tsubbegin(),0);
       if (cd==0)   // the elements
       {
         if (pitype<=InteriorBorder_Partition)
@@ -1569,10 +1950,13 @@ namespace Dune {
     template<int cd, PartitionIteratorType pitype>
     YaspLevelIterator<cd,pitype,GridImp> levelend (int level) const
     {
-      dune_static_assert( cd == dim || cd == 0 ,
-                          "YaspGrid only supports Entities with codim=dim and codim=0");
+      dune_static_assert( cd == dim || cd == 0 || cd == 1 || cd == dim-1,
+                          "YaspGrid only supports Entities with codim=0, 1, dim-1 and dim");
       YGridLevelIterator g = begin(level);
       if (level<0 || level>maxLevel()) DUNE_THROW(RangeError, "level out of range");
+      if (cd>0 && cd<dim)   // the faces and edges, end of the last orientation
+        return YaspLevelIterator<cd,pitype,GridImp>(this,g,g->components[cd].back().grid(pitype).tsubend(),
+                                                    int(g->components[cd].size())-1);
       if (cd==0)   // the elements
       {
         if (pitype<=InteriorBorder_Partition)
@@ -1608,6 +1992,7 @@ namespace Dune {
 
     fTupel _LL;
     iTupel _s;
+    shared_ptr<const YTensorCoordinates<dim,ctype> > _coords; // tensor product coordinates of the coarse grid (null if equidistant)
     std::bitset<dim> _periodic;
     ReservedVector<YGridLevel,32> _levels;
     int _overlap;
@@ -1750,34 +2135,23 @@ namespace Dune {
       static const bool v = true;
     };
 
-    /** \brief YaspGrid has codim=0 entities (elements)
+    /** \brief YaspGrid has entities of codim 0 (elements), codim 1 (faces),
+       codim dim-1 (edges) and codim dim (vertices)
        \ingroup YaspGrid
      */
-    template<int dim>
-    struct hasEntity< YaspGrid<dim>, 0 >
+    template<int dim, int codim>
+    struct hasEntity< YaspGrid<dim>, codim >
     {
-      static const bool v = true;
+      static const bool v = (codim == 0 || codim == 1 || codim == dim-1 || codim == dim);
     };
 
-    /** \brief YaspGrid has codim=dim entities (vertices)
+    /** \brief YaspGrid can communicate on all entities it has
        \ingroup YaspGrid
      */
-    template<int dim>
-    struct hasEntity< YaspGrid<dim>, dim >
-    {
-      static const bool v = true;
-    };
-
-    template< int dim >
-    struct canCommunicate< YaspGrid< dim >, 0 >
+    template< int dim, int codim >
+    struct canCommunicate< YaspGrid< dim >, codim >
     {
-      static const bool v = true;
-    };
-
-    template< int dim >
-    struct canCommunicate< YaspGrid< dim >, dim >
-    {
-      static const bool v = true;
+      static const bool v = (codim == 0 || codim == 1 || codim == dim-1 || codim == dim);
     };
 
     /** \brief YaspGrid is parallel
@@ -18,7 +18,9 @@
 #include <string.h>
 
 // local includes
+#include <dune/common/array.hh>
 #include <dune/common/fvector.hh>
+#include <dune/common/shared_ptr.hh>
 #include <dune/common/stdstreams.hh>
 #include <dune/common/power.hh>
 #include <dune/grid/common/grid.hh>
@@ -35,6 +37,92 @@ namespace Dune {
 
   static const double Ytolerance=1E-13;
 
+  /** \brief Vertex coordinates of a tensor product grid
+
+     A tensor product grid is described by one strictly increasing vector of
+     vertex coordinates \f$ c_i = (c_{i,0},\ldots,c_{i,n_i}) \f$ per direction.
+     The affine mapping \f$ t(k)_i = k_i h_i + r_i \f$ of a YGrid is then replaced
+     by the piecewise linear interpolation of these coordinates, i.e.,
+
+     \f[ t(k)_i = c_{i,k_i} + \frac{r_i}{h_i} (c_{i,k_i+1} - c_{i,k_i}). \f]
+
+     Indices outside \f$ 0,\ldots,n_i \f$ are mapped periodically, which
+     handles the overlap in periodic directions.
+
+     The coordinates are stored for the whole (global) grid. As they grow
+     only with the sum of the number of cells per direction, this is
+     negligible compared to the distributed cell and vertex data.
+   */
+  template<int d, typename ct>
+  class YTensorCoordinates {
+  public:
+    //! Make tensor product coordinates from vertex coordinates in each direction
+    explicit YTensorCoordinates (const array<std::vector<ct>,d>& c)
+      : _c(c)
+    {
+      for (int i=0; i<d; ++i)
+      {
+        if (_c[i].size() < 2)
+          DUNE_THROW(GridError, "YTensorCoordinates: at least one cell per direction required");
+        for (std::size_t k=1; k<_c[i].size(); ++k)
+          if (_c[i][k] <= _c[i][k-1])
+            DUNE_THROW(GridError, "YTensorCoordinates: coordinates must be strictly increasing");
+      }
+    }
+
+    //! Return number of cells in direction i
+    int size (int i) const
+    {
+      return _c[i].size()-1;
+    }
+
+    //! Return extension of the domain in direction i
+    ct extent (int i) const
+    {
+      return _c[i].back()-_c[i].front();
+    }
+
+    //! Return coordinate of vertex k in direction i (periodically extended)
+    ct coordinate (int i, int k) const
+    {
+      const int n = size(i);
+      int q = k/n;
+      int r = k%n;
+      if (r<0)
+      {
+        r += n;
+        --q;
+      }
+      return _c[i][r] + q*extent(i);
+    }
+
+    //! Return vertex coordinates in direction i
+    const std::vector<ct>& coordinates (int i) const
+    {
+      return _c[i];
+    }
+
+    //! Return coordinates of the grid obtained by bisecting each cell
+    YTensorCoordinates<d,ct> refine () const
+    {
+      array<std::vector<ct>,d> c;
+      for (int i=0; i<d; ++i)
+      {
+        c[i].resize(2*size(i)+1);
+        for (int k=0; k<size(i); ++k)
+        {
+          c[i][2*k] = _c[i][k];
+          c[i][2*k+1] = 0.5*(_c[i][k]+_c[i][k+1]);
+        }
+        c[i][2*size(i)] = _c[i][size(i)];
+      }
+      return YTensorCoordinates<d,ct>(c);
+    }
+
+  private:
+    array<std::vector<ct>,d> _c;
+  };
+
   /**
      This is the basis of a parallel implementation of the dune grid interface
      supporting codim 0 and dim.
@@ -94,6 +182,18 @@ namespace Dune {
 #endif
     }
 
+    //! Return tensor product coordinates (null for an equidistant grid)
+    const shared_ptr<const YTensorCoordinates<d,ct> >& coordinates () const
+    {
+      return _coords;
+    }
+
+    //! Set tensor product coordinates (pass null for an equidistant grid)
+    void coordinates (const shared_ptr<const YTensorCoordinates<d,ct> >& coords)
+    {
+      _coords = coords;
+    }
+
     //! Return origin in direction i
     int origin (int i) const
     {
@@ -543,6 +643,7 @@ namespace Dune {
     iTupel _size;
     fTupel _h;        //!< mesh size per direction
     fTupel _r;        //!< shift per direction
+    shared_ptr<const YTensorCoordinates<d,ct> > _coords; //!< tensor product coordinates (if not equidistant)
   };
 
   //! Output operator for grids
@@ -677,7 +778,9 @@ namespace Dune {
         // offset to my supergrid
         offset[i] = _offset[i]+neworigin[i]-this->origin(i);
       }
-      return SubYGrid<d,ct>(neworigin,newsize,offset,_supersize,this->meshsize(),this->shift());
+      SubYGrid<d,ct> result(neworigin,newsize,offset,_supersize,this->meshsize(),this->shift());
+      result.coordinates(this->coordinates());
+      return result;
     }
 
     /*! SubIterator is an Iterator that provides in addition the consecutive
@@ -878,6 +981,7 @@ namespace Dune {
         for (int i=0; i<d; ++i) _h[i] = r.meshsize(i);
         for (int i=0; i<d; ++i) _begin[i] = r.origin(i)*r.meshsize(i)+r.shift(i);
         for (int i=0; i<d; ++i) _position[i] = _begin[i];
+        inittensor(r);
       }
 
       //! Make iterator pointing to given cell in a grid.
@@ -886,15 +990,17 @@ namespace Dune {
         for (int i=0; i<d; ++i) _h[i] = r.meshsize(i);
         for (int i=0; i<d; ++i) _begin[i] = r.origin(i)*r.meshsize(i)+r.shift(i);
         for (int i=0; i<d; ++i) _position[i] = coord[i]*r.meshsize(i)+r.shift(i);
+        inittensor(r);
       }
 
       //! Make transforming iterator from iterator (used for automatic conversion of end)
       TransformingSubIterator (const SubIterator& i) :
-        SubIterator(i)
+        SubIterator(i), _coords(0)
       {}
 
       TransformingSubIterator (const TransformingSubIterator & t) :
-        SubIterator(t), _h(t._h), _begin(t._begin), _position(t._position)
+        SubIterator(t), _h(t._h), _begin(t._begin), _position(t._position),
+        _coords(t._coords), _relshift(t._relshift)
       {}
 
       //! Make iterator pointing to given cell in a grid.
@@ -904,6 +1010,7 @@ namespace Dune {
         for (int i=0; i<d; ++i) _h[i] = r.meshsize(i);
         for (int i=0; i<d; ++i) _begin[i] = r.origin(i)*r.meshsize(i)+r.shift(i);
         for (int i=0; i<d; ++i) _position[i] = coord[i]*r.meshsize(i)+r.shift(i);
+        inittensor(r);
       }
 
       //! Make iterator pointing to given cell in a grid.
@@ -913,6 +1020,7 @@ namespace Dune {
         for (int i=0; i<d; ++i) _h[i] = r.meshsize(i);
         for (int i=0; i<d; ++i) _begin[i] = r.origin(i)*r.meshsize(i)+r.shift(i);
         for (int i=0; i<d; ++i) _position[i] = coord[i]*r.meshsize(i)+r.shift(i);
+        inittensor(r);
       }
 
       //! Increment iterator to next cell with position.
@@ -924,14 +1032,20 @@ namespace Dune {
           this->_superindex += this->_superincrement[i];   // move on cell in direction i
           if (++(this->_coord[i])<=this->_end[i])
           {
-            _position[i] += _h[i];
+            if (_coords)
+              updatetensor(i);
+            else
+              _position[i] += _h[i];
             return *this;
           }
           else
           {
             this->_coord[i]=this->_origin[i];         // move back to origin in direction i
             this->_superindex -= this->_size[i]*this->_superincrement[i];
-            _position[i] = _begin[i];
+            if (_coords)
+              updatetensor(i);
+            else
+              _position[i] = _begin[i];
           }
         }
         // if we wrapped around, back to to begin(), we must put the iterator to end()
@@ -972,7 +1086,10 @@ namespace Dune {
       void move (int i, int dist)
       {
         SubIterator::move(i,dist);
-        _position[i] += dist*_h[i];
+        if (_coords)
+          updatetensor(i);
+        else
+          _position[i] += dist*_h[i];
       }
 
       //! Print contents of iterator
@@ -985,9 +1102,33 @@ namespace Dune {
       }
 
     private:
+      //! set up position and mesh size from tensor product coordinates (if any)
+      void inittensor (const SubYGrid<d,ct>& r)
+      {
+        _coords = r.coordinates().get();
+        if (!_coords)
+          return;
+        for (int i=0; i<d; ++i)
+        {
+          _relshift[i] = r.shift(i)/r.meshsize(i);
+          updatetensor(i);
+        }
+      }
+
+      //! recompute position and mesh size in direction i from tensor product coordinates
+      void updatetensor (int i)
+      {
+        const ct lower = _coords->coordinate(i,this->_coord[i]);
+        const ct upper = _coords->coordinate(i,this->_coord[i]+1);
+        _h[i] = upper-lower;
+        _position[i] = lower+_relshift[i]*_h[i];
+      }
+
       fTupel _h;        //!< mesh size per direction
       fTupel _begin;    //!< position of origin of grid
       fTupel _position; //!< current position
+      const YTensorCoordinates<d,ct>* _coords; //!< tensor product coordinates (null if equidistant)
+      fTupel _relshift; //!< shift relative to mesh size (only used for tensor product coordinates)
     };
 
     //! return iterator to first element of index set
@@ -10,7 +10,7 @@
 
    We have specializations for codim==0 (elements) and
    codim=dim (vertices).
-   The general version throws a GridError.
+   The general version implements faces and edges.
  */
 //========================================================================
 
@@ -24,84 +24,160 @@ namespace Dune {
   class YaspEntity
     :  public EntityDefaultImplementation <codim,dim,GridImp,YaspEntity>
   {
+    enum { dimworld = GridImp::dimensionworld };
+
+    typedef typename GridImp::Traits::template Codim<codim>::GeometryImpl GeometryImpl;
+
   public:
     typedef typename GridImp::ctype ctype;
 
+    typedef typename GridImp::YGridLevelIterator YGLI;
+    typedef typename SubYGrid<dim,ctype>::TransformingSubIterator TSI;
+
     typedef typename GridImp::template Codim<codim>::Geometry Geometry;
 
+    typedef typename GridImp::template Codim<codim>::EntityPointer EntityPointer;
+    typedef typename GridImp::template Codim<codim>::EntitySeed EntitySeed;
+
+    //! define the type used for persisitent indices
+    typedef typename GridImp::PersistentIndexType PersistentIndexType;
+
+    //! define type used for coordinates in grid module
+    typedef typename YGrid<dim,ctype>::iTupel iTupel;
+
+    // constructor
+    YaspEntity (const GridImp* yg, const YGLI& g, const TSI& it, const int& component)
+      : _yg(yg), _it(it), _g(g), _component(component)
+    {}
+
     //! level of this element
-    int level () const
-    {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
-    }
+    int level () const {return _g->level();}
 
     //! index is unique and consecutive per level and codim used for access to degrees of freedom
-    int index () const
-    {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
+    int index () const {return compressedIndex();}
+
+    /** \brief Return the entity seed which contains sufficient information
+     *  to generate the entity again and uses as little memory as possible
+     */
+    EntitySeed seed () const {
+      return EntitySeed(YaspEntitySeed<codim,GridImp>(_g->level(), _it.coord(), _component));
     }
 
     //! geometry of this entity
-    Geometry geometry () const
-    {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
+    Geometry geometry () const {
+      GeometryImpl _geometry(_it.position(),_it.meshsize(),gridcomponent().shift);
+      return Geometry( _geometry );
     }
 
     //! return partition type attribute
     PartitionType partitionType () const
     {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
+      if (gridcomponent().interior.inside(_it.coord()))
+        return InteriorEntity;
+      if (gridcomponent().interiorborder.inside(_it.coord()))
+        return BorderEntity;
+      if (gridcomponent().overlap.inside(_it.coord()))
+        return OverlapEntity;
+      if (gridcomponent().overlapfront.inside(_it.coord()))
+        return FrontEntity;
+      return GhostEntity;
     }
 
-    const GridImp * yaspgrid() const
+    //! subentity compressed index, available for the entity itself and its vertices
+    int subCompressedIndex (int i, unsigned int cc) const
     {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
-    }
+      if (int(cc)==codim)
+        return compressedIndex();
 
-    typedef typename GridImp::YGridLevelIterator YGLI;
-    typedef typename SubYGrid<dim,ctype>::TransformingSubIterator TSI;
-    YaspEntity (const GridImp* yg, const YGLI& g, const TSI& it)
-    {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
+      if (int(cc)==dim)
+      {
+        // get position relative to origin of local vertex grid
+        iTupel coord;
+        for (int k=0; k<dim; ++k)
+          coord[k] = _it.coord(k)-_g->vertex_overlapfront.origin(k);
+
+        // the corners are numbered lexicographically in the extended directions
+        int bit=0;
+        for (int k=0; k<dim; ++k)
+          if (gridcomponent().shift[k])
+          {
+            if (i&(1<<bit)) (coord[k])++;
+            bit++;
+          }
+
+        // do lexicographic numbering
+        int index = coord[dim-1];
+        for (int k=dim-2; k>=0; --k)
+          index = (index*_g->vertex_overlapfront.size(k))+coord[k];
+        return index;
+      }
+
+      DUNE_THROW(NotImplemented, "subIndex of codim " << cc << " for entities with codimension " << codim);
     }
 
+    const TSI& transformingsubiterator () const { return _it; }
+    const YGLI& gridlevel () const { return _g; }
+    const GridImp * yaspgrid () const { return _yg; }
+    int component () const { return _component; }
+
+  private:
     // IndexSets needs access to the private index methods
     friend class Dune::YaspIndexSet<GridImp,true>;
     friend class Dune::YaspIndexSet<GridImp,false>;
     friend class Dune::YaspGlobalIdSet<GridImp>;
-    typedef typename GridImp::PersistentIndexType PersistentIndexType;
 
-    //! globally unique, persistent index
-    PersistentIndexType persistentIndex () const
+    //! the grids of all entities with our orientation
+    const typename GridImp::YGridComponent& gridcomponent () const
     {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
+      return _g->components[codim][_component];
     }
 
-    //! consecutive, codim-wise, level-wise index
-    int compressedIndex () const
+    //! globally unique, persistent index
+    PersistentIndexType persistentIndex () const
     {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
-    }
+      // Idea: Use the doubled grid to assign coordinates to faces and edges
+      int coord[dim];
+      for (int i=0; i<dim; i++)
+      {
+        // correction for periodic boundaries
+        const int size = _g->cell_global.size(i) + (gridcomponent().shift[i] ? 0 : 1);
+        coord[i] = _it.coord(i);
+        if (coord[i]<0)
+          coord[i] += size;
+        if (coord[i]>=size)
+          coord[i] -= size;
 
-    //! consecutive, codim-wise, level-wise index
-    int compressedLeafIndex () const
-    {
-      DUNE_THROW(GridError, "YaspEntity not implemented");
-    }
+        // position in the doubled grid
+        coord[i] = 2*coord[i] + (gridcomponent().shift[i] ? 1 : 0);
+      }
 
-    //! subentity compressed index (not available here)
-    int subCompressedIndex (int, unsigned int ) const
-    {
-      DUNE_THROW(NotImplemented,"subIndex for entities with codimension > 0 is not implemented");
-      return -1;
+      // encode codim
+      PersistentIndexType id(codim);
+
+      // encode level
+      id = id << yaspgrid_level_bits;
+      id = id+PersistentIndexType(_g->level());
+
+      // encode coordinates
+      for (int i=dim-1; i>=0; i--)
+      {
+        id = id << yaspgrid_dim_bits;
+        id = id+PersistentIndexType(coord[i]);
+      }
+
+      return id;
     }
 
-    //! subentity compressed leaf index (not available here)
-    int subCompressedLeafIndex (int, unsigned int ) const
+    //! consecutive, codim-wise, level-wise index
+    int compressedIndex () const
     {
-      DUNE_THROW(NotImplemented,"subIndex for entities with codimension > 0 is not implemented");
-      return -1;
+      return gridcomponent().offset + _it.superindex();
     }
+
+    const GridImp * _yg;          // access to YaspGrid
+    const TSI& _it;               // position in the grid level
+    const YGLI& _g;               // access to grid level
+    const int& _component;        // orientation of the entity
   };
 
 
@@ -208,8 +284,8 @@ namespace Dune {
     template<int cc>
     typename Codim<cc>::EntityPointer subEntity (int i) const
     {
-      dune_static_assert( cc == dim || cc == 0 ,
-                          "YaspGrid only supports Entities with codim=dim and codim=0");
+      dune_static_assert( cc == dim || cc == 0 || cc == 1 || cc == dim-1,
+                          "YaspGrid only supports Entities with codim=0, 1, dim-1 and dim");
       // coordinates of the cell == coordinates of lower left corner
       if (cc==dim)
       {
@@ -225,7 +301,38 @@ namespace Dune {
       {
         return YaspEntityPointer<cc,GridImp>(_yg,_g,_it);
       }
-      DUNE_THROW(GridError, "codim " << cc << " (dim=" << dim << ") not (yet) implemented");
+
+      // faces and edges, numbered as in subCompressedIndex
+      iTupel coord = _it.coord();
+      int component;
+      if (cc==1) // faces, i.e. for dim=2 codim=1 is treated as a face
+      {
+        // the face grids are ordered by the direction ivar that varies
+        component = i/2;
+        if (i%2) coord[component] += 1;
+      }
+      else // edges
+      {
+        // map to old numbering
+        static unsigned int edge[ 12 ] = { 0, 1, 2, 3, 4, 5, 8, 9, 6, 7, 10, 11 };
+        i = edge[i];
+
+        // number of entities per direction
+        int m=1<<(dim-1);
+
+        // the edge grids are ordered by decreasing fixed direction ifix
+        component = i/m;
+        int ifix=(dim-1)-component;
+
+        int bit=1;
+        for (int k=0; k<dim; k++)
+        {
+          if (k==ifix) continue;
+          if ((i%m)&bit) coord[k] += 1;
+          bit *= 2;
+        }
+      }
+      return YaspEntityPointer<cc,GridImp>(_yg,_g,_g->components[cc][component].overlapfront.tsubbegin(coord),component);
     }
 
     //! Inter-level access to father element on coarser grid. Assumes that meshes are nested.
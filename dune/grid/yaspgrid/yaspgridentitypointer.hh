@@ -27,47 +27,38 @@ namespace Dune {
   protected:
     typedef YaspEntity<codim, dim, GridImp> YaspEntityImp;
 
+    //! faces and edges additionally know the orientation they belong to
+    typedef integral_constant<bool,(codim>0 && codim<dim)> HasComponent;
+
   public:
     //! codimension of entity pointer
     enum { codimension = codim };
 
     //! constructor
-    YaspEntityPointer (const GridImp * yg, const YGLI & g, const TSI & it)
-      : _g(g), _it(it),
-        _entity(MakeableInterfaceObject<Entity>(YaspEntity<codim,dim,GridImp>(yg, _g,_it)))
-    {
-      if (codim>0 && codim<dim)
-      {
-        DUNE_THROW(GridError, "YaspEntityPointer: codim not implemented");
-      }
-    }
+    YaspEntityPointer (const GridImp * yg, const YGLI & g, const TSI & it, int component = 0)
+      : _g(g), _it(it), _component(component),
+        _entity(MakeableInterfaceObject<Entity>(makeEntity(yg,_g,_it,_component,HasComponent())))
+    {}
 
     //! copy constructor
     YaspEntityPointer (const YaspEntityImp& entity)
       : _g(entity.gridlevel()),
         _it(entity.transformingsubiterator()),
-        _entity(MakeableInterfaceObject<Entity>(YaspEntity<codim,dim,GridImp>(entity.yaspgrid(), _g,_it)))
-    {
-      if (codim>0 && codim<dim)
-      {
-        DUNE_THROW(GridError, "YaspEntityPointer: codim not implemented");
-      }
-    }
+        _component(componentOf(entity,HasComponent())),
+        _entity(MakeableInterfaceObject<Entity>(makeEntity(entity.yaspgrid(),_g,_it,_component,HasComponent())))
+    {}
 
     //! copy constructor
     YaspEntityPointer (const YaspEntityPointer& rhs)
-      : _g(rhs._g), _it(rhs._it), _entity(MakeableInterfaceObject<Entity>(YaspEntity<codim,dim,GridImp>(GridImp::getRealImplementation(rhs._entity).yaspgrid(),_g,_it)))
-    {
-      if (codim>0 && codim<dim)
-      {
-        DUNE_THROW(GridError, "YaspEntityPointer: codim not implemented");
-      }
-    }
+      : _g(rhs._g), _it(rhs._it), _component(rhs._component),
+        _entity(MakeableInterfaceObject<Entity>(makeEntity(GridImp::getRealImplementation(rhs._entity).yaspgrid(),
+                                                           _g,_it,_component,HasComponent())))
+    {}
 
     //! equality
     bool equals (const YaspEntityPointer& rhs) const
     {
-      return (_it==rhs._it && _g == rhs._g);
+      return (_it==rhs._it && _g == rhs._g && _component == rhs._component);
     }
 
     //! dereferencing
@@ -84,6 +75,7 @@ namespace Dune {
     {
       _g = rhs._g;
       _it = rhs._it;
+      _component = rhs._component;
       /* _entity = i._entity
        * is done implicitely, as the entity is completely
        * defined via the iterator it belongs to
@@ -111,9 +103,37 @@ namespace Dune {
       return _g;
     }
 
+    //! number of the orientation of a face or edge (always 0 for elements and vertices)
+    int component () const
+    {
+      return _component;
+    }
+
+  private:
+    static YaspEntityImp makeEntity (const GridImp * yg, const YGLI & g, const TSI & it, const int & component, false_type)
+    {
+      return YaspEntityImp(yg,g,it);
+    }
+
+    static YaspEntityImp makeEntity (const GridImp * yg, const YGLI & g, const TSI & it, const int & component, true_type)
+    {
+      return YaspEntityImp(yg,g,it,component);
+    }
+
+    static int componentOf (const YaspEntityImp& entity, false_type)
+    {
+      return 0;
+    }
+
+    static int componentOf (const YaspEntityImp& entity, true_type)
+    {
+      return entity.component();
+    }
+
   protected:
     YGLI _g;             // access to grid level
     TSI _it;             // position in the grid level
+    int _component;      // orientation of faces and edges
     mutable MakeableInterfaceObject<Entity> _entity; //!< virtual entity
   };
 
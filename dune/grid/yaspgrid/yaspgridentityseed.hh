@@ -23,17 +23,17 @@ namespace Dune {
 
     //! default construct an invalid entity seed
     YaspEntitySeed ()
-      : _l(-1), _c(0)
+      : _l(-1), _c(0), _o(0)
     {}
 
     //! constructor
-    YaspEntitySeed (int level, FieldVector<int, dim> coord)
-      : _l(level), _c(coord)
+    YaspEntitySeed (int level, FieldVector<int, dim> coord, int component = 0)
+      : _l(level), _c(coord), _o(component)
     {}
 
     //! copy constructor
     YaspEntitySeed (const YaspEntitySeed& rhs)
-      : _l(rhs._l), _c(rhs._c)
+      : _l(rhs._l), _c(rhs._c), _o(rhs._o)
     {}
 
     //! check whether the EntitySeed refers to a valid Entity
@@ -44,10 +44,12 @@ namespace Dune {
 
     int level () const { return _l; }
     const FieldVector<int, dim> & coord() const { return _c; }
+    int component () const { return _o; }
 
   protected:
     int _l;                   // grid level
     FieldVector<int, dim> _c; // coord in the global grid
+    int _o;                   // orientation of faces and edges
   };
 
 }  // namespace Dune
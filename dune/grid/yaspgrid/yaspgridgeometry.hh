@@ -9,13 +9,12 @@
    YaspGeometry realizes the concept of the geometric part of a mesh entity.
 
    We have specializations for dim == dimworld (elements) and dim == 0
-   (vertices).  The general version implements dim == dimworld-1 (faces)
-   and otherwise throws a GridError.
+   (vertices).  The general version implements faces and edges.
  */
 
 namespace Dune {
 
-  //! The general version can do any dimension, but constructors currently exist only for dim==dimworld-1
+  //! The general version can do any dimension
   template<int mydim,int cdim, class GridImp>
   class YaspGeometry : public AxisAlignedCubeGeometry<typename GridImp::ctype,mydim,cdim>
   {
@@ -49,6 +48,26 @@ namespace Dune {
       static_cast< AxisAlignedCubeGeometry<ctype,mydim,cdim> & >( *this ) = AxisAlignedCubeGeometry<ctype,mydim,cdim>(lower, upper, axes);
     }
 
+    //! constructor from midpoint and extension and the directions in which the entity is extended
+    YaspGeometry (const FieldVector<ctype, cdim>& p, const FieldVector<ctype, cdim>& h, const std::bitset<cdim>& axes)
+      : AxisAlignedCubeGeometry<ctype,mydim,cdim>(FieldVector<ctype,cdim>(0),FieldVector<ctype,cdim>(0)) // anything
+    {
+      if (int(axes.count())!=mydim)
+        DUNE_THROW(GridError, "This YaspGeometry constructor needs mydim extended directions");
+
+      FieldVector<ctype, cdim> lower = p;
+      FieldVector<ctype, cdim> upper = p;
+      for (int i=0; i<cdim; i++)
+        if (axes[i])
+        {
+          lower[i] -= 0.5*h[i];
+          upper[i] += 0.5*h[i];
+        }
+
+      // set up base class
+      static_cast< AxisAlignedCubeGeometry<ctype,mydim,cdim> & >( *this ) = AxisAlignedCubeGeometry<ctype,mydim,cdim>(lower, upper, axes);
+    }
+
     //! copy constructor
     YaspGeometry (const YaspGeometry& other)
       : AxisAlignedCubeGeometry<ctype,mydim,cdim>(other)
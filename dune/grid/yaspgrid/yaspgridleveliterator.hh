@@ -27,8 +27,12 @@ namespace Dune {
     typedef typename SubYGrid<dim,ctype>::TransformingSubIterator TSI;
 
     //! constructor
-    YaspLevelIterator (const GridImp * yg, const YGLI & g, const TSI & it) :
-      YaspEntityPointer<codim,GridImp>(yg,g,it) {}
+    YaspLevelIterator (const GridImp * yg, const YGLI & g, const TSI & it, int component = 0) :
+      YaspEntityPointer<codim,GridImp>(yg,g,it,component)
+    {
+      if (codim>0 && codim<dim)
+        nextcomponent();
+    }
 
     //! copy constructor
     YaspLevelIterator (const YaspLevelIterator& i) :
@@ -38,6 +42,32 @@ namespace Dune {
     void increment()
     {
       ++(this->_it);
+      if (codim>0 && codim<dim)
+        nextcomponent();
+    }
+
+  private:
+    /** \brief Move on to the next orientation when the current one is exhausted
+     *
+     * Faces and edges are stored in one grid per orientation,
+     * the iterator runs through these grids one after the other.
+     */
+    void nextcomponent ()
+    {
+      const std::vector<typename GridImp::YGridComponent>& components = this->_g->components[codim];
+      while (this->_component+1 < int(components.size()))
+      {
+        const SubYGrid<dim,ctype>& grid = components[this->_component].grid(pitype);
+        if (!grid.empty() && this->_it != grid.tsubend())
+          return;
+        ++(this->_component);
+        this->_it = components[this->_component].grid(pitype).tsubbegin();
+      }
+
+      // an empty last grid: make sure we are equal to the end iterator
+      const SubYGrid<dim,ctype>& grid = components[this->_component].grid(pitype);
+      if (grid.empty())
+        this->_it = grid.tsubend();
     }
   };
 